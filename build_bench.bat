@@ -0,0 +1,40 @@
+@echo off
+REM Benchmark build (host). Requires gcc in PATH (MinGW/WSL).
+REM Usage: build_bench.bat         -> FP32 (assets/weights.bin)
+REM        build_bench.bat w8      -> W8A32 (assets/weights_w8.bin)
+REM        build_bench.bat w8 simd -> W8A32 + AVX2/FMA
+REM Run:   bench.exe [--warmup=N] [--iters=N] [--baseline=data\output\bench_base.json] [--threshold=PCT]
+setlocal
+
+REM Try MSYS2 gcc if not in PATH
+if exist "C:\msys64\ucrt64\bin\gcc.exe" (
+  set "PATH=C:\msys64\ucrt64\bin;%PATH%"
+) else if exist "C:\msys64\mingw64\bin\gcc.exe" (
+  set "PATH=C:\msys64\mingw64\bin;%PATH%"
+)
+
+set CSRC=csrc
+set INC=-I. -I%CSRC%
+REM YOLO_VERBOSE=0: 세션 레이어 로그 끔 (측정 구간에 printf 없음)
+set CFLAGS=-std=c99 -O2 -lm -pthread -DYOLO_VERBOSE=0
+
+if /i "%1"=="w8" (
+  set "CFLAGS=%CFLAGS% -DUSE_WEIGHTS_W8"
+  echo Building bench.exe [W8A32] ...
+) else (
+  echo Building bench.exe [FP32] ...
+)
+if /i "%2"=="simd" (
+  set "CFLAGS=%CFLAGS% -mavx2 -mfma"
+  echo   + AVX2/FMA
+)
+
+gcc -o bench.exe %CSRC%\bench.c %CSRC%\yolo_session.c ^
+  %CSRC%\blocks\conv.c %CSRC%\blocks\c3.c %CSRC%\blocks\decode.c %CSRC%\blocks\detect.c %CSRC%\blocks\nms.c %CSRC%\blocks\sppf.c ^
+  %CSRC%\operations\bottleneck.c %CSRC%\operations\concat.c %CSRC%\operations\conv2d.c %CSRC%\operations\conv2d_tune.c %CSRC%\operations\conv2d_stem.c %CSRC%\operations\conv2d_1x1.c %CSRC%\operations\conv2d_gemm.c %CSRC%\operations\conv2d_winograd.c %CSRC%\operations\weight_pack.c %CSRC%\operations\maxpool2d.c %CSRC%\operations\silu.c %CSRC%\operations\upsample.c ^
+  %CSRC%\utils\feature_pool.c %CSRC%\utils\memory_plan.c %CSRC%\utils\thread_pool.c %CSRC%\utils\image_loader.c %CSRC%\utils\weights_loader.c %CSRC%\utils\timing.c %CSRC%\utils\profiler.c %CSRC%\utils\roofline.c %CSRC%\utils\uart_dump.c ^
+  %INC% %CFLAGS%
+if errorlevel 1 exit /b 1
+
+echo Build OK. Run: bench.exe  (result: data\output\bench.json)
+exit /b 0
@@ -0,0 +1,12 @@
+#!/bin/bash
+# 벤치마크 빌드 (호스트): ./build_bench.sh [w8] [simd]  →  ./bench [--warmup=N] [--iters=N] [--baseline=JSON]
+# 기준 저장 후 비교: ./bench --out=data/output/bench_base.json ; (변경 후) ./bench --baseline=data/output/bench_base.json
+
+set -e
+cd "$(dirname "$0")"
+CFLAGS="-std=c99 -O2 -pthread -DYOLO_VERBOSE=0"
+[ "$1" = "w8" ] && CFLAGS="$CFLAGS -DUSE_WEIGHTS_W8"
+[ "$2" = "simd" ] && CFLAGS="$CFLAGS -mavx2 -mfma"
+mkdir -p data/output
+gcc -o bench csrc/bench.c csrc/yolo_session.c csrc/blocks/*.c csrc/operations/*.c csrc/utils/*.c -I. -Icsrc $CFLAGS -lm
+echo "Build OK ($CFLAGS). Run: ./bench"
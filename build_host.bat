@@ -2,6 +2,7 @@
 REM Host build (no BARE_METAL). Requires gcc in PATH (MinGW/WSL).
 REM Usage: build_host.bat        -> FP32 (assets/weights.bin)
 REM        build_host.bat w8     -> W8A32 (assets/weights_w8.bin)
+REM        build_host.bat w8 simd -> W8A32 + AVX2/FMA (1x1 conv SIMD 커널)
 setlocal
 
 REM Try MSYS2 gcc if not in PATH
@@ -13,7 +14,7 @@ if exist "C:\msys64\ucrt64\bin\gcc.exe" (
 
 set CSRC=csrc
 set INC=-I. -I%CSRC%
-set CFLAGS=-std=c99 -O2 -lm
+set CFLAGS=-std=c99 -O2 -lm -pthread
 
 if /i "%1"=="w8" (
   set "CFLAGS=%CFLAGS% -DUSE_WEIGHTS_W8"
@@ -21,11 +22,15 @@ if /i "%1"=="w8" (
 ) else (
   echo Building main.exe [FP32] ...
 )
+if /i "%2"=="simd" (
+  set "CFLAGS=%CFLAGS% -mavx2 -mfma"
+  echo   + AVX2/FMA
+)
 
-gcc -o main.exe %CSRC%\main.c ^
+gcc -o main.exe %CSRC%\main.c %CSRC%\yolo_session.c ^
   %CSRC%\blocks\conv.c %CSRC%\blocks\c3.c %CSRC%\blocks\decode.c %CSRC%\blocks\detect.c %CSRC%\blocks\nms.c %CSRC%\blocks\sppf.c ^
-  %CSRC%\operations\bottleneck.c %CSRC%\operations\concat.c %CSRC%\operations\conv2d.c %CSRC%\operations\maxpool2d.c %CSRC%\operations\silu.c %CSRC%\operations\upsample.c ^
-  %CSRC%\utils\feature_pool.c %CSRC%\utils\image_loader.c %CSRC%\utils\weights_loader.c %CSRC%\utils\timing.c %CSRC%\utils\uart_dump.c ^
+  %CSRC%\operations\bottleneck.c %CSRC%\operations\concat.c %CSRC%\operations\conv2d.c %CSRC%\operations\conv2d_tune.c %CSRC%\operations\conv2d_stem.c %CSRC%\operations\conv2d_1x1.c %CSRC%\operations\conv2d_gemm.c %CSRC%\operations\conv2d_winograd.c %CSRC%\operations\weight_pack.c %CSRC%\operations\maxpool2d.c %CSRC%\operations\silu.c %CSRC%\operations\upsample.c ^
+  %CSRC%\utils\feature_pool.c %CSRC%\utils\memory_plan.c %CSRC%\utils\thread_pool.c %CSRC%\utils\image_loader.c %CSRC%\utils\weights_loader.c %CSRC%\utils\timing.c %CSRC%\utils\profiler.c %CSRC%\utils\roofline.c %CSRC%\utils\uart_dump.c ^
   %INC% %CFLAGS%
 if errorlevel 1 exit /b 1
 
@@ -16,11 +16,11 @@ if not exist "%GCC%" (
 )
 
 echo [1/3] Building main.exe ...
-set "CFLAGS=-I. -Icsrc -std=c99 -O2 -lm"
+set "CFLAGS=-I. -Icsrc -std=c99 -O2 -lm -pthread"
 if /i "%1"=="w8" (
   set "CFLAGS=%CFLAGS% -DUSE_WEIGHTS_W8"
 )
-"%GCC%" -o main.exe csrc/main.c csrc/blocks/conv.c csrc/blocks/c3.c csrc/blocks/decode.c csrc/blocks/detect.c csrc/blocks/nms.c csrc/blocks/sppf.c csrc/operations/bottleneck.c csrc/operations/concat.c csrc/operations/conv2d.c csrc/operations/maxpool2d.c csrc/operations/silu.c csrc/operations/upsample.c csrc/utils/feature_pool.c csrc/utils/image_loader.c csrc/utils/weights_loader.c csrc/utils/uart_dump.c %CFLAGS%
+"%GCC%" -o main.exe csrc/main.c csrc/yolo_session.c csrc/blocks/conv.c csrc/blocks/c3.c csrc/blocks/decode.c csrc/blocks/detect.c csrc/blocks/nms.c csrc/blocks/sppf.c csrc/operations/bottleneck.c csrc/operations/concat.c csrc/operations/conv2d.c csrc/operations/conv2d_tune.c csrc/operations/conv2d_stem.c csrc/operations/conv2d_1x1.c csrc/operations/conv2d_gemm.c csrc/operations/conv2d_winograd.c csrc/operations/weight_pack.c csrc/operations/maxpool2d.c csrc/operations/silu.c csrc/operations/upsample.c csrc/utils/feature_pool.c csrc/utils/memory_plan.c csrc/utils/thread_pool.c csrc/utils/image_loader.c csrc/utils/weights_loader.c csrc/utils/timing.c csrc/utils/profiler.c csrc/utils/roofline.c csrc/utils/uart_dump.c %CFLAGS%
 if errorlevel 1 (
     echo [ERROR] Build failed. Fix errors above, then run again.
     exit /b 1
@@ -0,0 +1,821 @@
+/**
+ * 벤치마크 (호스트 전용): 전체 네트워크 + 블록(conv, C3, SPPF, Detect, decode, NMS)을 warmup 후 N회 반복해
+ * 단조 시계(host_time_ns)로 min/median/p90/p99/max/mean/stddev(µs)를 내고 JSON으로 저장.
+ * --baseline=이전 JSON이면 블록마다 median 비율로 회귀 판정 (임계값 초과 느려짐 → 종료 코드 2).
+ *
+ * 블록 입력은 고정 시드 난수 활성값 + 실제 가중치 (세션과 같은 weight_pack), 모양은 네트워크 레이어 그대로:
+ * conv = L1 (3x3 s2, 16 → 32, 320 → 160), c3 = L2 (32 → 32, 160², bottleneck 1), sppf = L9 (256, 20², k5),
+ * detect = dense head 3스케일, decode = 그 head 출력, nms = 300개·5클래스 밀집 장면 (정렬 + nms_sorted).
+ *
+ * --suite=shapes: 모델의 고유 conv shape 29개(등장 60회)마다 conv2d_nchw_f32(FP32 가중치)·conv2d_nchw_f32_w8(INT8)을
+ * 합성 데이터로 측정 → shape별 GFLOP/s와 등장 횟수 가중 합계 (현재 --conv 알고리즘, 가중치는 weight_pack 적용).
+ *
+ * --tune[=PATH]: shape마다 direct 커널 블로킹(tile_h × tile_w × oc_block) 후보를 재서 최적값을 plan 파일로 저장
+ * (main/bench --tune-file=PATH로 적용, --conv=direct 경로 전용). 기본 PATH data/output/conv2d_tune.txt.
+ *
+ * 빌드: ./build_bench.sh (또는 build_bench.bat). 출력 없는 세션 로그를 위해 -DYOLO_VERBOSE=0.
+ */
+#if !defined(_WIN32) && !defined(_POSIX_C_SOURCE) && !defined(_DEFAULT_SOURCE)
+#define _POSIX_C_SOURCE 199309L  /* mcycle.h: clock_gettime(CLOCK_MONOTONIC) */
+#endif
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#include "yolo_session.h"
+#include "blocks/conv.h"
+#include "blocks/c3.h"
+#include "blocks/sppf.h"
+#include "blocks/detect.h"
+#include "blocks/decode.h"
+#include "blocks/nms.h"
+#include "operations/conv2d.h"
+#include "operations/conv2d_1x1.h"
+#include "operations/conv2d_tune.h"
+#include "operations/silu.h"
+#include "operations/weight_pack.h"
+#include "utils/weights_loader.h"
+#include "utils/thread_pool.h"
+#include "utils/mcycle.h"
+
+#ifdef BARE_METAL
+#error "bench.c is host-only (BARE_METAL uses the per-layer mcycle log)"
+#endif
+
+#define BENCH_MAX        72
+#define BENCH_MAX_ITERS  100000
+#define BENCH_CONF_THR   0.20f   /* 세션 CONF_THRESHOLD와 같음 */
+#define BENCH_IOU_THR    0.45f
+#define BENCH_NMS_N      300
+
+typedef struct {
+    const char* name;
+    int32_t n;
+    double min, median, p90, p99, max, mean, stddev;   /* µs */
+    double base_median;                                /* 기준 JSON (없으면 0) */
+    const char* verdict;                               /* "ok" / "regression" / "improved" / "new" */
+    uint64_t flops;                                    /* conv shape: 1회 FLOP (2·MAC), 그 외 0 */
+    int32_t count;                                     /* conv shape: 모델 내 등장 횟수 */
+} bench_result_t;
+
+typedef enum {
+    BENCH_SUITE_BLOCKS = 1,   /* 네트워크 + 블록 */
+    BENCH_SUITE_SHAPES = 2,   /* conv shape별 conv2d 커널 */
+    BENCH_SUITE_ALL = 3
+} bench_suite_t;
+
+typedef struct {
+    int32_t warmup, iters;
+    const char* only;
+    unsigned suite;
+} bench_cfg_t;
+
+static bench_result_t s_results[BENCH_MAX];
+static int32_t s_num_results;
+static double s_samples[BENCH_MAX_ITERS];
+
+static int cmp_double(const void* a, const void* b) {
+    const double x = *(const double*)a, y = *(const double*)b;
+    return x < y ? -1 : x > y;
+}
+
+/* nearest-rank 백분위: 정렬된 v[n]에서 ceil(p·n)번째 */
+static double percentile(const double* v, int32_t n, double p) {
+    int32_t k = (int32_t)ceil(p * (double)n) - 1;
+    if (k < 0) k = 0;
+    if (k >= n) k = n - 1;
+    return v[k];
+}
+
+static int selected(const bench_cfg_t* cfg, const char* name) {
+    if (!cfg->only) return 1;
+    const size_t len = strlen(name);
+    for (const char* p = cfg->only; *p; ) {
+        const char* e = strchr(p, ',');
+        const size_t l = e ? (size_t)(e - p) : strlen(p);
+        if (l == len && strncmp(p, name, len) == 0) return 1;
+        if (!e) break;
+        p = e + 1;
+    }
+    return 0;
+}
+
+/* prep(선택)은 매 반복 측정 구간 밖에서 (NMS 입력 복원 등) */
+typedef void (*bench_fn)(void* ctx);
+
+static bench_result_t* run_bench(const bench_cfg_t* cfg, const char* name, bench_fn prep, bench_fn fn, void* ctx) {
+    if (!selected(cfg, name) || s_num_results >= BENCH_MAX) return NULL;
+    for (int32_t i = 0; i < cfg->warmup; i++) {
+        if (prep) prep(ctx);
+        fn(ctx);
+    }
+    const int32_t n = cfg->iters;
+    double sum = 0.0;
+    for (int32_t i = 0; i < n; i++) {
+        if (prep) prep(ctx);
+        const uint64_t t0 = host_time_ns();
+        fn(ctx);
+        s_samples[i] = (double)(host_time_ns() - t0) / 1000.0;
+        sum += s_samples[i];
+    }
+    qsort(s_samples, (size_t)n, sizeof(double), cmp_double);
+    bench_result_t* r = &s_results[s_num_results++];
+    memset(r, 0, sizeof(*r));
+    r->name = name;
+    r->n = n;
+    r->min = s_samples[0];
+    r->max = s_samples[n - 1];
+    r->median = (n & 1) ? s_samples[n / 2] : 0.5 * (s_samples[n / 2 - 1] + s_samples[n / 2]);
+    r->p90 = percentile(s_samples, n, 0.90);
+    r->p99 = percentile(s_samples, n, 0.99);
+    r->mean = sum / (double)n;
+    double var = 0.0;
+    for (int32_t i = 0; i < n; i++) var += (s_samples[i] - r->mean) * (s_samples[i] - r->mean);
+    r->stddev = n > 1 ? sqrt(var / (double)(n - 1)) : 0.0;
+    r->verdict = "new";
+    printf("  %-20s n=%-5d min %10.1f  median %10.1f  p90 %10.1f  p99 %10.1f  max %10.1f  sd %8.1f us\n",
+           name, (int)n, r->min, r->median, r->p90, r->p99, r->max, r->stddev);
+    return r;
+}
+
+/* ===== 입력 ===== */
+
+static uint32_t s_rng = 12345u;
+static float frand(void) {
+    s_rng = s_rng * 1664525u + 1013904223u;
+    return (float)((s_rng >> 8) & 0xFFFF) / 32768.0f - 1.0f;
+}
+
+static float* rand_buf(size_t n, float amp) {
+    float* p = (float*)malloc(n * sizeof(float));
+    if (p) for (size_t i = 0; i < n; i++) p[i] = frand() * amp;
+    return p;
+}
+
+typedef struct {
+    const void* w; float scale; int is_int8; const float* b;
+} bench_conv_t;
+
+static int get_conv(weights_loader_t* wl, const char* prefix, bench_conv_t* c) {
+    char name[96];
+    (void)snprintf(name, sizeof(name), "%s.weight", prefix);
+    c->w = weights_get_tensor_for_conv(wl, name, &c->scale, &c->is_int8);
+    (void)snprintf(name, sizeof(name), "%s.bias", prefix);
+    c->b = weights_get_tensor_data(wl, name);
+    return c->w && c->b ? 0 : -1;
+}
+
+/* ===== 전체 네트워크 ===== */
+
+typedef struct {
+    yolo_session_t* s;
+    preprocessed_image_t img;
+    detection_t dets[YOLO_MAX_DETECTIONS];
+} net_ctx_t;
+
+static void net_run(void* p) {
+    net_ctx_t* c = (net_ctx_t*)p;
+    (void)yolo_session_infer(c->s, &c->img, c->dets, YOLO_MAX_DETECTIONS);
+}
+
+/* ===== 블록 ===== */
+
+typedef struct {
+    bench_conv_t l1, c3[5], l9[2], det[3];
+    float *x_l1, *y_l1;
+    float *x_c3, *y_c3, *s_c3;
+    float *x_l9, *y_l9, *s_l9;
+    float *x3, *x4, *x5, *p3, *p4, *p5;
+    detection_t* dets;
+    detection_t* nms_in;
+    detection_t* nms_out;
+    void* nms_scratch;
+    int32_t n_dec;
+} blk_ctx_t;
+
+static void conv_run(void* p) {
+    blk_ctx_t* c = (blk_ctx_t*)p;
+    conv_block_nchw_f32(c->x_l1, 1, 16, 320, 320, c->l1.w, c->l1.scale, c->l1.is_int8, 32, 3, 3, 2, 2, 1, 1,
+                        c->l1.b, c->y_l1, 160, 160);
+}
+
+static void c3_run(void* p) {
+    blk_ctx_t* c = (blk_ctx_t*)p;
+    const bench_conv_t* k = c->c3;
+    const void* bn1_w[1] = { k[3].w };
+    const float bn1_s[1] = { k[3].scale };
+    const int bn1_i[1] = { k[3].is_int8 };
+    const float* const bn1_b[1] = { k[3].b };
+    const void* bn2_w[1] = { k[4].w };
+    const float bn2_s[1] = { k[4].scale };
+    const int bn2_i[1] = { k[4].is_int8 };
+    const float* const bn2_b[1] = { k[4].b };
+    c3_nchw_f32(c->x_c3, 1, 32, 160, 160, NULL,
+                k[0].w, k[0].scale, k[0].is_int8, 16, k[0].b,
+                k[1].w, k[1].scale, k[1].is_int8, 16, k[1].b,
+                k[2].w, k[2].scale, k[2].is_int8, 32, k[2].b,
+                1, bn1_w, bn1_s, bn1_i, bn1_b, bn2_w, bn2_s, bn2_i, bn2_b, 1, c->y_c3, 0, c->s_c3);
+}
+
+static void sppf_run(void* p) {
+    blk_ctx_t* c = (blk_ctx_t*)p;
+    sppf_nchw_f32(c->x_l9, 1, 256, 20, 20,
+                  c->l9[0].w, c->l9[0].scale, c->l9[0].is_int8, 128, c->l9[0].b,
+                  c->l9[1].w, c->l9[1].scale, c->l9[1].is_int8, 256, c->l9[1].b,
+                  5, c->y_l9, c->s_l9);
+}
+
+static void detect_run(void* p) {
+    blk_ctx_t* c = (blk_ctx_t*)p;
+    detect_nchw_f32(1, c->x3, 64, 80, 80, c->x4, 128, 40, 40, c->x5, 256, 20, 20,
+                    c->det[0].w, c->det[0].scale, c->det[0].is_int8, c->det[0].b,
+                    c->det[1].w, c->det[1].scale, c->det[1].is_int8, c->det[1].b,
+                    c->det[2].w, c->det[2].scale, c->det[2].is_int8, c->det[2].b,
+                    c->p3, c->p4, c->p5);
+}
+
+static const float BENCH_STRIDES[3] = { 8.0f, 16.0f, 32.0f };
+static const float BENCH_ANCHORS[3][6] = {
+    { 10.0f, 13.0f, 16.0f, 30.0f, 33.0f, 23.0f },
+    { 30.0f, 61.0f, 62.0f, 45.0f, 59.0f, 119.0f },
+    { 116.0f, 90.0f, 156.0f, 198.0f, 373.0f, 326.0f }
+};
+
+static void decode_run(void* p) {
+    blk_ctx_t* c = (blk_ctx_t*)p;
+    c->n_dec = decode_nchw_f32(c->p3, 80, 80, c->p4, 40, 40, c->p5, 20, 20, YOLO_NUM_CLASSES, BENCH_CONF_THR,
+                               YOLO_INPUT_SIZE, BENCH_STRIDES, BENCH_ANCHORS, c->dets, YOLO_MAX_DETECTIONS);
+}
+
+static void nms_prep(void* p) {
+    blk_ctx_t* c = (blk_ctx_t*)p;
+    memcpy(c->dets, c->nms_in, BENCH_NMS_N * sizeof(detection_t));
+}
+
+static void nms_run(void* p) {
+    blk_ctx_t* c = (blk_ctx_t*)p;
+    nms_sort_by_conf(c->dets, BENCH_NMS_N, c->nms_scratch);
+    (void)nms_sorted(c->dets, BENCH_NMS_N, BENCH_IOU_THR, c->nms_out, YOLO_MAX_DETECTIONS,
+                     c->nms_scratch, nms_scratch_bytes(BENCH_NMS_N));
+}
+
+static void blk_free(blk_ctx_t* c) {
+    free(c->x_l1); free(c->y_l1); free(c->x_c3); free(c->y_c3); free(c->s_c3);
+    free(c->x_l9); free(c->y_l9); free(c->s_l9);
+    free(c->x3); free(c->x4); free(c->x5); free(c->p3); free(c->p4); free(c->p5);
+    free(c->dets); free(c->nms_in); free(c->nms_out); free(c->nms_scratch);
+}
+
+static int run_blocks(const bench_cfg_t* cfg, const char* weights_path, int32_t n_threads) {
+    weights_loader_t wl;
+    memset(&wl, 0, sizeof(wl));
+#ifdef USE_WEIGHTS_W8
+    if (weights_load_from_file_w8(weights_path, &wl) != 0) return -1;
+#else
+    if (weights_load_from_file(weights_path, &wl) != 0) return -1;
+#endif
+    static const char* const c3_names[5] = {
+        "model.2.cv1.conv", "model.2.cv2.conv", "model.2.cv3.conv", "model.2.m.0.cv1.conv", "model.2.m.0.cv2.conv"
+    };
+    blk_ctx_t c;
+    memset(&c, 0, sizeof(c));
+    int err = get_conv(&wl, "model.1.conv", &c.l1);
+    for (int i = 0; i < 5; i++) err |= get_conv(&wl, c3_names[i], &c.c3[i]);
+    err |= get_conv(&wl, "model.9.cv1.conv", &c.l9[0]);
+    err |= get_conv(&wl, "model.9.cv2.conv", &c.l9[1]);
+    err |= get_conv(&wl, "model.24.m.0", &c.det[0]);
+    err |= get_conv(&wl, "model.24.m.1", &c.det[1]);
+    err |= get_conv(&wl, "model.24.m.2", &c.det[2]);
+    if (err) {
+        weights_free(&wl);
+        return -1;
+    }
+    thread_pool_init(n_threads);
+    if (weight_pack_prepare(&wl, conv2d_weight_pack_flags()) != 0)
+        fprintf(stderr, "WARN: weight_pack failed, blocks use unpacked weights\n");
+
+    c.x_l1 = rand_buf((size_t)16 * 320 * 320, 2.0f);
+    c.y_l1 = rand_buf((size_t)32 * 160 * 160, 0.0f);
+    c.x_c3 = rand_buf((size_t)32 * 160 * 160, 2.0f);
+    c.y_c3 = rand_buf((size_t)32 * 160 * 160, 0.0f);
+    c.s_c3 = (float*)malloc(c3_scratch_bytes(1, 16, 16, 160, 160));
+    c.x_l9 = rand_buf((size_t)256 * 20 * 20, 2.0f);
+    c.y_l9 = rand_buf((size_t)256 * 20 * 20, 0.0f);
+    c.s_l9 = (float*)malloc(sppf_scratch_bytes(1, 128, 20, 20));
+    c.x3 = rand_buf((size_t)64 * 80 * 80, 2.0f);
+    c.x4 = rand_buf((size_t)128 * 40 * 40, 2.0f);
+    c.x5 = rand_buf((size_t)256 * 20 * 20, 2.0f);
+    c.p3 = rand_buf((size_t)255 * 80 * 80, 0.0f);
+    c.p4 = rand_buf((size_t)255 * 40 * 40, 0.0f);
+    c.p5 = rand_buf((size_t)255 * 20 * 20, 0.0f);
+    c.dets = (detection_t*)malloc(YOLO_MAX_DETECTIONS * sizeof(detection_t));
+    c.nms_in = (detection_t*)malloc(BENCH_NMS_N * sizeof(detection_t));
+    c.nms_out = (detection_t*)malloc(YOLO_MAX_DETECTIONS * sizeof(detection_t));
+    c.nms_scratch = malloc(nms_scratch_bytes(BENCH_NMS_N));
+    if (!c.x_l1 || !c.y_l1 || !c.x_c3 || !c.y_c3 || !c.s_c3 || !c.x_l9 || !c.y_l9 || !c.s_l9 || !c.x3 || !c.x4 ||
+        !c.x5 || !c.p3 || !c.p4 || !c.p5 || !c.dets || !c.nms_in || !c.nms_out || !c.nms_scratch) {
+        blk_free(&c);
+        weight_pack_release();
+        weights_free(&wl);
+        return -1;
+    }
+    /* NMS: 30개 군집 × 10, 클래스 5개, 박스끼리 겹침이 많은 장면 */
+    for (int32_t i = 0; i < BENCH_NMS_N; i++) {
+        detection_t* d = &c.nms_in[i];
+        const int32_t g = i / 10;
+        d->x = 0.1f + 0.8f * (float)(g % 6) / 5.0f + 0.02f * frand();
+        d->y = 0.1f + 0.8f * (float)(g / 6) / 4.0f + 0.02f * frand();
+        d->w = 0.1f + 0.02f * frand();
+        d->h = 0.1f + 0.02f * frand();
+        d->conf = 0.6f + 0.39f * frand();
+        d->cls_id = (int32_t)(i % 5);
+    }
+
+    run_bench(cfg, "conv", NULL, conv_run, &c);
+    run_bench(cfg, "c3", NULL, c3_run, &c);
+    run_bench(cfg, "sppf", NULL, sppf_run, &c);
+    detect_run(&c);   /* decode 입력 (detect 벤치를 건너뛰어도) */
+    run_bench(cfg, "detect", NULL, detect_run, &c);
+    run_bench(cfg, "decode", NULL, decode_run, &c);
+    run_bench(cfg, "nms", nms_prep, nms_run, &c);
+
+    blk_free(&c);
+    weight_pack_release();
+    thread_pool_shutdown();
+    weights_free(&wl);
+    return 0;
+}
+
+/* ===== conv shape 스위트 ===== */
+
+/* YOLOv5n(640) conv의 고유 (c_in, c_out, k, stride, 입력 H=W)와 등장 횟수. 합 60개, 2·MAC 합 4.47 GFLOP
+ * (roofline 합계와 같음). pad = k/2 (stem 6x6만 2) */
+typedef struct {
+    int16_t c_in, c_out, k, s, h, count;
+} conv_shape_t;
+
+static const conv_shape_t CONV_SHAPES[] = {
+    {   3,  16, 6, 2, 640, 1 },  /* L0 stem */
+    {  16,  32, 3, 2, 320, 1 },  /* L1 */
+    {  32,  16, 1, 1, 160, 2 },  /* L2 cv1, cv2 */
+    {  16,  16, 1, 1, 160, 1 },  /* L2 m.cv1 */
+    {  16,  16, 3, 1, 160, 1 },  /* L2 m.cv2 */
+    {  32,  32, 1, 1, 160, 1 },  /* L2 cv3 */
+    {  32,  64, 3, 2, 160, 1 },  /* L3 */
+    {  64,  32, 1, 1,  80, 2 },  /* L4 cv1, cv2 */
+    {  32,  32, 1, 1,  80, 3 },  /* L4 m.cv1 ×2, L17 m.cv1 */
+    {  32,  32, 3, 1,  80, 3 },  /* L4 m.cv2 ×2, L17 m.cv2 */
+    {  64,  64, 1, 1,  80, 2 },  /* L4 cv3, L17 cv3 */
+    {  64, 128, 3, 2,  80, 1 },  /* L5 */
+    { 128,  64, 1, 1,  40, 5 },  /* L6 cv1, cv2, L14, L20 cv1, cv2 */
+    {  64,  64, 1, 1,  40, 5 },  /* L6 m.cv1 ×3, L13 m.cv1, L20 m.cv1 */
+    {  64,  64, 3, 1,  40, 5 },  /* L6 m.cv2 ×3, L13 m.cv2, L20 m.cv2 */
+    { 128, 128, 1, 1,  40, 3 },  /* L6 cv3, L13 cv3, L20 cv3 */
+    { 128, 256, 3, 2,  40, 1 },  /* L7 */
+    { 256, 128, 1, 1,  20, 6 },  /* L8 cv1, cv2, L9 cv1, L10, L23 cv1, cv2 */
+    { 128, 128, 1, 1,  20, 2 },  /* L8 m.cv1, L23 m.cv1 */
+    { 128, 128, 3, 1,  20, 2 },  /* L8 m.cv2, L23 m.cv2 */
+    { 256, 256, 1, 1,  20, 2 },  /* L8 cv3, L23 cv3 */
+    { 512, 256, 1, 1,  20, 1 },  /* L9 cv2 */
+    { 256,  64, 1, 1,  40, 2 },  /* L13 cv1, cv2 */
+    { 128,  32, 1, 1,  80, 2 },  /* L17 cv1, cv2 */
+    {  64,  64, 3, 2,  80, 1 },  /* L18 */
+    { 128, 128, 3, 2,  40, 1 },  /* L21 */
+    {  64, 255, 1, 1,  80, 1 },  /* Detect m.0 */
+    { 128, 255, 1, 1,  40, 1 },  /* Detect m.1 */
+    { 256, 255, 1, 1,  20, 1 },  /* Detect m.2 */
+};
+#define NUM_CONV_SHAPES ((int32_t)(sizeof(CONV_SHAPES) / sizeof(CONV_SHAPES[0])))
+
+static int32_t shape_pad(const conv_shape_t* sh) { return sh->k == 6 ? 2 : sh->k / 2; }
+static int32_t shape_out(const conv_shape_t* sh) { return (sh->h + 2 * shape_pad(sh) - sh->k) / sh->s + 1; }
+
+typedef struct {
+    const conv_shape_t* sh;
+    const float* x;
+    float* y;
+    const float* w_f32;
+    const int8_t* w_i8;
+    float scale;
+    const float* bias;
+} shape_ctx_t;
+
+static void shape_run_f32(void* p) {
+    const shape_ctx_t* c = (const shape_ctx_t*)p;
+    const conv_shape_t* sh = c->sh;
+    const int32_t pad = shape_pad(sh), ho = shape_out(sh);
+    conv2d_nchw_f32(c->x, 1, sh->c_in, sh->h, sh->h, c->w_f32, sh->c_out, sh->k, sh->k, c->bias,
+                    sh->s, sh->s, pad, pad, 1, c->y, ho, ho);
+}
+
+static void shape_run_w8(void* p) {
+    const shape_ctx_t* c = (const shape_ctx_t*)p;
+    const conv_shape_t* sh = c->sh;
+    const int32_t pad = shape_pad(sh), ho = shape_out(sh);
+    conv2d_nchw_f32_w8(c->x, 1, sh->c_in, sh->h, sh->h, c->w_i8, c->scale, sh->c_out, sh->k, sh->k, c->bias,
+                       sh->s, sh->s, pad, pad, 1, c->y, ho, ho);
+}
+
+/* 등장 횟수 가중 합계 (kernel 0: fp32, 1: w8). 모델 conv 전체를 이 kernel로 돌렸을 때의 추정치 */
+typedef struct {
+    uint64_t flops;
+    double us;
+    int32_t shapes;
+} shape_total_t;
+
+static shape_total_t s_shape_total[2];
+
+/* shape 스위트 공용 합성 데이터: shape마다 FP32·INT8 가중치 (합성 loader 텐서 2개), 최대 크기 입출력 */
+typedef struct {
+    tensor_info_t t[NUM_CONV_SHAPES * 2];
+    char wnames[NUM_CONV_SHAPES * 2][48];
+    float* w_f32[NUM_CONV_SHAPES];
+    int8_t* w_i8[NUM_CONV_SHAPES];
+    float *x, *y, *bias;
+    weights_loader_t loader;
+} shape_data_t;
+
+static void shape_data_free(shape_data_t* d) {
+    free(d->x);
+    free(d->y);
+    free(d->bias);
+    for (int32_t i = 0; i < NUM_CONV_SHAPES; i++) {
+        free(d->w_f32[i]);
+        free(d->w_i8[i]);
+    }
+    memset(d, 0, sizeof(*d));
+}
+
+static int shape_data_init(shape_data_t* d) {
+    size_t x_max = 0, y_max = 0, c_max = 0;
+    memset(d, 0, sizeof(*d));
+    for (int32_t i = 0; i < NUM_CONV_SHAPES; i++) {
+        const conv_shape_t* sh = &CONV_SHAPES[i];
+        const size_t ho = (size_t)shape_out(sh), nw = (size_t)sh->c_out * sh->c_in * sh->k * sh->k;
+        if ((size_t)sh->c_in * sh->h * sh->h > x_max) x_max = (size_t)sh->c_in * sh->h * sh->h;
+        if ((size_t)sh->c_out * ho * ho > y_max) y_max = (size_t)sh->c_out * ho * ho;
+        if ((size_t)sh->c_out > c_max) c_max = (size_t)sh->c_out;
+        d->w_f32[i] = rand_buf(nw, 0.05f);
+        d->w_i8[i] = (int8_t*)malloc(nw);
+        if (!d->w_f32[i] || !d->w_i8[i]) {
+            shape_data_free(d);
+            return -1;
+        }
+        for (size_t j = 0; j < nw; j++) d->w_i8[i][j] = (int8_t)(frand() * 127.0f);
+        /* 3x3 s1은 모델에서 모두 bottleneck cv2 → 같은 이름 규칙이라야 weight_pack이 Winograd 필터를 만듦 */
+        for (int k = 0; k < 2; k++) {
+            tensor_info_t* ti = &d->t[2 * i + k];
+            (void)snprintf(d->wnames[2 * i + k], sizeof(d->wnames[0]), sh->k == 3 && sh->s == 1 ?
+                           "shape.%d.%s.m.0.cv2.conv.weight" : "shape.%d.%s.conv.weight", (int)i, k ? "w8" : "fp32");
+            ti->name = d->wnames[2 * i + k];
+            ti->data = k ? NULL : d->w_f32[i];
+            ti->data_int8 = k ? d->w_i8[i] : NULL;
+            ti->scale = 0.0004f;
+            ti->dtype = k ? WEIGHTS_DTYPE_INT8 : WEIGHTS_DTYPE_FLOAT32;
+            ti->ndim = 4;
+            ti->shape[0] = sh->c_out;
+            ti->shape[1] = sh->c_in;
+            ti->shape[2] = sh->k;
+            ti->shape[3] = sh->k;
+            ti->num_elements = nw;
+        }
+    }
+    d->x = rand_buf(x_max, 2.0f);
+    d->y = rand_buf(y_max, 0.0f);
+    d->bias = rand_buf(c_max, 0.5f);
+    if (!d->x || !d->y || !d->bias) {
+        shape_data_free(d);
+        return -1;
+    }
+    d->loader.tensors = d->t;
+    d->loader.num_tensors = NUM_CONV_SHAPES * 2;
+    return 0;
+}
+
+static int run_shapes(const bench_cfg_t* cfg, int32_t n_threads) {
+    static char names[NUM_CONV_SHAPES * 2][48];
+    static shape_data_t d;
+    if (shape_data_init(&d) != 0) return -1;
+    thread_pool_init(n_threads);
+    if (weight_pack_prepare(&d.loader, conv2d_weight_pack_flags()) != 0)
+        fprintf(stderr, "WARN: weight_pack failed, shapes use unpacked weights\n");
+    memset(s_shape_total, 0, sizeof(s_shape_total));
+    for (int32_t i = 0; i < NUM_CONV_SHAPES; i++) {
+        const conv_shape_t* sh = &CONV_SHAPES[i];
+        const uint64_t ho = (uint64_t)shape_out(sh);
+        const uint64_t flops = 2ULL * sh->c_out * ho * ho * sh->c_in * sh->k * sh->k;
+        shape_ctx_t c = { sh, d.x, d.y, d.w_f32[i], d.w_i8[i], 0.0004f, d.bias };
+        for (int k = 0; k < 2; k++) {
+            (void)snprintf(names[2 * i + k], sizeof(names[0]), "%dx%d_k%ds%d_%d/%s", (int)sh->c_in,
+                           (int)sh->c_out, (int)sh->k, (int)sh->s, (int)sh->h, k ? "w8" : "fp32");
+            bench_result_t* r = run_bench(cfg, names[2 * i + k], NULL, k ? shape_run_w8 : shape_run_f32, &c);
+            if (!r) continue;
+            r->flops = flops;
+            r->count = sh->count;
+            s_shape_total[k].flops += flops * (uint64_t)sh->count;
+            s_shape_total[k].us += r->median * (double)sh->count;
+            s_shape_total[k].shapes++;
+        }
+    }
+    weight_pack_release();
+    thread_pool_shutdown();
+    shape_data_free(&d);
+
+    printf("\n  %-20s %5s %9s %10s %9s\n", "shape/kernel", "count", "MFLOP", "median us", "GFLOP/s");
+    for (int32_t i = 0; i < s_num_results; i++) {
+        const bench_result_t* r = &s_results[i];
+        if (r->flops == 0) continue;
+        printf("  %-20s %5d %9.1f %10.1f %9.2f\n", r->name, (int)r->count, (double)r->flops / 1e6, r->median,
+               r->median > 0.0 ? (double)r->flops / r->median / 1e3 : 0.0);
+    }
+    for (int k = 0; k < 2; k++) {
+        const shape_total_t* st = &s_shape_total[k];
+        if (st->shapes == 0) continue;
+        printf("  %-20s %5s %9.1f %10.1f %9.2f  (count-weighted, %d shapes)\n", k ? "total/w8" : "total/fp32", "",
+               (double)st->flops / 1e6, st->us, st->us > 0.0 ? (double)st->flops / st->us / 1e3 : 0.0,
+               (int)st->shapes);
+    }
+    return 0;
+}
+
+/* ===== direct 블로킹 auto-tune ===== */
+
+/* 후보 1개의 median (µs): warmup 1 + iters회 */
+static double tune_time(shape_ctx_t* c, int32_t iters) {
+    shape_run_w8(c);
+    for (int32_t i = 0; i < iters; i++) {
+        const uint64_t t0 = host_time_ns();
+        shape_run_w8(c);
+        s_samples[i] = (double)(host_time_ns() - t0) / 1000.0;
+    }
+    qsort(s_samples, (size_t)iters, sizeof(double), cmp_double);
+    return (iters & 1) ? s_samples[iters / 2] : 0.5 * (s_samples[iters / 2 - 1] + s_samples[iters / 2]);
+}
+
+/* shape마다 tile_h × tile_w × oc_block 후보를 DIRECT 커널로 재고 최저 median을 plan에 등록 → path에 저장.
+ * plan은 DIRECT 알고리즘(BARE_METAL 기본, 호스트 --conv=direct)에만 적용 → 다른 알고리즘이 선택돼 있으면 경고.
+ * --only로 shape 이름(접미사 없이) 선택 */
+static int run_tune(const bench_cfg_t* cfg, int32_t n_threads, const char* path) {
+    static const int16_t tiles_h[] = { 2, 4, 8, 16 };
+    static const int16_t tiles_w[] = { 4, 8, 16, 32 };
+    static const int16_t ocbs[] = { 8, 16, 32 };
+    static shape_data_t d;
+    const int32_t iters = cfg->iters < 5 ? cfg->iters : 5;
+    double us_def = 0.0, us_best = 0.0;
+    if (shape_data_init(&d) != 0) return -1;
+    if (conv2d_get_algo() != CONV2D_ALGO_DIRECT)
+        fprintf(stderr, "WARN: conv algorithm is not direct; the tuning plan only applies to --conv=direct\n");
+    conv2d_set_algo(CONV2D_ALGO_DIRECT);
+    thread_pool_init(n_threads);
+    if (weight_pack_prepare(&d.loader, conv2d_weight_pack_flags()) != 0)
+        fprintf(stderr, "WARN: weight_pack failed, tuning unpacked weights\n");
+    printf("  %-16s %5s %10s %10s %8s  %s\n", "shape", "count", "default us", "best us", "speedup", "tile_h x tile_w x oc");
+    for (int32_t i = 0; i < NUM_CONV_SHAPES; i++) {
+        const conv_shape_t* sh = &CONV_SHAPES[i];
+        char name[48];
+        (void)snprintf(name, sizeof(name), "%dx%d_k%ds%d_%d", (int)sh->c_in, (int)sh->c_out, (int)sh->k,
+                       (int)sh->s, (int)sh->h);
+        if (!selected(cfg, name)) continue;
+        const int16_t ho = (int16_t)shape_out(sh);
+        const conv2d_shape_t key = { sh->c_in, sh->c_out, sh->k, sh->k, sh->s, sh->s, ho, ho };
+        shape_ctx_t c = { sh, d.x, d.y, d.w_f32[i], d.w_i8[i], 0.0004f, d.bias };
+        conv2d_blocking_t best = conv2d_blocking_default();
+        (void)conv2d_tune_set(&key, &best);
+        const double t_def = tune_time(&c, iters);
+        double t_best = t_def;
+        for (size_t a = 0; a < sizeof(tiles_h) / sizeof(tiles_h[0]); a++) {
+            for (size_t b = 0; b < sizeof(tiles_w) / sizeof(tiles_w[0]); b++) {
+                for (size_t o = 0; o < sizeof(ocbs) / sizeof(ocbs[0]); o++) {
+                    const conv2d_blocking_t cand = { tiles_h[a], tiles_w[b], ocbs[o] };
+                    /* 출력보다 큰 타일·c_out보다 큰 oc 블록은 작은 후보와 같은 일 */
+                    if (cand.tile_h > ho || cand.tile_w > ho || (cand.oc_block > sh->c_out && cand.oc_block > 8))
+                        continue;
+                    if (conv2d_tune_set(&key, &cand) != 0) continue;
+                    const double t = tune_time(&c, iters);
+                    if (t < t_best) {
+                        t_best = t;
+                        best = cand;
+                    }
+                }
+            }
+        }
+        (void)conv2d_tune_set(&key, &best);
+        us_def += t_def * sh->count;
+        us_best += t_best * sh->count;
+        printf("  %-16s %5d %10.1f %10.1f %7.2fx  %d x %d x %d\n", name, (int)sh->count, t_def, t_best,
+               t_def / t_best, (int)best.tile_h, (int)best.tile_w, (int)best.oc_block);
+    }
+    weight_pack_release();
+    thread_pool_shutdown();
+    shape_data_free(&d);
+    if (us_best > 0.0)
+        printf("  %-16s %5s %10.1f %10.1f %7.2fx  (count-weighted)\n", "total", "", us_def, us_best, us_def / us_best);
+    if (conv2d_tune_save(path) != 0) {
+        fprintf(stderr, "cannot write %s\n", path);
+        return -1;
+    }
+    printf("Tuning plan (%d shapes) saved to %s\n", (int)conv2d_tune_count(), path);
+    return 0;
+}
+
+/* ===== 결과 / 회귀 판정 ===== */
+
+/* write_json이 쓴 한 줄 한 벤치 형식에서 name → median */
+static int load_baseline(const char* path, double threshold_pct) {
+    FILE* f = fopen(path, "r");
+    if (!f) return -1;
+    char line[512];
+    while (fgets(line, sizeof(line), f)) {
+        const char* n = strstr(line, "\"name\": \"");
+        const char* m = strstr(line, "\"median\": ");
+        if (!n || !m) continue;
+        n += 9;
+        const char* e = strchr(n, '"');
+        if (!e) continue;
+        for (int32_t i = 0; i < s_num_results; i++) {
+            bench_result_t* r = &s_results[i];
+            if (strlen(r->name) != (size_t)(e - n) || strncmp(r->name, n, (size_t)(e - n)) != 0) continue;
+            r->base_median = strtod(m + 10, NULL);
+            if (r->base_median <= 0.0) continue;
+            const double ratio = r->median / r->base_median;
+            r->verdict = ratio > 1.0 + threshold_pct / 100.0 ? "regression"
+                       : ratio < 1.0 - threshold_pct / 100.0 ? "improved" : "ok";
+        }
+    }
+    fclose(f);
+    return 0;
+}
+
+static int write_json(const char* path, const bench_cfg_t* cfg, int32_t threads, const char* tag,
+                      const char* baseline, double threshold_pct, const char* overall) {
+    FILE* f = fopen(path, "w");
+    if (!f) return -1;
+    fprintf(f, "{\n  \"meta\": {\"tag\": \"%s\", \"clock\": \"monotonic_ns\", \"unit\": \"us\", "
+               "\"warmup\": %d, \"iters\": %d, \"threads\": %d, \"weights\": \"%s\", \"conv\": \"%s\", "
+               "\"isa\": \"%s\", \"silu\": \"%s\", \"head\": \"%s\", \"suite\": \"%s\"},\n",
+            tag ? tag : "", (int)cfg->warmup, (int)cfg->iters, (int)threads,
+#ifdef USE_WEIGHTS_W8
+            "w8",
+#else
+            "fp32",
+#endif
+            conv2d_get_algo() == CONV2D_ALGO_WINOGRAD ? "winograd" :
+            conv2d_get_algo() == CONV2D_ALGO_GEMM ? "gemm" : "direct",
+            CONV2D_1X1_ISA, silu_get_mode() == SILU_FAST ? "fast" : "exact",
+            detect_get_head_mode() == DETECT_HEAD_SPARSE ? "sparse" : "dense",
+            cfg->suite == BENCH_SUITE_ALL ? "all" : cfg->suite == BENCH_SUITE_SHAPES ? "shapes" : "blocks");
+    for (int k = 0; k < 2; k++) {
+        const shape_total_t* st = &s_shape_total[k];
+        if (st->shapes == 0) continue;
+        fprintf(f, "  \"conv_total_%s\": {\"shapes\": %d, \"flops\": %llu, \"us\": %.3f, \"gflops\": %.3f},\n",
+                k ? "w8" : "fp32", (int)st->shapes, (unsigned long long)st->flops, st->us,
+                st->us > 0.0 ? (double)st->flops / st->us / 1e3 : 0.0);
+    }
+    if (baseline) {
+        fprintf(f, "  \"compare\": {\"baseline\": \"%s\", \"threshold_pct\": %.2f, \"verdict\": \"%s\"},\n",
+                baseline, threshold_pct, overall);
+    }
+    fprintf(f, "  \"benches\": [\n");
+    for (int32_t i = 0; i < s_num_results; i++) {
+        const bench_result_t* r = &s_results[i];
+        fprintf(f, "    {\"name\": \"%s\", \"n\": %d, \"min\": %.3f, \"median\": %.3f, \"p90\": %.3f, \"p99\": %.3f, "
+                   "\"max\": %.3f, \"mean\": %.3f, \"stddev\": %.3f",
+                r->name, (int)r->n, r->min, r->median, r->p90, r->p99, r->max, r->mean, r->stddev);
+        if (r->flops) {
+            fprintf(f, ", \"count\": %d, \"flops\": %llu, \"gflops\": %.3f", (int)r->count,
+                    (unsigned long long)r->flops, r->median > 0.0 ? (double)r->flops / r->median / 1e3 : 0.0);
+        }
+        if (baseline) fprintf(f, ", \"base_median\": %.3f, \"verdict\": \"%s\"", r->base_median, r->verdict);
+        fprintf(f, "}%s\n", i + 1 < s_num_results ? "," : "");
+    }
+    fprintf(f, "  ]\n}\n");
+    return fclose(f) == 0 ? 0 : -1;
+}
+
+int main(int argc, char* argv[]) {
+    bench_cfg_t cfg = { 3, 20, NULL, BENCH_SUITE_BLOCKS };
+    int32_t n_threads = 0;
+    const char* out_path = "data/output/bench.json";
+    const char* baseline = NULL;
+    const char* tag = NULL;
+    const char* image_path = "data/input/preprocessed_image.bin";
+    double threshold = 5.0;
+    const char* tune_out = NULL;
+#ifdef USE_WEIGHTS_W8
+    const char* weights_path = "assets/weights_w8.bin";
+#else
+    const char* weights_path = "assets/weights.bin";
+#endif
+    for (int i = 1; i < argc; i++) {
+        if (strncmp(argv[i], "--warmup=", 9) == 0) cfg.warmup = (int32_t)atoi(argv[i] + 9);
+        else if (strncmp(argv[i], "--iters=", 8) == 0) cfg.iters = (int32_t)atoi(argv[i] + 8);
+        else if (strncmp(argv[i], "--threads=", 10) == 0) n_threads = (int32_t)atoi(argv[i] + 10);
+        /* --only=network,conv,... : 실행할 벤치 (기본 전부) */
+        else if (strncmp(argv[i], "--only=", 7) == 0) cfg.only = argv[i] + 7;
+        /* --suite=blocks|shapes|all : shapes = 모델 conv shape별 conv2d_nchw_f32 / _w8 (가중치 파일 불필요) */
+        else if (strcmp(argv[i], "--suite=blocks") == 0) cfg.suite = BENCH_SUITE_BLOCKS;
+        else if (strcmp(argv[i], "--suite=shapes") == 0) cfg.suite = BENCH_SUITE_SHAPES;
+        else if (strcmp(argv[i], "--suite=all") == 0) cfg.suite = BENCH_SUITE_ALL;
+        /* --tune[=PATH] : direct 블로킹 auto-tune → plan 저장 후 종료. --tune-file=PATH : 저장된 plan 적용 */
+        else if (strcmp(argv[i], "--tune") == 0) tune_out = "data/output/conv2d_tune.txt";
+        else if (strncmp(argv[i], "--tune=", 7) == 0) tune_out = argv[i] + 7;
+        else if (strncmp(argv[i], "--tune-file=", 12) == 0) {
+            if (conv2d_tune_load(argv[i] + 12) < 0) {
+                fprintf(stderr, "cannot load tuning plan %s\n", argv[i] + 12);
+                return 1;
+            }
+        }
+        else if (strncmp(argv[i], "--out=", 6) == 0) out_path = argv[i] + 6;
+        else if (strncmp(argv[i], "--baseline=", 11) == 0) baseline = argv[i] + 11;
+        /* --threshold=PCT : median이 기준보다 PCT% 넘게 느리면 regression (기본 5) */
+        else if (strncmp(argv[i], "--threshold=", 12) == 0) threshold = atof(argv[i] + 12);
+        /* --tag=STR : JSON meta에 기록 (예: git rev-parse --short HEAD) */
+        else if (strncmp(argv[i], "--tag=", 6) == 0) tag = argv[i] + 6;
+        else if (strncmp(argv[i], "--weights=", 10) == 0) weights_path = argv[i] + 10;
+        else if (strncmp(argv[i], "--image=", 8) == 0) image_path = argv[i] + 8;
+        else if (strcmp(argv[i], "--conv=direct") == 0) conv2d_set_algo(CONV2D_ALGO_DIRECT);
+        else if (strcmp(argv[i], "--conv=gemm") == 0) conv2d_set_algo(CONV2D_ALGO_GEMM);
+        else if (strcmp(argv[i], "--conv=winograd") == 0) conv2d_set_algo(CONV2D_ALGO_WINOGRAD);
+        else if (strcmp(argv[i], "--silu=exact") == 0) silu_set_mode(SILU_EXACT);
+        else if (strcmp(argv[i], "--silu=fast") == 0) silu_set_mode(SILU_FAST);
+        else if (strcmp(argv[i], "--head=dense") == 0) detect_set_head_mode(DETECT_HEAD_DENSE);
+        else if (strcmp(argv[i], "--head=sparse") == 0) detect_set_head_mode(DETECT_HEAD_SPARSE);
+        else {
+            fprintf(stderr, "unknown option: %s\n", argv[i]);
+            return 1;
+        }
+    }
+    if (cfg.warmup < 0) cfg.warmup = 0;
+    if (cfg.iters < 1) cfg.iters = 1;
+    if (cfg.iters > BENCH_MAX_ITERS) cfg.iters = BENCH_MAX_ITERS;
+
+    printf("=== YOLOv5n bench (warmup %d, iters %d, 1x1 %s) ===\n", (int)cfg.warmup, (int)cfg.iters, CONV2D_1X1_ISA);
+    if (tune_out) return run_tune(&cfg, n_threads, tune_out) == 0 ? 0 : 1;
+    if (conv2d_tune_count() > 0 && conv2d_get_algo() != CONV2D_ALGO_DIRECT)
+        fprintf(stderr, "WARN: tuning plan loaded but conv algorithm is not direct (plan unused)\n");
+
+    /* 전체 네트워크: 세션 1개 (가중치·풀 상주), 이미지가 없으면 고정 시드 난수 입력 */
+    int32_t threads_used = n_threads;
+    if ((cfg.suite & BENCH_SUITE_BLOCKS) && selected(&cfg, "network")) {
+        static net_ctx_t net;
+        memset(&net, 0, sizeof(net));
+        if (image_load_from_bin(image_path, &net.img) != 0) {
+            net.img.data = rand_buf((size_t)3 * YOLO_INPUT_SIZE * YOLO_INPUT_SIZE, 0.5f);
+            if (!net.img.data) return 1;
+            for (size_t i = 0; i < (size_t)3 * YOLO_INPUT_SIZE * YOLO_INPUT_SIZE; i++) net.img.data[i] += 0.5f;
+            net.img.c = 3;
+            net.img.h = net.img.w = YOLO_INPUT_SIZE;
+            net.img.data_owned = 1;
+            printf("  (no %s, random input)\n", image_path);
+        }
+        net.s = yolo_session_create(weights_path, n_threads, 1);
+        if (!net.s) {
+            image_free(&net.img);
+            return 1;
+        }
+        threads_used = thread_pool_size();
+        run_bench(&cfg, "network", NULL, net_run, &net);
+        yolo_session_destroy(net.s);
+        image_free(&net.img);
+    }
+    if ((cfg.suite & BENCH_SUITE_BLOCKS) && run_blocks(&cfg, weights_path, n_threads) != 0) {
+        fprintf(stderr, "block benches failed (weights %s)\n", weights_path);
+        return 1;
+    }
+    if ((cfg.suite & BENCH_SUITE_SHAPES) && run_shapes(&cfg, n_threads) != 0) {
+        fprintf(stderr, "conv shape benches failed (out of memory)\n");
+        return 1;
+    }
+    if (threads_used <= 0) {
+        thread_pool_init(n_threads);
+        threads_used = thread_pool_size();
+        thread_pool_shutdown();
+    }
+
+    const char* overall = "ok";
+    if (baseline) {
+        if (load_baseline(baseline, threshold) != 0) {
+            fprintf(stderr, "cannot read baseline %s\n", baseline);
+            return 1;
+        }
+        printf("\nvs %s (threshold %.1f%%):\n", baseline, threshold);
+        for (int32_t i = 0; i < s_num_results; i++) {
+            const bench_result_t* r = &s_results[i];
+            if (r->base_median > 0.0) {
+                printf("  %-20s %10.1f -> %10.1f us  %+6.1f%%  %s\n", r->name, r->base_median, r->median,
+                       100.0 * (r->median / r->base_median - 1.0), r->verdict);
+            } else {
+                printf("  %-20s %10s -> %10.1f us  %7s  %s\n", r->name, "-", r->median, "", r->verdict);
+            }
+            if (strcmp(r->verdict, "regression") == 0) overall = "regression";
+        }
+        printf("Verdict: %s\n", strcmp(overall, "regression") == 0 ? "REGRESSION" : "OK");
+    }
+    if (write_json(out_path, &cfg, threads_used, tag, baseline, threshold, overall) != 0) {
+        fprintf(stderr, "cannot write %s\n", out_path);
+        return 1;
+    }
+    printf("Saved to %s\n", out_path);
+    return strcmp(overall, "regression") == 0 ? 2 : 0;
+}
@@ -1,36 +1,35 @@
 #include "c3.h"
 #include "../operations/conv2d.h"
-#include "../operations/silu.h"
 #include "../operations/bottleneck.h"
-#include "../operations/concat.h"
 #include "../utils/feature_pool.h"
 #include "../utils/timing.h"
+#include "../utils/profiler.h"
+#include "../utils/roofline.h"
 #include <stdint.h>
 #ifdef BARE_METAL
 #include "xil_printf.h"
 #endif
 
+/* 1x1 conv + SiLU (epilogue). x/y는 x_ct/y_ct 채널 텐서의 채널 구간일 수 있음 (batch 전체 한 번 호출) */
 static void conv1x1(
-    const float* x, int32_t n, int32_t c_in, int32_t h, int32_t w,
+    const float* x, int32_t x_ct, int32_t n, int32_t c_in, int32_t h, int32_t w,
     const void* w_ptr, float w_scale, int w_is_int8, int32_t c_out, const float* bias,
-    float* y)
+    float* y, int32_t y_ct)
 {
-    if (w_is_int8) {
-        conv2d_nchw_f32_w8(x, n, c_in, h, w,
-                           (const int8_t*)w_ptr, w_scale, c_out, 1, 1,
-                           bias, 1, 1, 0, 0, 1,
-                           y, h, w);
-    } else {
-        conv2d_nchw_f32(x, n, c_in, h, w,
-                        (const float*)w_ptr, c_out, 1, 1,
-                        bias, 1, 1, 0, 0, 1,
-                        y, h, w);
-    }
-    silu_nchw_f32(y, n, c_out, h, w, y);
+    const conv2d_epilogue_t ep = { 1, NULL, 0 };
+    conv2d_fused_slice_nchw_f32(x, x_ct, n, c_in, h, w, w_ptr, w_scale, w_is_int8, c_out, 1, 1,
+                                bias, 1, 1, 0, 0, &ep, y, y_ct, h, w);
+}
+
+size_t c3_scratch_bytes(int32_t n, int32_t cv1_c_out, int32_t cv2_c_out, int32_t h, int32_t w) {
+    const size_t plane = (size_t)n * (size_t)h * (size_t)w * sizeof(float);
+    return plane * (size_t)(cv1_c_out + cv2_c_out)          /* concat (cv1→bottleneck | cv2) */
+         + bottleneck_scratch_bytes(n, cv1_c_out, cv1_c_out, h, w);  /* bottleneck은 batch 한 번 호출 */
 }
 
 void c3_nchw_f32(
     const float* x, int32_t n, int32_t c_in, int32_t h, int32_t w,
+    const conv2d_up_concat_t* x_up,
     const void* cv1_w, float cv1_scale, int cv1_is_int8, int32_t cv1_c_out, const float* cv1_bias,
     const void* cv2_w, float cv2_scale, int cv2_is_int8, int32_t cv2_c_out, const float* cv2_bias,
     const void* cv3_w, float cv3_scale, int cv3_is_int8, int32_t cv3_c_out, const float* cv3_bias,
@@ -40,63 +39,75 @@ void c3_nchw_f32(
     const void** bn_cv2_w, const float* bn_cv2_scale, const int* bn_cv2_is_int8,
     const float* const* bn_cv2_bias,
     int32_t shortcut,
-    float* y)
+    float* y, int32_t y_c_total,
+    float* scratch)
 {
-    size_t cv1_bytes = (size_t)n * (size_t)cv1_c_out * (size_t)h * (size_t)w * sizeof(float);
-    size_t cv2_bytes = (size_t)n * (size_t)cv2_c_out * (size_t)h * (size_t)w * sizeof(float);
-    size_t cat_bytes = (size_t)n * (size_t)(cv1_c_out + cv2_c_out) * (size_t)h * (size_t)w * sizeof(float);
-
-    float* concat_out = (float*)feature_pool_alloc(cat_bytes);
-    float* cv1_out = (float*)feature_pool_alloc(cv1_bytes);
-    float* cv2_out = (float*)feature_pool_alloc(cv2_bytes);
-    float* bn_a = (float*)feature_pool_alloc(cv1_bytes);
-    float* bn_b = (float*)feature_pool_alloc(cv1_bytes);
-
-    if (!concat_out || !cv1_out || !cv2_out || !bn_a || !bn_b) {
+    const int32_t c_cat = cv1_c_out + cv2_c_out;
+    const size_t hw = (size_t)h * (size_t)w;
+    float* owned = NULL;
+    if (y_c_total <= 0) y_c_total = cv3_c_out;
+    if (!scratch) {
+        owned = (float*)feature_pool_alloc(c3_scratch_bytes(n, cv1_c_out, cv2_c_out, h, w));
+        if (!owned) {
 #ifdef BARE_METAL
-        xil_printf("C3 pool alloc failed cat=%08X cv1=%08X cv2=%08X bn_a=%08X bn_b=%08X\n",
-                   (unsigned)(uintptr_t)concat_out, (unsigned)(uintptr_t)cv1_out,
-                   (unsigned)(uintptr_t)cv2_out, (unsigned)(uintptr_t)bn_a,
-                   (unsigned)(uintptr_t)bn_b);
+            xil_printf("C3 pool alloc failed\n");
 #endif
-        if (bn_b) feature_pool_free(bn_b);
-        if (bn_a) feature_pool_free(bn_a);
-        if (cv2_out) feature_pool_free(cv2_out);
-        if (cv1_out) feature_pool_free(cv1_out);
-        if (concat_out) feature_pool_free(concat_out);
-        return;
+            return;
+        }
+        scratch = owned;
+    }
+    /* concat 버퍼 [cv1 경로 | cv2] 채널 구간에 바로 출력 → concat 복사 없음 */
+    float* concat_out = scratch;
+    float* cv1_out = concat_out;
+    float* cv2_out = concat_out + (size_t)cv1_c_out * hw;
+    float* bn_scratch = concat_out + (size_t)n * c_cat * hw;
+    prof_begin("C3");
+    {
+        /* roofline: cv1·cv2가 각각 입력을 읽는 것으로 계산. 가상 concat이면 업샘플 채널은 1/4 면적 */
+        const uint64_t in_elems = x_up ? (uint64_t)x_up->c_up * (uint64_t)(h / 2) * (uint64_t)(w / 2) +
+                                         (uint64_t)(c_in - x_up->c_up) * hw
+                                       : (uint64_t)c_in * hw;
+        roofline_conv(n, c_in, 0, 0, cv1_c_out, 1, 1, h, w, cv1_is_int8);
+        roofline_conv(n, c_in, 0, 0, cv2_c_out, 1, 1, h, w, cv2_is_int8);
+        roofline_add(0, 0, 2u * (uint64_t)n * in_elems * sizeof(float), 0);
+        for (int32_t i = 0; i < n_bottleneck; i++) {
+            roofline_conv(n, cv1_c_out, h, w, cv1_c_out, 1, 1, h, w, bn_cv1_is_int8[i]);
+            roofline_conv(n, cv1_c_out, h, w, cv1_c_out, 3, 3, h, w, bn_cv2_is_int8[i]);
+            if (shortcut) roofline_add(0, 0, (uint64_t)n * (uint64_t)cv1_c_out * hw * sizeof(float), 0);
+        }
+        roofline_conv(n, c_cat, h, w, cv3_c_out, 1, 1, h, w, cv3_is_int8);
+    }
+
+    /* cv1·cv2는 입력이 같음: weight_pack 연결 패널이 있으면 x를 한 번만 읽어 concat 전체를 채움.
+       가상 concat 입력이면 업샘플 채널을 index halving으로 직접 읽음 (업샘플·concat 버퍼 없음) */
+    yolo_timing_begin("cv1+cv2");
+    const conv2d_epilogue_t ep = { 1, NULL, 0 };
+    if (x_up) {
+        conv2d_up_concat_1x1_nchw_f32(x_up, n, c_in, h, w,
+                                      cv1_w, cv1_scale, cv1_is_int8, cv1_c_out, cv1_bias,
+                                      cv2_w, cv2_scale, cv2_is_int8, cv2_c_out, cv2_bias, &ep, concat_out);
+    } else if (!conv2d_pair_1x1_nchw_f32(x, n, c_in, h, w, cv1_w, cv1_c_out, cv1_bias,
+                                  cv2_w, cv2_c_out, cv2_bias, &ep, concat_out)) {
+        conv1x1(x, c_in, n, c_in, h, w, cv1_w, cv1_scale, cv1_is_int8, cv1_c_out, cv1_bias, cv1_out, c_cat);
+        conv1x1(x, c_in, n, c_in, h, w, cv2_w, cv2_scale, cv2_is_int8, cv2_c_out, cv2_bias, cv2_out, c_cat);
     }
-    
-    yolo_timing_begin("cv1");
-    conv1x1(x, n, c_in, h, w, cv1_w, cv1_scale, cv1_is_int8, cv1_c_out, cv1_bias, cv1_out);
-    yolo_timing_end();
-    yolo_timing_begin("cv2");
-    conv1x1(x, n, c_in, h, w, cv2_w, cv2_scale, cv2_is_int8, cv2_c_out, cv2_bias, cv2_out);
     yolo_timing_end();
     yolo_timing_begin("bottleneck");
-    const float* bn_in = cv1_out;
-    float* bn_out = bn_a;
+    /* bottleneck은 제자리 실행 가능 (x는 cv1 입력으로 먼저 다 읽고, residual은 같은 원소끼리).
+       concat 앞 cv1_c_out 채널 구간을 batch 전체 한 번에 → 가중치를 이미지 사이에 재사용 */
     for (int32_t i = 0; i < n_bottleneck; i++) {
-        bn_out = (i % 2 == 0) ? bn_a : bn_b;
         bottleneck_nchw_f32(
-            bn_in, n, cv1_c_out, h, w,
+            cv1_out, c_cat, n, cv1_c_out, h, w,
             bn_cv1_w[i], bn_cv1_scale[i], bn_cv1_is_int8[i], cv1_c_out, bn_cv1_bias[i],
             bn_cv2_w[i], bn_cv2_scale[i], bn_cv2_is_int8[i], cv1_c_out, bn_cv2_bias[i],
             shortcut,
-            bn_out);
-        bn_in = bn_out;
+            cv1_out, bn_scratch);
     }
     yolo_timing_end();
-    yolo_timing_begin("concat");
-    concat_nchw_f32(bn_out, cv1_c_out, cv2_out, cv2_c_out, n, h, w, concat_out);
-    yolo_timing_end();
     yolo_timing_begin("cv3");
-    conv1x1(concat_out, n, cv1_c_out + cv2_c_out, h, w, cv3_w, cv3_scale, cv3_is_int8, cv3_c_out, cv3_bias, y);
+    conv1x1(concat_out, c_cat, n, c_cat, h, w, cv3_w, cv3_scale, cv3_is_int8, cv3_c_out, cv3_bias, y, y_c_total);
     yolo_timing_end();
+    prof_end();
 
-    feature_pool_free(concat_out);
-    feature_pool_free(bn_b);
-    feature_pool_free(bn_a);
-    feature_pool_free(cv2_out);
-    feature_pool_free(cv1_out);
+    if (owned) feature_pool_free(owned);
 }
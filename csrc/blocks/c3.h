@@ -2,10 +2,16 @@
 #define C3_H
 
 #include <stdint.h>
+#include <stddef.h>
+#include "../operations/conv2d_1x1.h"
+
+/* 내부 scratch 크기 (바이트): concat(cv1·cv2가 채널 구간에 바로 출력, bottleneck은 제자리) + bottleneck 내부 */
+size_t c3_scratch_bytes(int32_t n, int32_t cv1_c_out, int32_t cv2_c_out, int32_t h, int32_t w);
 
 /* W8A32: cv1/cv2/cv3_w는 void*, scale/is_int8로 구분. bn_cv1_w/bn_cv2_w는 void* 배열, bn_cv1_scale/bn_cv1_is_int8 등 병렬 배열 */
 void c3_nchw_f32(
     const float* x, int32_t n, int32_t c_in, int32_t h, int32_t w,
+    const conv2d_up_concat_t* x_up,  // NULL이 아니면 입력은 x 대신 가상 concat [up2x | x] (cv1·cv2가 직접 읽음)
     const void* cv1_w, float cv1_scale, int cv1_is_int8, int32_t cv1_c_out, const float* cv1_bias,
     const void* cv2_w, float cv2_scale, int cv2_is_int8, int32_t cv2_c_out, const float* cv2_bias,
     const void* cv3_w, float cv3_scale, int cv3_is_int8, int32_t cv3_c_out, const float* cv3_bias,
@@ -15,6 +21,8 @@ void c3_nchw_f32(
     const void** bn_cv2_w, const float* bn_cv2_scale, const int* bn_cv2_is_int8,
     const float* const* bn_cv2_bias,
     int32_t shortcut,  // 1=add residual in bottleneck, 0=no shortcut
-    float* y);
+    float* y,
+    int32_t y_c_total, // y가 y_c_total 채널 텐서의 채널 구간 (concat 대상에 바로 출력). 0 = cv3_c_out (연속)
+    float* scratch);   // c3_scratch_bytes 이상, NULL이면 feature_pool에서 할당
 
 #endif // C3_H
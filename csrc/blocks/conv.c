@@ -1,7 +1,9 @@
 #include "conv.h"
 #include "../operations/conv2d.h"
-#include "../operations/silu.h"
 #include "../utils/timing.h"
+#include "../utils/profiler.h"
+#include "../utils/roofline.h"
+#include <stddef.h>
 
 void conv_block_nchw_f32(
     const float* x, int32_t n, int32_t c_in, int32_t h_in, int32_t w_in,
@@ -12,20 +14,26 @@ void conv_block_nchw_f32(
     const float* bias,
     float* y, int32_t h_out, int32_t w_out)
 {
+    conv_block_slice_nchw_f32(x, 0, n, c_in, h_in, w_in, w, w_scale, w_is_int8, c_out, k_h, k_w,
+                              stride_h, stride_w, pad_h, pad_w, bias, y, 0, h_out, w_out);
+}
+
+void conv_block_slice_nchw_f32(
+    const float* x, int32_t x_c_total, int32_t n, int32_t c_in, int32_t h_in, int32_t w_in,
+    const void* w, float w_scale, int w_is_int8,
+    int32_t c_out, int32_t k_h, int32_t k_w,
+    int32_t stride_h, int32_t stride_w,
+    int32_t pad_h, int32_t pad_w,
+    const float* bias,
+    float* y, int32_t y_c_total, int32_t h_out, int32_t w_out)
+{
+    /* SiLU는 conv 출력 타일을 쓸 때 적용 (별도 패스 없음) */
+    const conv2d_epilogue_t ep = { 1, NULL, 0 };
+    prof_begin("Conv");
+    roofline_conv(n, c_in, h_in, w_in, c_out, k_h, k_w, h_out, w_out, w_is_int8);
     yolo_timing_begin("conv2d");
-    if (w_is_int8 && w) {
-        conv2d_nchw_f32_w8(x, n, c_in, h_in, w_in,
-                           (const int8_t*)w, w_scale, c_out, k_h, k_w,
-                           bias, stride_h, stride_w, pad_h, pad_w, 1,
-                           y, h_out, w_out);
-    } else if (w) {
-        conv2d_nchw_f32(x, n, c_in, h_in, w_in,
-                        (const float*)w, c_out, k_h, k_w,
-                        bias, stride_h, stride_w, pad_h, pad_w, 1,
-                        y, h_out, w_out);
-    }
-    yolo_timing_end();
-    yolo_timing_begin("silu");
-    silu_nchw_f32(y, n, c_out, h_out, w_out, y);
+    conv2d_fused_slice_nchw_f32(x, x_c_total, n, c_in, h_in, w_in, w, w_scale, w_is_int8, c_out, k_h, k_w,
+                                bias, stride_h, stride_w, pad_h, pad_w, &ep, y, y_c_total, h_out, w_out);
     yolo_timing_end();
+    prof_end();
 }
@@ -13,4 +13,15 @@ void conv_block_nchw_f32(
     const float* bias,
     float* y, int32_t h_out, int32_t w_out);
 
+/* 채널 구간 입출력: x/y가 x_c_total/y_c_total 채널 텐서 안의 구간 시작을 가리킴
+ * (concat 버퍼에 바로 쓰거나 거기서 바로 읽기, 0 이하면 밀집). batch 전체를 호출 한 번으로 (이미지 간격은 커널이 처리) */
+void conv_block_slice_nchw_f32(
+    const float* x, int32_t x_c_total, int32_t n, int32_t c_in, int32_t h_in, int32_t w_in,
+    const void* w, float w_scale, int w_is_int8,
+    int32_t c_out, int32_t k_h, int32_t k_w,
+    int32_t stride_h, int32_t stride_w,
+    int32_t pad_h, int32_t pad_w,
+    const float* bias,
+    float* y, int32_t y_c_total, int32_t h_out, int32_t w_out);
+
 #endif // CONV_H
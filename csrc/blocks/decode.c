@@ -7,6 +7,67 @@ static inline float sigmoid_f(float x) {
     return 1.0f / (1.0f + expf(-x));
 }
 
+/* 조기 탈락 여유: logit 임계값을 이만큼 낮춰 (sigmoid_f 반올림 오차 ≪ 여유) 걸러낸 anchor는
+ * 원래 계산으로도 conf < 임계값 → 검출 결과 bit-identical */
+#define DECODE_LOGIT_MARGIN 1e-3
+#define DECODE_CONF_MARGIN  (1.0f - 1e-6f)
+
+float decode_obj_logit_cut(float conf_threshold) {
+    /* conf = obj * max_cls <= obj 이므로 sigmoid(obj) < 임계값이면 클래스 볼 필요 없음.
+     * 임계값이 1에 너무 가까우면 (sigmoid 기울기 ≈ 0) 여유가 반올림 오차보다 작아지므로 컷 생략 */
+    if (!(conf_threshold > 0.0f && conf_threshold < 0.99f)) return -INFINITY;
+    return (float)(log((double)conf_threshold / (1.0 - (double)conf_threshold)) - DECODE_LOGIT_MARGIN);
+}
+
+int32_t decode_anchor_f32(const float* v, int32_t vs, int32_t num_classes, float conf_threshold,
+                          int32_t x, int32_t y, float stride, const float anc_wh[2], int32_t input_size,
+                          detection_t* det)
+{
+    float obj_conf = sigmoid_f(v[4 * vs]);
+    if (obj_conf < conf_threshold) return 0;
+    /* 최대 클래스 logit 한 개만 sigmoid (sigmoid 단조) */
+    if (num_classes > 0) {
+        const float* cls = v + 5 * vs;
+        float lmax = cls[0];
+        for (int c = 1; c < num_classes; c++) {
+            const float l = cls[c * vs];
+            if (l > lmax) lmax = l;
+        }
+        if (obj_conf * sigmoid_f(lmax) < conf_threshold * DECODE_CONF_MARGIN) return 0;
+    }
+
+    /* 통과한 anchor만 기존 계산 그대로 (클래스 id·conf 동일) */
+    float max_cls = 0.0f;
+    int32_t max_cls_id = 0;
+    for (int c = 0; c < num_classes; c++) {
+        float cv = sigmoid_f(v[(5 + c) * vs]);
+        if (cv > max_cls) { max_cls = cv; max_cls_id = c; }
+    }
+    float conf = obj_conf * max_cls;
+    if (conf < conf_threshold) return 0;
+
+    float tx = sigmoid_f(v[0 * vs]);
+    float ty = sigmoid_f(v[1 * vs]);
+    float tw = sigmoid_f(v[2 * vs]);
+    float th = sigmoid_f(v[3 * vs]);
+
+    float gx = (float)x - 0.5f;
+    float gy = (float)y - 0.5f;
+    float cx = (tx * 2.0f + gx) * stride;
+    float cy = (ty * 2.0f + gy) * stride;
+
+    float ww = (tw * 2.0f) * (tw * 2.0f) * anc_wh[0];
+    float hh = (th * 2.0f) * (th * 2.0f) * anc_wh[1];
+
+    det->x = cx / (float)input_size;
+    det->y = cy / (float)input_size;
+    det->w = ww / (float)input_size;
+    det->h = hh / (float)input_size;
+    det->conf = conf;
+    det->cls_id = max_cls_id;
+    return 1;
+}
+
 int32_t decode_nchw_f32(
     const float* p3, int32_t p3_h, int32_t p3_w,
     const float* p4, int32_t p4_h, int32_t p4_w,
@@ -22,6 +83,7 @@ int32_t decode_nchw_f32(
     yolo_timing_begin("decode");
     int32_t count = 0;
     const int32_t no = 5 + num_classes;
+    const float obj_cut = decode_obj_logit_cut(conf_threshold);
 
     for (int scale = 0; scale < 3; scale++) {
         const float* feat = NULL;
@@ -45,45 +107,13 @@ int32_t decode_nchw_f32(
                 for (int a = 0; a < 3; a++) {
                     const int32_t base = (a * no) * gsize + spatial;
 
-                    float bx = feat[base + 0 * gsize];
-                    float by = feat[base + 1 * gsize];
-                    float bw = feat[base + 2 * gsize];
-                    float bh = feat[base + 3 * gsize];
-                    float obj_logit = feat[base + 4 * gsize];
-
-                    float obj_conf = sigmoid_f(obj_logit);
-                    float max_cls = 0.0f;
-                    int32_t max_cls_id = 0;
-                    for (int c = 0; c < num_classes; c++) {
-                        float v = sigmoid_f(feat[base + (5 + c) * gsize]);
-                        if (v > max_cls) { max_cls = v; max_cls_id = c; }
-                    }
-                    float conf = obj_conf * max_cls;
-                    if (conf < conf_threshold) continue;
+                    /* logit 공간 objectness 컷 (sigmoid 없음, 대부분 여기서 탈락) */
+                    if (feat[base + 4 * gsize] < obj_cut) continue;
+                    detection_t d;
+                    if (!decode_anchor_f32(feat + base, gsize, num_classes, conf_threshold,
+                                           x, y, stride, anc + a * 2, input_size, &d)) continue;
                     if (count >= max_detections) goto done;
-
-                    float tx = sigmoid_f(bx);
-                    float ty = sigmoid_f(by);
-                    float tw = sigmoid_f(bw);
-                    float th = sigmoid_f(bh);
-
-                    float gx = (float)x - 0.5f;
-                    float gy = (float)y - 0.5f;
-                    float cx = (tx * 2.0f + gx) * stride;
-                    float cy = (ty * 2.0f + gy) * stride;
-
-                    float aw = anc[a * 2 + 0];
-                    float ah = anc[a * 2 + 1];
-                    float ww = (tw * 2.0f) * (tw * 2.0f) * aw;
-                    float hh = (th * 2.0f) * (th * 2.0f) * ah;
-
-                    detections[count].x = cx / (float)input_size;
-                    detections[count].y = cy / (float)input_size;
-                    detections[count].w = ww / (float)input_size;
-                    detections[count].h = hh / (float)input_size;
-                    detections[count].conf = conf;
-                    detections[count].cls_id = max_cls_id;
-                    count++;
+                    detections[count++] = d;
                 }
             }
         }
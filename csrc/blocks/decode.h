@@ -30,6 +30,8 @@ typedef struct YOLO_PACKED {
  * Layout: [anchor0_85, anchor1_85, anchor2_85] (channel-major).
  *
  * conf = obj_conf * max_cls_conf.
+ * 조기 탈락: objectness logit < logit(conf_threshold) → 클래스 루프 생략, 그다음 최대 클래스 logit 하나로
+ * conf 상한 확인 → 통과 anchor만 80클래스 sigmoid (결과는 전체 계산과 bit-identical).
  * xy = (sigmoid(xy)*2 + grid) * stride, grid = (x,y) - 0.5.
  * wh = (sigmoid(wh)*2)^2 * anchor (pixel).
  */
@@ -46,4 +48,14 @@ int32_t decode_nchw_f32(
     detection_t* detections,
     int32_t max_detections);
 
+/** objectness logit 컷: logit < 컷이면 그 anchor의 conf < conf_threshold 확정 (sigmoid 없이 비교).
+ *  컷을 쓸 수 없는 임계값이면 -INFINITY */
+float decode_obj_logit_cut(float conf_threshold);
+
+/** anchor 하나 decode. v[k * vs] = k번째 logit (x, y, w, h, obj, cls0..). (x, y) 격자 셀, anc_wh 앵커 (pixel).
+ *  conf >= conf_threshold면 *det 채우고 1, 아니면 0. decode_nchw_f32 / sparse Detect head 공용 */
+int32_t decode_anchor_f32(const float* v, int32_t vs, int32_t num_classes, float conf_threshold,
+                          int32_t x, int32_t y, float stride, const float anc_wh[2], int32_t input_size,
+                          detection_t* det);
+
 #endif /* DECODE_H */
@@ -1,8 +1,23 @@
 #include "detect.h"
+#include <math.h>
 #include "../operations/conv2d.h"
+#include "../operations/conv2d_1x1.h"
 #include "../utils/timing.h"
+#include "../utils/profiler.h"
+#include "../utils/roofline.h"
+
+static detect_head_mode_t s_head_mode = DETECT_HEAD_MODE_DEFAULT;
+
+void detect_set_head_mode(detect_head_mode_t mode) {
+    s_head_mode = mode;
+}
+
+detect_head_mode_t detect_get_head_mode(void) {
+    return s_head_mode;
+}
 
 void detect_nchw_f32(
+    int32_t n,
     const float* p3, int32_t p3_c, int32_t p3_h, int32_t p3_w,
     const float* p4, int32_t p4_c, int32_t p4_h, int32_t p4_w,
     const float* p5, int32_t p5_c, int32_t p5_h, int32_t p5_w,
@@ -11,33 +26,181 @@ void detect_nchw_f32(
     const void* m2_w, float m2_scale, int m2_is_int8, const float* m2_b,
     float* p3_out, float* p4_out, float* p5_out)
 {
+    prof_begin("Detect");
+    roofline_conv(n, p3_c, p3_h, p3_w, 255, 1, 1, p3_h, p3_w, m0_is_int8);
+    roofline_conv(n, p4_c, p4_h, p4_w, 255, 1, 1, p4_h, p4_w, m1_is_int8);
+    roofline_conv(n, p5_c, p5_h, p5_w, 255, 1, 1, p5_h, p5_w, m2_is_int8);
     yolo_timing_begin("detect");
     if (m0_is_int8) {
-        conv2d_nchw_f32_w8(p3, 1, p3_c, p3_h, p3_w,
+        conv2d_nchw_f32_w8(p3, n, p3_c, p3_h, p3_w,
             (const int8_t*)m0_w, m0_scale, 255, 1, 1, m0_b, 1, 1, 0, 0, 1,
             p3_out, p3_h, p3_w);
     } else {
-        conv2d_nchw_f32(p3, 1, p3_c, p3_h, p3_w,
+        conv2d_nchw_f32(p3, n, p3_c, p3_h, p3_w,
             (const float*)m0_w, 255, 1, 1, m0_b, 1, 1, 0, 0, 1,
             p3_out, p3_h, p3_w);
     }
     if (m1_is_int8) {
-        conv2d_nchw_f32_w8(p4, 1, p4_c, p4_h, p4_w,
+        conv2d_nchw_f32_w8(p4, n, p4_c, p4_h, p4_w,
             (const int8_t*)m1_w, m1_scale, 255, 1, 1, m1_b, 1, 1, 0, 0, 1,
             p4_out, p4_h, p4_w);
     } else {
-        conv2d_nchw_f32(p4, 1, p4_c, p4_h, p4_w,
+        conv2d_nchw_f32(p4, n, p4_c, p4_h, p4_w,
             (const float*)m1_w, 255, 1, 1, m1_b, 1, 1, 0, 0, 1,
             p4_out, p4_h, p4_w);
     }
     if (m2_is_int8) {
-        conv2d_nchw_f32_w8(p5, 1, p5_c, p5_h, p5_w,
+        conv2d_nchw_f32_w8(p5, n, p5_c, p5_h, p5_w,
             (const int8_t*)m2_w, m2_scale, 255, 1, 1, m2_b, 1, 1, 0, 0, 1,
             p5_out, p5_h, p5_w);
     } else {
-        conv2d_nchw_f32(p5, 1, p5_c, p5_h, p5_w,
+        conv2d_nchw_f32(p5, n, p5_c, p5_h, p5_w,
             (const float*)m2_w, 255, 1, 1, m2_b, 1, 1, 0, 0, 1,
             p5_out, p5_h, p5_w);
     }
     yolo_timing_end();
+    prof_end();
+}
+
+/* 내적 누적: 1x1 SIMD 커널과 같은 FMA (acc = bias부터 ic 순서) → dense head와 bit-identical */
+#if CONV2D_1X1_SIMD
+#define HEAD_FMA(a, b, acc) fmaf((a), (b), (acc))
+#else
+#define HEAD_FMA(a, b, acc) ((acc) + (a) * (b))
+#endif
+
+/* objectness 3채널 출력 [3][P], 가중치 행 [3][c_in] (+ SIMD 패널 [c_in][OCB]), 모은 입력 열 (BSS) */
+static float s_obj_buf[3 * DETECT_SPARSE_MAX_P];
+static float s_obj_w[3 * DETECT_SPARSE_MAX_C];
+#if CONV2D_1X1_SIMD
+static float s_obj_panel[DETECT_SPARSE_MAX_C * CONV2D_1X1_OCB];
+#endif
+static float s_col_buf[DETECT_SPARSE_MAX_C];
+
+#define HEAD_MAX_NO 85   /* anchor당 logit (COCO 80클래스) */
+
+/* 출력 채널 oc 하나의 1x1 conv 값 (입력 열 xc) */
+static float head_dot(const void* w, float scale, int is_int8, const float* b,
+                      int32_t oc, const float* xc, int32_t c_in)
+{
+    float acc = b ? b[oc] : 0.0f;
+    if (is_int8) {
+        const int8_t* wr = (const int8_t*)w + (size_t)oc * c_in;
+        for (int32_t ic = 0; ic < c_in; ic++) acc = HEAD_FMA((float)wr[ic] * scale, xc[ic], acc);
+    } else {
+        const float* wr = (const float*)w + (size_t)oc * c_in;
+        for (int32_t ic = 0; ic < c_in; ic++) acc = HEAD_FMA(wr[ic], xc[ic], acc);
+    }
+    return acc;
+}
+
+/* 1) objectness 채널 (a * no + 4) 3개만 전 셀 1x1 conv → s_obj_buf */
+static void head_obj_conv(const float* x, int32_t c_in, int32_t h, int32_t w,
+                          const void* wt, float scale, int is_int8, const float* b, int32_t no)
+{
+    float bias3[3];
+    for (int32_t a = 0; a < 3; a++) {
+        const int32_t oc = a * no + 4;
+        for (int32_t ic = 0; ic < c_in; ic++)
+            s_obj_w[a * c_in + ic] = is_int8 ? (float)((const int8_t*)wt)[(size_t)oc * c_in + ic] * scale
+                                             : ((const float*)wt)[(size_t)oc * c_in + ic];
+        bias3[a] = b ? b[oc] : 0.0f;
+    }
+#if CONV2D_1X1_SIMD
+    /* 3채널 = oc 블록 1개 (4번째 행 0) */
+    for (int32_t ic = 0; ic < c_in; ic++) {
+        for (int32_t i = 0; i < CONV2D_1X1_OCB; i++)
+            s_obj_panel[ic * CONV2D_1X1_OCB + i] = i < 3 ? s_obj_w[i * c_in + ic] : 0.0f;
+    }
+    conv2d_1x1_f32_packed(x, 1, c_in, h, w, s_obj_panel, 3, bias3, NULL, s_obj_buf,
+                          (size_t)c_in * h * w, (size_t)3 * h * w);
+#else
+    conv2d_nchw_f32(x, 1, c_in, h, w, s_obj_w, 3, 1, 1, bias3, 1, 1, 0, 0, 1, s_obj_buf, h, w);
+#endif
+}
+
+/* roofline: 통과 anchor의 나머지 (no-1) 채널 내적 + 모은 열 읽기, 나머지 가중치 행은 한 번 */
+static void head_sparse_roofline(int32_t c_in, int32_t no, int is_int8, int32_t n_col, int32_t n_anc) {
+    if (n_anc == 0) return;
+    const uint64_t rows = (uint64_t)(3 * no - 3);
+    roofline_add((uint64_t)n_anc * (uint64_t)(no - 1) * (uint64_t)c_in,
+                 rows * (uint64_t)c_in * (is_int8 ? 1u : 4u) + rows * sizeof(float),
+                 (uint64_t)n_col * (uint64_t)c_in * sizeof(float), 0);
+}
+
+int32_t detect_decode_sparse_nchw_f32(
+    const float* p3, int32_t p3_c, int32_t p3_h, int32_t p3_w,
+    const float* p4, int32_t p4_c, int32_t p4_h, int32_t p4_w,
+    const float* p5, int32_t p5_c, int32_t p5_h, int32_t p5_w,
+    const void* m0_w, float m0_scale, int m0_is_int8, const float* m0_b,
+    const void* m1_w, float m1_scale, int m1_is_int8, const float* m1_b,
+    const void* m2_w, float m2_scale, int m2_is_int8, const float* m2_b,
+    int32_t num_classes,
+    float conf_threshold,
+    int32_t input_size,
+    const float strides[3],
+    const float anchors[3][6],
+    detection_t* detections,
+    int32_t max_detections)
+{
+    const struct {
+        const float* x; int32_t c, h, w;
+        const void* wt; float scale; int is_int8; const float* b;
+    } sc[3] = {
+        { p3, p3_c, p3_h, p3_w, m0_w, m0_scale, m0_is_int8, m0_b },
+        { p4, p4_c, p4_h, p4_w, m1_w, m1_scale, m1_is_int8, m1_b },
+        { p5, p5_c, p5_h, p5_w, m2_w, m2_scale, m2_is_int8, m2_b },
+    };
+    const int32_t no = 5 + num_classes;
+    if (no > HEAD_MAX_NO) return -1;
+    for (int s = 0; s < 3; s++) {
+        if (sc[s].c > DETECT_SPARSE_MAX_C || sc[s].h * sc[s].w > DETECT_SPARSE_MAX_P) return -1;
+    }
+
+    const float obj_cut = decode_obj_logit_cut(conf_threshold);
+    int32_t count = 0;
+    prof_begin("Detect");
+    for (int s = 0; s < 3; s++) {
+        const int32_t c_in = sc[s].c, gw = sc[s].w, P = sc[s].h * sc[s].w;
+
+        yolo_timing_begin("detect");
+        roofline_conv(1, c_in, sc[s].h, gw, 3, 1, 1, sc[s].h, gw, sc[s].is_int8);
+        head_obj_conv(sc[s].x, c_in, sc[s].h, gw, sc[s].wt, sc[s].scale, sc[s].is_int8, sc[s].b, no);
+        yolo_timing_end();
+
+        /* 2) 컷 통과 (셀, anchor)만 나머지 채널 내적. 순서는 decode_nchw_f32와 같은 (y, x, anchor) */
+        yolo_timing_begin("decode");
+        int32_t n_col = 0, n_anc = 0;
+        for (int32_t p = 0; p < P; p++) {
+            int32_t col = 0;
+            for (int32_t a = 0; a < 3; a++) {
+                if (s_obj_buf[a * P + p] < obj_cut) continue;
+                if (!col) {
+                    for (int32_t ic = 0; ic < c_in; ic++) s_col_buf[ic] = sc[s].x[(size_t)ic * P + p];
+                    col = 1;
+                    n_col++;
+                }
+                n_anc++;
+                float v[HEAD_MAX_NO];
+                for (int32_t k = 0; k < no; k++) {
+                    v[k] = k == 4 ? s_obj_buf[a * P + p]
+                                  : head_dot(sc[s].wt, sc[s].scale, sc[s].is_int8, sc[s].b, a * no + k, s_col_buf, c_in);
+                }
+                detection_t d;
+                if (!decode_anchor_f32(v, 1, num_classes, conf_threshold, p % gw, p / gw, strides[s],
+                                       anchors[s] + a * 2, input_size, &d)) continue;
+                if (count >= max_detections) {
+                    head_sparse_roofline(c_in, no, sc[s].is_int8, n_col, n_anc);
+                    yolo_timing_end();
+                    prof_end();
+                    return count;
+                }
+                detections[count++] = d;
+            }
+        }
+        head_sparse_roofline(c_in, no, sc[s].is_int8, n_col, n_anc);
+        yolo_timing_end();
+    }
+    prof_end();
+    return count;
 }
@@ -2,9 +2,36 @@
 #define DETECT_H
 
 #include <stdint.h>
+#include "decode.h"
 
-/* W8A32: m0_w/m1_w/m2_w는 void*, scale/is_int8로 구분 */
+/* Detect head 실행 방식 (세션 create 시 읽음).
+ * DENSE: 255채널 전부 계산해 p3~p5에 쓰고 decode_nchw_f32 (golden 비교용)
+ * SPARSE: detect_decode_sparse_nchw_f32 — objectness 3채널만 전 셀, 나머지 82채널은 컷 통과 anchor만 */
+typedef enum {
+    DETECT_HEAD_DENSE = 0,
+    DETECT_HEAD_SPARSE = 1
+} detect_head_mode_t;
+
+/* 기본값: 호스트·BARE_METAL 모두 DENSE (p3~p5 golden 비교, 수치 불변). SPARSE는 명시 선택:
+ * 호스트 --head=sparse / detect_set_head_mode(), 보드 -DDETECT_HEAD_MODE_DEFAULT=DETECT_HEAD_SPARSE (DETECT_HEAD 9MB 영역·flush 생략) */
+#ifndef DETECT_HEAD_MODE_DEFAULT
+#define DETECT_HEAD_MODE_DEFAULT DETECT_HEAD_DENSE
+#endif
+
+/* sparse head 한도 (BSS): 입력 채널 수, 스케일당 셀 수 */
+#ifndef DETECT_SPARSE_MAX_C
+#define DETECT_SPARSE_MAX_C 512
+#endif
+#ifndef DETECT_SPARSE_MAX_P
+#define DETECT_SPARSE_MAX_P (80 * 80)
+#endif
+
+void detect_set_head_mode(detect_head_mode_t mode);
+detect_head_mode_t detect_get_head_mode(void);
+
+/* W8A32: m0_w/m1_w/m2_w는 void*, scale/is_int8로 구분. n = batch (p3..p5, 출력 모두 n장 연속) */
 void detect_nchw_f32(
+    int32_t n,
     const float* p3, int32_t p3_c, int32_t p3_h, int32_t p3_w,
     const float* p4, int32_t p4_c, int32_t p4_h, int32_t p4_w,
     const float* p5, int32_t p5_c, int32_t p5_h, int32_t p5_w,
@@ -13,4 +40,27 @@ void detect_nchw_f32(
     const void* m2_w, float m2_scale, int m2_is_int8, const float* m2_b,
     float* p3_out, float* p4_out, float* p5_out);
 
+/**
+ * Sparse Detect head + decode (이미지 1장). p3..p5 = head 입력 (L17/L20/L23), 출력 피처맵 없음.
+ * 1) 스케일마다 objectness 3채널만 1x1 conv (전 셀)
+ * 2) obj logit이 decode_obj_logit_cut을 넘는 (셀, anchor)만 입력 열을 모아 box 4 + 클래스 채널 내적 후
+ *    decode_anchor_f32. 검출 순서·형식은 detect_nchw_f32 + decode_nchw_f32와 같음
+ *    (1x1 SIMD 빌드는 누적 순서·FMA까지 같아 bit-identical).
+ * 반환: 검출 수, -1 미지원 (c_in > DETECT_SPARSE_MAX_C, h*w > DETECT_SPARSE_MAX_P)
+ */
+int32_t detect_decode_sparse_nchw_f32(
+    const float* p3, int32_t p3_c, int32_t p3_h, int32_t p3_w,
+    const float* p4, int32_t p4_c, int32_t p4_h, int32_t p4_w,
+    const float* p5, int32_t p5_c, int32_t p5_h, int32_t p5_w,
+    const void* m0_w, float m0_scale, int m0_is_int8, const float* m0_b,
+    const void* m1_w, float m1_scale, int m1_is_int8, const float* m1_b,
+    const void* m2_w, float m2_scale, int m2_is_int8, const float* m2_b,
+    int32_t num_classes,
+    float conf_threshold,
+    int32_t input_size,
+    const float strides[3],
+    const float anchors[3][6],
+    detection_t* detections,
+    int32_t max_detections);
+
 #endif /* DETECT_H */
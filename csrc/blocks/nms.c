@@ -97,3 +97,132 @@ int nms(
     yolo_timing_end();
     return 0;
 }
+
+/* ===== 후처리 엔진 ===== */
+
+#define NMS_ALIGN 16u
+
+static size_t nms_align(size_t x) {
+    return (x + NMS_ALIGN - 1u) & ~(size_t)(NMS_ALIGN - 1u);
+}
+
+/* scratch 배치: 정렬은 detection_t[n] 임시, NMS는 ord/tmp[n] + 모서리·면적 5×[n] + 비트마스크 2개 */
+static size_t nms_bits_words(int32_t n) {
+    return ((size_t)n + 31u) / 32u;
+}
+
+size_t nms_scratch_bytes(int32_t n) {
+    if (n <= 0) return 0;
+    const size_t sort_b = nms_align((size_t)n * sizeof(detection_t));
+    const size_t nms_b = 2u * nms_align((size_t)n * sizeof(int32_t)) + 5u * nms_align((size_t)n * sizeof(float)) +
+                         2u * nms_align(nms_bits_words(n) * sizeof(uint32_t));
+    return (sort_b > nms_b ? sort_b : nms_b) + NMS_ALIGN;
+}
+
+static uint8_t* nms_scratch_base(void* scratch) {
+    return (uint8_t*)(((uintptr_t)scratch + NMS_ALIGN - 1u) & ~(uintptr_t)(NMS_ALIGN - 1u));
+}
+
+void nms_sort_by_conf(detection_t* detections, int32_t n, void* scratch) {
+    if (!detections || n < 2 || !scratch) return;
+    /* bottom-up 병합: 오른쪽이 더 클 때만 먼저 → 안정 */
+    detection_t* a = detections;
+    detection_t* b = (detection_t*)nms_scratch_base(scratch);
+    for (int32_t width = 1; width < n; width *= 2) {
+        for (int32_t lo = 0; lo < n; lo += 2 * width) {
+            const int32_t mid = lo + width < n ? lo + width : n;
+            const int32_t hi = lo + 2 * width < n ? lo + 2 * width : n;
+            int32_t i = lo, j = mid, k = lo;
+            while (i < mid && j < hi) b[k++] = (a[j].conf > a[i].conf) ? a[j++] : a[i++];
+            while (i < mid) b[k++] = a[i++];
+            while (j < hi) b[k++] = a[j++];
+        }
+        detection_t* t = a; a = b; b = t;
+    }
+    if (a != detections) memcpy(detections, a, (size_t)n * sizeof(detection_t));
+}
+
+int32_t nms_sorted(
+    const detection_t* detections, int32_t n,
+    float iou_threshold,
+    detection_t* out, int32_t max_out,
+    void* scratch, size_t scratch_bytes)
+{
+    if (n < 0 || (n > 0 && (!detections || !out || !scratch || scratch_bytes < nms_scratch_bytes(n)))) return -1;
+    if (n == 0 || max_out <= 0) return 0;
+    yolo_timing_begin("nms");
+
+    uint8_t* p = nms_scratch_base(scratch);
+    int32_t* ord = (int32_t*)p;  p += nms_align((size_t)n * sizeof(int32_t));
+    int32_t* tmp = (int32_t*)p;  p += nms_align((size_t)n * sizeof(int32_t));
+    float* x1 = (float*)p;       p += nms_align((size_t)n * sizeof(float));
+    float* y1 = (float*)p;       p += nms_align((size_t)n * sizeof(float));
+    float* x2 = (float*)p;       p += nms_align((size_t)n * sizeof(float));
+    float* y2 = (float*)p;       p += nms_align((size_t)n * sizeof(float));
+    float* area = (float*)p;     p += nms_align((size_t)n * sizeof(float));
+    const size_t words = nms_bits_words(n);
+    uint32_t* keep = (uint32_t*)p; p += nms_align(words * sizeof(uint32_t));
+    uint32_t* sup = (uint32_t*)p;
+    memset(keep, 0, words * sizeof(uint32_t));
+    memset(sup, 0, words * sizeof(uint32_t));
+
+    /* 모서리·면적 1회 (calculate_iou와 같은 식) */
+    for (int32_t i = 0; i < n; i++) {
+        const detection_t* d = &detections[i];
+        x1[i] = d->x - d->w / 2.0f;
+        y1[i] = d->y - d->h / 2.0f;
+        x2[i] = d->x + d->w / 2.0f;
+        y2[i] = d->y + d->h / 2.0f;
+        area[i] = (x2[i] - x1[i]) * (y2[i] - y1[i]);
+        ord[i] = i;
+    }
+    /* cls_id 기준 안정 병합 정렬 → 클래스 bucket 안에서 conf 순서 유지 */
+    for (int32_t width = 1; width < n; width *= 2) {
+        for (int32_t lo = 0; lo < n; lo += 2 * width) {
+            const int32_t mid = lo + width < n ? lo + width : n;
+            const int32_t hi = lo + 2 * width < n ? lo + 2 * width : n;
+            int32_t i = lo, j = mid, k = lo;
+            while (i < mid && j < hi)
+                tmp[k++] = detections[ord[j]].cls_id < detections[ord[i]].cls_id ? ord[j++] : ord[i++];
+            while (i < mid) tmp[k++] = ord[i++];
+            while (j < hi) tmp[k++] = ord[j++];
+        }
+        int32_t* t = ord; ord = tmp; tmp = t;
+    }
+
+    /* bucket마다 greedy: 전역 greedy와 같은 유지 집합 (다른 클래스끼리는 서로 제거하지 않음).
+     * sup 비트는 ord 위치 기준 */
+    for (int32_t b0 = 0; b0 < n; ) {
+        const int32_t cls = detections[ord[b0]].cls_id;
+        int32_t b1 = b0 + 1;
+        while (b1 < n && detections[ord[b1]].cls_id == cls) b1++;
+        for (int32_t pi = b0; pi < b1; pi++) {
+            if (sup[pi >> 5] & (1u << (pi & 31))) continue;
+            const int32_t i = ord[pi];
+            keep[i >> 5] |= 1u << (i & 31);
+            const float ax1 = x1[i], ay1 = y1[i], ax2 = x2[i], ay2 = y2[i], aa = area[i];
+            for (int32_t pj = pi + 1; pj < b1; pj++) {
+                if (sup[pj >> 5] & (1u << (pj & 31))) continue;
+                const int32_t j = ord[pj];
+                const float ix1 = fmaxf(ax1, x1[j]), iy1 = fmaxf(ay1, y1[j]);
+                const float ix2 = fminf(ax2, x2[j]), iy2 = fminf(ay2, y2[j]);
+                float iou = 0.0f;
+                if (!(ix2 < ix1 || iy2 < iy1)) {
+                    const float inter = (ix2 - ix1) * (iy2 - iy1);
+                    const float uni = aa + area[j] - inter;
+                    if (!(uni <= 0.0f)) iou = inter / uni;
+                }
+                if (iou > iou_threshold) sup[pj >> 5] |= 1u << (pj & 31);
+            }
+        }
+        b0 = b1;
+    }
+
+    /* nms()는 유지 개수가 max에 닿으면 멈춤 = 입력 순서상 앞의 max_out개 */
+    int32_t count = 0;
+    for (int32_t i = 0; i < n && count < max_out; i++) {
+        if (keep[i >> 5] & (1u << (i & 31))) out[count++] = detections[i];
+    }
+    yolo_timing_end();
+    return count;
+}
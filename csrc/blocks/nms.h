@@ -1,6 +1,7 @@
 #ifndef NMS_H
 #define NMS_H
 
+#include <stddef.h>
 #include <stdint.h>
 #include "decode.h"
 
@@ -14,4 +15,22 @@ int nms(
     float iou_threshold,               // IoU 임계값 (일반적으로 0.45)
     int32_t max_detections);           // 최대 detection 개수
 
+/* 후처리 엔진: 할당 없이 호출자 scratch 사용.
+ * 정렬 O(n log n) (병합), NMS는 클래스 bucket (cls_id 안정 정렬) 안에서만 비교,
+ * 모서리/면적은 1회 계산 (SoA), 제거 여부는 비트마스크 */
+
+/** nms_sort_by_conf / nms_sorted 공용 scratch 바이트 (검출 n개) */
+size_t nms_scratch_bytes(int32_t n);
+
+/** conf 내림차순 안정 정렬 (같은 conf는 입력 순서 유지). scratch >= nms_scratch_bytes(n) */
+void nms_sort_by_conf(detection_t* detections, int32_t n, void* scratch);
+
+/** conf 내림차순 입력에 클래스별 NMS. 결과는 nms()와 같음 (유지 검출을 입력 순서로, 최대 max_out개).
+ *  반환: out 개수, -1 인자 오류 (scratch 부족 포함) */
+int32_t nms_sorted(
+    const detection_t* detections, int32_t n,
+    float iou_threshold,
+    detection_t* out, int32_t max_out,
+    void* scratch, size_t scratch_bytes);
+
 #endif // NMS_H
@@ -1,80 +1,55 @@
 #include "sppf.h"
 #include "../operations/conv2d.h"
-#include "../operations/silu.h"
 #include "../operations/maxpool2d.h"
-#include "../operations/concat.h"
 #include "../utils/feature_pool.h"
 #include "../utils/timing.h"
+#include "../utils/profiler.h"
+#include "../utils/roofline.h"
+
+size_t sppf_scratch_bytes(int32_t n, int32_t cv1_c_out, int32_t h, int32_t w) {
+    return (size_t)n * (size_t)(4 * cv1_c_out) * (size_t)h * (size_t)w * sizeof(float);
+}
 
 void sppf_nchw_f32(
     const float* x, int32_t n, int32_t c_in, int32_t h, int32_t w,
     const void* cv1_w, float cv1_scale, int cv1_is_int8, int32_t cv1_c_out, const float* cv1_bias,
     const void* cv2_w, float cv2_scale, int cv2_is_int8, int32_t cv2_c_out, const float* cv2_bias,
     int32_t pool_k,
-    float* y)
+    float* y, float* scratch)
 {
-    const int32_t pad = pool_k / 2;
-
-    size_t x1_bytes = (size_t)n * (size_t)cv1_c_out * (size_t)h * (size_t)w * sizeof(float);
-    size_t cat_bytes = (size_t)n * (size_t)(4 * cv1_c_out) * (size_t)h * (size_t)w * sizeof(float);
-
-    float* x1 = (float*)feature_pool_alloc(x1_bytes);
-    float* y1 = (float*)feature_pool_alloc(x1_bytes);
-    float* y2 = (float*)feature_pool_alloc(x1_bytes);
-    float* y3 = (float*)feature_pool_alloc(x1_bytes);
-    float* cat = (float*)feature_pool_alloc(cat_bytes);
+    const size_t plane = (size_t)cv1_c_out * (size_t)h * (size_t)w;  /* 이미지 1장 x1 */
+    const size_t img_stride = 4 * plane;                             /* concat 1장 */
 
-    if (!x1 || !y1 || !y2 || !y3 || !cat) {
-        if (cat) feature_pool_free(cat);
-        if (y3) feature_pool_free(y3);
-        if (y2) feature_pool_free(y2);
-        if (y1) feature_pool_free(y1);
-        if (x1) feature_pool_free(x1);
-        return;
+    float* owned = NULL;
+    if (!scratch) {
+        owned = (float*)feature_pool_alloc(sppf_scratch_bytes(n, cv1_c_out, h, w));
+        if (!owned) return;
+        scratch = owned;
     }
+    /* concat [x1 | y1 | y2 | y3]: cv1/maxpool이 채널 구간에 바로 출력 → concat 복사 없음.
+       구간은 이미지마다 img_stride 간격 (cv1은 batch 전체 한 번 호출) */
+    float* cat = scratch;
+    const conv2d_epilogue_t ep = { 1, NULL, 0 };
+    prof_begin("SPPF");
+    roofline_conv(n, c_in, h, w, cv1_c_out, 1, 1, h, w, cv1_is_int8);
+    roofline_add(0, 0, (uint64_t)n * plane * sizeof(float), 3u * (uint64_t)n * plane * sizeof(float));
+    roofline_conv(n, 4 * cv1_c_out, h, w, cv2_c_out, 1, 1, h, w, cv2_is_int8);
     yolo_timing_begin("cv1");
-    if (cv1_is_int8 && cv1_w) {
-        conv2d_nchw_f32_w8(x, n, c_in, h, w,
-                           (const int8_t*)cv1_w, cv1_scale, cv1_c_out, 1, 1,
-                           cv1_bias, 1, 1, 0, 0, 1,
-                           x1, h, w);
-    } else if (cv1_w) {
-        conv2d_nchw_f32(x, n, c_in, h, w,
-                        (const float*)cv1_w, cv1_c_out, 1, 1,
-                        cv1_bias, 1, 1, 0, 0, 1,
-                        x1, h, w);
-    }
-    silu_nchw_f32(x1, n, cv1_c_out, h, w, x1);
+    conv2d_fused_slice_nchw_f32(x, 0, n, c_in, h, w, cv1_w, cv1_scale, cv1_is_int8, cv1_c_out, 1, 1,
+                                cv1_bias, 1, 1, 0, 0, &ep, cat, 4 * cv1_c_out, h, w);
     yolo_timing_end();
 
+    /* y1/y2/y3를 plane마다 한 번에 (캐시에 있는 동안 3단), concat 구간에 직접 */
     yolo_timing_begin("maxpool");
-    maxpool2d_nchw_f32(x1, n, cv1_c_out, h, w, pool_k, 1, pad, y1, h, w);
-    maxpool2d_nchw_f32(y1, n, cv1_c_out, h, w, pool_k, 1, pad, y2, h, w);
-    maxpool2d_nchw_f32(y2, n, cv1_c_out, h, w, pool_k, 1, pad, y3, h, w);
+    maxpool2d_sppf_nchw_f32(cat, n, cv1_c_out, h, w, pool_k, cat + plane, cat + 2 * plane, cat + 3 * plane,
+                            img_stride);
     yolo_timing_end();
 
-    yolo_timing_begin("concat");
-    concat4_nchw_f32(x1, cv1_c_out, y1, cv1_c_out, y2, cv1_c_out, y3, cv1_c_out,
-                     n, h, w, cat);
-    yolo_timing_end();
     yolo_timing_begin("cv2");
-    if (cv2_is_int8 && cv2_w) {
-        conv2d_nchw_f32_w8(cat, n, 4 * cv1_c_out, h, w,
-                           (const int8_t*)cv2_w, cv2_scale, cv2_c_out, 1, 1,
-                           cv2_bias, 1, 1, 0, 0, 1,
-                           y, h, w);
-    } else if (cv2_w) {
-        conv2d_nchw_f32(cat, n, 4 * cv1_c_out, h, w,
-                        (const float*)cv2_w, cv2_c_out, 1, 1,
-                        cv2_bias, 1, 1, 0, 0, 1,
-                        y, h, w);
-    }
-    silu_nchw_f32(y, n, cv2_c_out, h, w, y);
+    conv2d_fused_nchw_f32(cat, n, 4 * cv1_c_out, h, w, cv2_w, cv2_scale, cv2_is_int8, cv2_c_out, 1, 1,
+                          cv2_bias, 1, 1, 0, 0, &ep, y, h, w);
     yolo_timing_end();
+    prof_end();
 
-    feature_pool_free(cat);
-    feature_pool_free(y3);
-    feature_pool_free(y2);
-    feature_pool_free(y1);
-    feature_pool_free(x1);
+    if (owned) feature_pool_free(owned);
 }
@@ -2,13 +2,17 @@
 #define SPPF_H
 
 #include <stdint.h>
+#include <stddef.h>
 
-/* W8A32: cv1/cv2 weights via (ptr, scale, is_int8) */
+/* 내부 scratch 크기 (바이트): concat [x1 | y1 | y2 | y3] (cv1·maxpool이 채널 구간에 바로 출력) */
+size_t sppf_scratch_bytes(int32_t n, int32_t cv1_c_out, int32_t h, int32_t w);
+
+/* W8A32: cv1/cv2 weights via (ptr, scale, is_int8). scratch: sppf_scratch_bytes 이상, NULL이면 feature_pool */
 void sppf_nchw_f32(
     const float* x, int32_t n, int32_t c_in, int32_t h, int32_t w,
     const void* cv1_w, float cv1_scale, int cv1_is_int8, int32_t cv1_c_out, const float* cv1_bias,
     const void* cv2_w, float cv2_scale, int cv2_is_int8, int32_t cv2_c_out, const float* cv2_bias,
     int32_t pool_k,
-    float* y);
+    float* y, float* scratch);
 
 #endif // SPPF_H
@@ -3,12 +3,19 @@
 
 #include <stdint.h>
 
-/* W8A32: cv1_w/cv2_w는 void* (float* 또는 int8_t*), scale/is_int8로 구분 */
+#include <stddef.h>
+
+/* 내부 cv1 출력 scratch 크기 (바이트). cv2는 SiLU·residual epilogue로 y에 바로 씀 */
+size_t bottleneck_scratch_bytes(int32_t n, int32_t cv1_c_out, int32_t cv2_c_out, int32_t h, int32_t w);
+
+/* W8A32: cv1_w/cv2_w는 void* (float* 또는 int8_t*), scale/is_int8로 구분.
+ * x / y는 c_total 채널 텐서의 앞 c 채널 (C3 concat 버퍼, <= 0이면 밀집): batch 전체를 호출 한 번으로.
+ * scratch: bottleneck_scratch_bytes 이상 (NULL이면 feature_pool에서 할당) */
 void bottleneck_nchw_f32(
-    const float* x, int32_t n, int32_t c, int32_t h, int32_t w,
+    const float* x, int32_t c_total, int32_t n, int32_t c, int32_t h, int32_t w,
     const void* cv1_w, float cv1_scale, int cv1_is_int8, int32_t cv1_c_out, const float* cv1_bias,
     const void* cv2_w, float cv2_scale, int cv2_is_int8, int32_t cv2_c_out, const float* cv2_bias,
     int32_t shortcut,  // 1=add residual, 0=no shortcut
-    float* y);
+    float* y, float* scratch);
 
 #endif // BOTTLENECK_H
@@ -1,4 +1,33 @@
 #include "concat.h"
+#include "../utils/thread_pool.h"
+#include <stddef.h>
+
+/* item = (ni, 출력 채널) plane 복사. 입력 최대 4개 */
+typedef struct {
+    const float* src[4];
+    int32_t c[4];
+    int32_t n_src, c_total, hw;
+    float* y;
+} concat_args_t;
+
+static void concat_range(void* ctx, int32_t it0, int32_t it1, int32_t tid)
+{
+    const concat_args_t* g = (const concat_args_t*)ctx;
+    const int32_t hw = g->hw;
+    (void)tid;
+
+    for (int32_t it = it0; it < it1; it++) {
+        const int32_t ni = it / g->c_total;
+        int32_t ci = it % g->c_total;
+        int32_t s = 0;
+        while (ci >= g->c[s]) ci -= g->c[s++];
+        const float* src = g->src[s] + ((size_t)ni * g->c[s] + ci) * hw;
+        float* dst = g->y + (size_t)it * hw;
+        for (int32_t i = 0; i < hw; i++) {
+            dst[i] = src[i];
+        }
+    }
+}
 
 void concat_nchw_f32(
     const float* x1, int32_t c1,
@@ -6,26 +35,8 @@ void concat_nchw_f32(
     int32_t n, int32_t h, int32_t w,
     float* y)
 {
-    const int32_t hw = h * w;
-    
-    for (int32_t ni = 0; ni < n; ni++) {
-        // x1 채널들 복사
-        for (int32_t ci = 0; ci < c1; ci++) {
-            const int32_t src_base = ((ni * c1 + ci) * h) * w;
-            const int32_t dst_base = ((ni * (c1 + c2) + ci) * h) * w;
-            for (int32_t i = 0; i < hw; i++) {
-                y[dst_base + i] = x1[src_base + i];
-            }
-        }
-        // x2 채널들 복사
-        for (int32_t ci = 0; ci < c2; ci++) {
-            const int32_t src_base = ((ni * c2 + ci) * h) * w;
-            const int32_t dst_base = ((ni * (c1 + c2) + (c1 + ci)) * h) * w;
-            for (int32_t i = 0; i < hw; i++) {
-                y[dst_base + i] = x2[src_base + i];
-            }
-        }
-    }
+    concat_args_t g = { { x1, x2, NULL, NULL }, { c1, c2, 0, 0 }, 2, c1 + c2, h * w, y };
+    thread_pool_run(n * g.c_total, concat_range, &g);
 }
 
 void concat4_nchw_f32(
@@ -36,32 +47,6 @@ void concat4_nchw_f32(
     int32_t n, int32_t h, int32_t w,
     float* y)
 {
-    const int32_t hw = h * w;
-    const int32_t c01 = c0 + c1;
-    const int32_t c012 = c01 + c2;
-    const int32_t c0123 = c012 + c3;
-
-    for (int32_t ni = 0; ni < n; ni++) {
-        // x0
-        for (int32_t ci = 0; ci < c0; ci++) {
-            const int32_t src = ((ni * c0 + ci) * h) * w;
-            const int32_t dst = ((ni * c0123 + ci) * h) * w;
-            for (int32_t i = 0; i < hw; i++) y[dst + i] = x0[src + i];
-        }
-        for (int32_t ci = 0; ci < c1; ci++) {
-            const int32_t src = ((ni * c1 + ci) * h) * w;
-            const int32_t dst = ((ni * c0123 + (c0 + ci)) * h) * w;
-            for (int32_t i = 0; i < hw; i++) y[dst + i] = x1[src + i];
-        }
-        for (int32_t ci = 0; ci < c2; ci++) {
-            const int32_t src = ((ni * c2 + ci) * h) * w;
-            const int32_t dst = ((ni * c0123 + (c01 + ci)) * h) * w;
-            for (int32_t i = 0; i < hw; i++) y[dst + i] = x2[src + i];
-        }
-        for (int32_t ci = 0; ci < c3; ci++) {
-            const int32_t src = ((ni * c3 + ci) * h) * w;
-            const int32_t dst = ((ni * c0123 + (c012 + ci)) * h) * w;
-            for (int32_t i = 0; i < hw; i++) y[dst + i] = x3[src + i];
-        }
-    }
+    concat_args_t g = { { x0, x1, x2, x3 }, { c0, c1, c2, c3 }, 4, c0 + c1 + c2 + c3, h * w, y };
+    thread_pool_run(n * g.c_total, concat_range, &g);
 }
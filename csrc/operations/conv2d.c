@@ -1,40 +1,62 @@
 #include "conv2d.h"
+#include "conv2d_1x1.h"
+#include "conv2d_gemm.h"
+#include "conv2d_stem.h"
+#include "conv2d_tune.h"
+#include "conv2d_winograd.h"
+#include "weight_pack.h"
+#include "../utils/thread_pool.h"
 #include <stdint.h>
+#include <stdlib.h>
 
 /* conv2d 최적화 포인트:
- * - 출력 타일링 (기본 8x8)
+ * - 출력 타일링 (기본 8x8 × oc 32, shape별 plan은 conv2d_tune)
  * - safe 영역/경계 분리 (경계만 bounds 체크)
  * - 정적 acc 버퍼(BSS) 사용 (bare-metal 스택 절약) */
-#ifndef CONV2D_TILE_H
-#define CONV2D_TILE_H 8
-#endif
-#ifndef CONV2D_TILE_W
-#define CONV2D_TILE_W 8
-#endif
-/* 출력 채널 블록(기본 32) */
-#ifndef CONV2D_OC_BLOCK
-#define CONV2D_OC_BLOCK 32
-#endif
 
-/* 누적 버퍼: 스택 대신 BSS */
-static float conv2d_acc_buf[CONV2D_TILE_H][CONV2D_TILE_W][CONV2D_OC_BLOCK];
+/* 누적 버퍼: 스택 대신 BSS, 스레드별 1개 (thread_pool tid). [타일 픽셀 dh*tile_w+dw][oc] */
+static float conv2d_acc_buf[YOLO_MAX_THREADS][CONV2D_TILE_MAX_PIX][CONV2D_OC_BLOCK];
 
-void conv2d_nchw_f32(
-    const float* x, int32_t n, int32_t c_in, int32_t h_in, int32_t w_in,
-    const float* w, int32_t c_out, int32_t k_h, int32_t k_w,
-    const float* bias_or_null,
-    int32_t stride_h, int32_t stride_w,
-    int32_t pad_h, int32_t pad_w,
-    int32_t groups,
-    float* y, int32_t h_out, int32_t w_out)
+/* direct 커널 인자 (thread_pool 작업 ctx). item = (ni, oh0, ow0, oc0) 타일, 루프 순서대로 번호 */
+typedef struct {
+    const float* x; int32_t n, c_in, h_in, w_in;
+    const void* w; int32_t w_b_stride, w_ic_stride; float scale;
+    int32_t c_out, k_h, k_w;
+    const float* bias_or_null;
+    int32_t stride_h, stride_w, pad_h, pad_w;
+    float* y; int32_t h_out, w_out;
+    const conv2d_epilogue_t* ep;
+    int32_t tile_h, tile_w, oc_block;   /* conv2d_tune_get (oc_block은 CONV2D_OC_BLOCK의 약수) */
+} direct_args_t;
+
+/* 가중치 배치: w_b_stride = oc 블록 안 oc 간격, w_ic_stride = ic 간격.
+ * OIHW: (c_in*kh*kw, kh*kw), weight_pack blocked [oc/OCB][ic][OCB][kh*kw]: (kh*kw, OCB*kh*kw).
+ * oc0의 시작 오프셋 = 배치 블록 시작 + 블록 안 위치 (OIHW면 oc0*c_in*kh*kw와 같음).
+ * 런타임 oc_block은 OCB의 약수라 한 oc 블록이 배치 블록 경계를 넘지 않음 */
+static size_t direct_w_offset(int32_t oc0, int32_t w_oc_stride, int32_t w_b_stride) {
+    return (size_t)(oc0 / CONV2D_OC_BLOCK) * CONV2D_OC_BLOCK * (size_t)w_oc_stride +
+           (size_t)(oc0 % CONV2D_OC_BLOCK) * (size_t)w_b_stride;
+}
+
+static void direct_f32_range(void* ctx, int32_t it0, int32_t it1, int32_t tid)
 {
-    if (groups != 1) {
-        return;
-    }
+    const direct_args_t* a = (const direct_args_t*)ctx;
+    const float* x = a->x;
+    const int32_t n = a->n, c_in = a->c_in, h_in = a->h_in, w_in = a->w_in;
+    const float* w = (const float*)a->w;
+    const int32_t w_b_stride = a->w_b_stride, w_ic_stride = a->w_ic_stride;
+    const int32_t c_out = a->c_out, k_h = a->k_h, k_w = a->k_w;
+    const float* bias_or_null = a->bias_or_null;
+    const int32_t stride_h = a->stride_h, stride_w = a->stride_w, pad_h = a->pad_h, pad_w = a->pad_w;
+    float* y = a->y;
+    const int32_t h_out = a->h_out, w_out = a->w_out;
+    const conv2d_epilogue_t* ep = a->ep;
+    float (*acc)[CONV2D_OC_BLOCK] = conv2d_acc_buf[tid];
+    int32_t it = 0;  /* 타일 번호 (ni→oh0→ow0→oc0 순서) */
 
-    const int32_t tile_h = CONV2D_TILE_H;
-    const int32_t tile_w = CONV2D_TILE_W;
-    const int32_t oc_block = CONV2D_OC_BLOCK;
+    const int32_t tile_h = a->tile_h;
+    const int32_t tile_w = a->tile_w;
+    const int32_t oc_block = a->oc_block;
 
     /* 패딩이 필요 없는 안전 영역 (경계 분기 최소화) */
     const int32_t safe_oh_min = (pad_h + stride_h - 1) / stride_h;
@@ -45,9 +67,56 @@ void conv2d_nchw_f32(
     const int32_t x_h_stride = w_in;
     const int32_t x_c_stride = h_in * w_in;
     const int32_t w_k_stride = k_w;
-    const int32_t w_ic_stride = k_h * k_w;
     const int32_t w_oc_stride = c_in * k_h * k_w;
 
+    /* 1x1 fast path: 픽셀마다 OCB개 가중치를 읽음 (blocked 배치면 연속) */
+    if (k_h == 1 && k_w == 1) {
+        for (int32_t ni = 0; ni < n; ni++) {
+            for (int32_t oh0 = 0; oh0 < h_out; oh0 += tile_h) {
+                const int32_t oh_end = oh0 + tile_h < h_out ? oh0 + tile_h : h_out;
+                const int32_t th = oh_end - oh0;
+                for (int32_t ow0 = 0; ow0 < w_out; ow0 += tile_w) {
+                    const int32_t ow_end = ow0 + tile_w < w_out ? ow0 + tile_w : w_out;
+                    const int32_t tw = ow_end - ow0;
+                    for (int32_t oc0 = 0; oc0 < c_out; oc0 += oc_block) {
+                        const int32_t item = it++;
+                        if (item < it0 || item >= it1) continue;  /* 다른 스레드 몫 */
+                        const int32_t n_oc = oc0 + oc_block <= c_out ? oc_block : c_out - oc0;
+                        const size_t w_oc0 = direct_w_offset(oc0, w_oc_stride, w_b_stride);
+                        for (int32_t dh = 0; dh < th; dh++) {
+                            for (int32_t dw = 0; dw < tw; dw++) {
+                                for (int32_t b = 0; b < n_oc; b++)
+                                    acc[dh * tile_w + dw][b] = bias_or_null ? bias_or_null[oc0 + b] : 0.0f;
+                            }
+                        }
+                        for (int32_t ic = 0; ic < c_in; ic++) {
+                            const float* x_ch = x + (ni * c_in + ic) * x_c_stride;
+                            for (int32_t dh = 0; dh < th; dh++) {
+                                const int32_t oh = oh0 + dh;
+                                for (int32_t dw = 0; dw < tw; dw++) {
+                                    const int32_t ow = ow0 + dw;
+                                    float x_val = x_ch[oh * x_h_stride + ow];
+                                    for (int32_t b = 0; b < n_oc; b++)
+                                        acc[dh * tile_w + dw][b] += x_val * w[w_oc0 + b * w_b_stride + ic * w_ic_stride];
+                                }
+                            }
+                        }
+                        for (int32_t dh = 0; dh < th; dh++) {
+                            const int32_t oh = oh0 + dh;
+                            for (int32_t dw = 0; dw < tw; dw++) {
+                                const int32_t ow = ow0 + dw;
+                                const int32_t y_off = (ni * c_out + oc0) * h_out * w_out + oh * w_out + ow;
+                                for (int32_t b = 0; b < n_oc; b++)
+                                    y[y_off + b * h_out * w_out] = conv2d_epilogue_apply(ep, acc[dh * tile_w + dw][b], (size_t)(y_off + b * h_out * w_out));
+                            }
+                        }
+                    }
+                }
+            }
+        }
+        return;
+    }
+
     for (int32_t ni = 0; ni < n; ni++) {
         for (int32_t oh0 = 0; oh0 < h_out; oh0 += tile_h) {
             const int32_t oh_end = oh0 + tile_h < h_out ? oh0 + tile_h : h_out;
@@ -57,13 +126,16 @@ void conv2d_nchw_f32(
                 const int32_t tw = ow_end - ow0;
 
                 for (int32_t oc0 = 0; oc0 < c_out; oc0 += oc_block) {
+                    const int32_t item = it++;
+                    if (item < it0 || item >= it1) continue;  /* 다른 스레드 몫 */
                     const int32_t n_oc = oc0 + oc_block <= c_out ? oc_block : c_out - oc0;
+                    const size_t w_oc0 = direct_w_offset(oc0, w_oc_stride, w_b_stride);
 
                     /* 누적 버퍼 초기화: bias 또는 0 */
                     for (int32_t dh = 0; dh < th; dh++) {
                         for (int32_t dw = 0; dw < tw; dw++) {
                             for (int32_t b = 0; b < n_oc; b++) {
-                                conv2d_acc_buf[dh][dw][b] = bias_or_null ? bias_or_null[oc0 + b] : 0.0f;
+                                acc[dh * tile_w + dw][b] = bias_or_null ? bias_or_null[oc0 + b] : 0.0f;
                             }
                         }
                     }
@@ -75,7 +147,7 @@ void conv2d_nchw_f32(
                     /* ic → b → dh → dw 순서: 필터(w) 하나를 한 번 로드해 타일 전체(64픽셀)에 재사용 */
                     for (int32_t ic = 0; ic < c_in; ic++) {
                         for (int32_t b = 0; b < n_oc; b++) {
-                            const float* w_base = w + (oc0 + b) * w_oc_stride + ic * w_ic_stride;
+                            const float* w_base = w + w_oc0 + b * w_b_stride + ic * w_ic_stride;
 
                             if (tile_is_safe) {
                                 /* Fast path: 타일 전체가 safe → per-pixel 분기 없음 */
@@ -94,7 +166,7 @@ void conv2d_nchw_f32(
                                                 contrib += (*x_row++) * (*w_row++);
                                             }
                                         }
-                                        float* acc_ptr = &conv2d_acc_buf[dh][dw][0];
+                                        float* acc_ptr = &acc[dh * tile_w + dw][0];
                                         acc_ptr[b] += contrib;
                                     }
                                 }
@@ -120,7 +192,6 @@ void conv2d_nchw_f32(
                                                 }
                                             }
                                         } else {
-                                            const int32_t oc = oc0 + b;
                                             contrib = 0.0f;
                                             for (int32_t kh = 0; kh < k_h; kh++) {
                                                 const int32_t ih = oh * stride_h - pad_h + kh;
@@ -129,12 +200,12 @@ void conv2d_nchw_f32(
                                                     const int32_t iw = ow * stride_w - pad_w + kw;
                                                     if ((uint32_t)iw >= (uint32_t)w_in) continue;
                                                     const float* x_ptr = x + (ni * c_in + ic) * x_c_stride + ih * x_h_stride + iw;
-                                                    const float* w_ptr = w + oc * w_oc_stride + ic * w_ic_stride + kh * w_k_stride + kw;
+                                                    const float* w_ptr = w_base + kh * w_k_stride + kw;
                                                     contrib += (*x_ptr) * (*w_ptr);
                                                 }
                                             }
                                         }
-                                        float* acc_ptr = &conv2d_acc_buf[dh][dw][0];
+                                        float* acc_ptr = &acc[dh * tile_w + dw][0];
                                         acc_ptr[b] += contrib;
                                     }
                                 }
@@ -142,14 +213,14 @@ void conv2d_nchw_f32(
                         }
                     }
 
-                    /* 누적 버퍼 → y 쓰기 */
+                    /* 누적 버퍼 → y 쓰기 (epilogue: SiLU/residual) */
                     for (int32_t dh = 0; dh < th; dh++) {
                         const int32_t oh = oh0 + dh;
                         for (int32_t dw = 0; dw < tw; dw++) {
                             const int32_t ow = ow0 + dw;
                             const int32_t y_row_off = (ni * c_out + oc0) * h_out * w_out + oh * w_out + ow;
                             for (int32_t b = 0; b < n_oc; b++) {
-                                y[y_row_off + b * h_out * w_out] = conv2d_acc_buf[dh][dw][b];
+                                y[y_row_off + b * h_out * w_out] = conv2d_epilogue_apply(ep, acc[dh * tile_w + dw][b], (size_t)(y_row_off + b * h_out * w_out));
                             }
                         }
                     }
@@ -159,21 +230,76 @@ void conv2d_nchw_f32(
     }
 }
 
-/* W8A32: INT8 weights (per-tensor scale), FP32 compute */
-void conv2d_nchw_f32_w8(
+/* 레이어 shape의 블로킹 plan (없으면 컴파일 기본값) */
+static void direct_set_blocking(direct_args_t* a) {
+    const conv2d_shape_t s = { (int16_t)a->c_in, (int16_t)a->c_out, (int16_t)a->k_h, (int16_t)a->k_w,
+                               (int16_t)a->stride_h, (int16_t)a->stride_w, (int16_t)a->h_out, (int16_t)a->w_out };
+    const conv2d_blocking_t b = conv2d_tune_get(&s);
+    a->tile_h = b.tile_h;
+    a->tile_w = b.tile_w;
+    a->oc_block = b.oc_block;
+}
+
+static int32_t direct_num_items(const direct_args_t* a) {
+    const int32_t tiles_h = (a->h_out + a->tile_h - 1) / a->tile_h;
+    const int32_t tiles_w = (a->w_out + a->tile_w - 1) / a->tile_w;
+    const int32_t oc_blks = (a->c_out + a->oc_block - 1) / a->oc_block;
+    return a->n * tiles_h * tiles_w * oc_blks;
+}
+
+static void direct_f32_impl(
     const float* x, int32_t n, int32_t c_in, int32_t h_in, int32_t w_in,
-    const int8_t* w, float scale, int32_t c_out, int32_t k_h, int32_t k_w,
+    const float* w, int32_t w_b_stride, int32_t w_ic_stride,
+    int32_t c_out, int32_t k_h, int32_t k_w,
+    const float* bias_or_null,
+    int32_t stride_h, int32_t stride_w,
+    int32_t pad_h, int32_t pad_w,
+    float* y, int32_t h_out, int32_t w_out, const conv2d_epilogue_t* ep)
+{
+    direct_args_t a = { x, n, c_in, h_in, w_in, w, w_b_stride, w_ic_stride, 1.0f,
+                              c_out, k_h, k_w, bias_or_null, stride_h, stride_w, pad_h, pad_w,
+                              y, h_out, w_out, ep, 0, 0, 0 };
+    direct_set_blocking(&a);
+    thread_pool_run(direct_num_items(&a), direct_f32_range, &a);
+}
+
+void conv2d_direct_nchw_f32(
+    const float* x, int32_t n, int32_t c_in, int32_t h_in, int32_t w_in,
+    const float* w, int32_t c_out, int32_t k_h, int32_t k_w,
     const float* bias_or_null,
     int32_t stride_h, int32_t stride_w,
     int32_t pad_h, int32_t pad_w,
     int32_t groups,
     float* y, int32_t h_out, int32_t w_out)
 {
-    if (groups != 1) return;
+    if (groups != 1) {
+        return;
+    }
+    direct_f32_impl(x, n, c_in, h_in, w_in, w, c_in * k_h * k_w, k_h * k_w, c_out, k_h, k_w,
+                    bias_or_null, stride_h, stride_w, pad_h, pad_w, y, h_out, w_out, NULL);
+}
 
-    const int32_t tile_h = CONV2D_TILE_H;
-    const int32_t tile_w = CONV2D_TILE_W;
-    const int32_t oc_block = CONV2D_OC_BLOCK;
+/* W8A32: INT8 weights (per-tensor scale), FP32 compute. 가중치 배치는 direct_f32_impl과 동일 */
+static void direct_w8_range(void* ctx, int32_t it0, int32_t it1, int32_t tid)
+{
+    const direct_args_t* a = (const direct_args_t*)ctx;
+    const float* x = a->x;
+    const int32_t n = a->n, c_in = a->c_in, h_in = a->h_in, w_in = a->w_in;
+    const int8_t* w = (const int8_t*)a->w;
+    const int32_t w_b_stride = a->w_b_stride, w_ic_stride = a->w_ic_stride;
+    const float scale = a->scale;
+    const int32_t c_out = a->c_out, k_h = a->k_h, k_w = a->k_w;
+    const float* bias_or_null = a->bias_or_null;
+    const int32_t stride_h = a->stride_h, stride_w = a->stride_w, pad_h = a->pad_h, pad_w = a->pad_w;
+    float* y = a->y;
+    const int32_t h_out = a->h_out, w_out = a->w_out;
+    const conv2d_epilogue_t* ep = a->ep;
+    float (*acc)[CONV2D_OC_BLOCK] = conv2d_acc_buf[tid];
+    int32_t it = 0;  /* 타일 번호 (ni→oh0→ow0→oc0 순서) */
+
+    const int32_t tile_h = a->tile_h;
+    const int32_t tile_w = a->tile_w;
+    const int32_t oc_block = a->oc_block;
 
     const int32_t safe_oh_min = (pad_h + stride_h - 1) / stride_h;
     const int32_t safe_oh_max = (h_in - k_h + pad_h) / stride_h;
@@ -183,10 +309,9 @@ void conv2d_nchw_f32_w8(
     const int32_t x_h_stride = w_in;
     const int32_t x_c_stride = h_in * w_in;
     const int32_t w_k_stride = k_w;
-    const int32_t w_ic_stride = k_h * k_w;
     const int32_t w_oc_stride = c_in * k_h * k_w;
 
-    /* 1x1 fast path */
+    /* 1x1 fast path (스칼라) */
     if (k_h == 1 && k_w == 1) {
         for (int32_t ni = 0; ni < n; ni++) {
             for (int32_t oh0 = 0; oh0 < h_out; oh0 += tile_h) {
@@ -196,11 +321,14 @@ void conv2d_nchw_f32_w8(
                     const int32_t ow_end = ow0 + tile_w < w_out ? ow0 + tile_w : w_out;
                     const int32_t tw = ow_end - ow0;
                     for (int32_t oc0 = 0; oc0 < c_out; oc0 += oc_block) {
+                        const int32_t item = it++;
+                        if (item < it0 || item >= it1) continue;  /* 다른 스레드 몫 */
                         const int32_t n_oc = oc0 + oc_block <= c_out ? oc_block : c_out - oc0;
+                        const size_t w_oc0 = direct_w_offset(oc0, w_oc_stride, w_b_stride);
                         for (int32_t dh = 0; dh < th; dh++) {
                             for (int32_t dw = 0; dw < tw; dw++) {
                                 for (int32_t b = 0; b < n_oc; b++)
-                                    conv2d_acc_buf[dh][dw][b] = bias_or_null ? bias_or_null[oc0 + b] : 0.0f;
+                                    acc[dh * tile_w + dw][b] = bias_or_null ? bias_or_null[oc0 + b] : 0.0f;
                             }
                         }
                         for (int32_t ic = 0; ic < c_in; ic++) {
@@ -211,7 +339,7 @@ void conv2d_nchw_f32_w8(
                                     const int32_t ow = ow0 + dw;
                                     float x_val = x_ch[oh * x_h_stride + ow];
                                     for (int32_t b = 0; b < n_oc; b++)
-                                        conv2d_acc_buf[dh][dw][b] += x_val * (float)w[(oc0 + b) * w_oc_stride + ic] * scale;
+                                        acc[dh * tile_w + dw][b] += x_val * (float)w[w_oc0 + b * w_b_stride + ic * w_ic_stride] * scale;
                                 }
                             }
                         }
@@ -221,7 +349,7 @@ void conv2d_nchw_f32_w8(
                                 const int32_t ow = ow0 + dw;
                                 const int32_t y_off = (ni * c_out + oc0) * h_out * w_out + oh * w_out + ow;
                                 for (int32_t b = 0; b < n_oc; b++)
-                                    y[y_off + b * h_out * w_out] = conv2d_acc_buf[dh][dw][b];
+                                    y[y_off + b * h_out * w_out] = conv2d_epilogue_apply(ep, acc[dh * tile_w + dw][b], (size_t)(y_off + b * h_out * w_out));
                             }
                         }
                     }
@@ -240,12 +368,15 @@ void conv2d_nchw_f32_w8(
                 const int32_t tw = ow_end - ow0;
 
                 for (int32_t oc0 = 0; oc0 < c_out; oc0 += oc_block) {
+                    const int32_t item = it++;
+                    if (item < it0 || item >= it1) continue;  /* 다른 스레드 몫 */
                     const int32_t n_oc = oc0 + oc_block <= c_out ? oc_block : c_out - oc0;
+                    const size_t w_oc0 = direct_w_offset(oc0, w_oc_stride, w_b_stride);
 
                     for (int32_t dh = 0; dh < th; dh++) {
                         for (int32_t dw = 0; dw < tw; dw++) {
                             for (int32_t b = 0; b < n_oc; b++) {
-                                conv2d_acc_buf[dh][dw][b] = bias_or_null ? bias_or_null[oc0 + b] : 0.0f;
+                                acc[dh * tile_w + dw][b] = bias_or_null ? bias_or_null[oc0 + b] : 0.0f;
                             }
                         }
                     }
@@ -255,7 +386,7 @@ void conv2d_nchw_f32_w8(
 
                     for (int32_t ic = 0; ic < c_in; ic++) {
                         for (int32_t b = 0; b < n_oc; b++) {
-                            const int8_t* w_base = w + (oc0 + b) * w_oc_stride + ic * w_ic_stride;
+                            const int8_t* w_base = w + w_oc0 + b * w_b_stride + ic * w_ic_stride;
                             /* (ic,b)당 1회: int8 → float (scale 포함). local_w는 최대 6x6만 지원. */
                             float local_w[36];  /* max 6x6 */
                             const int32_t k_size = k_h * k_w;
@@ -303,7 +434,7 @@ void conv2d_nchw_f32_w8(
                                             for (int32_t kw = 0; kw < k_w; kw++)
                                                 contrib += (*x_row++) * lw_row[kw];
                                         }
-                                        float* acc_ptr = &conv2d_acc_buf[dh][dw][0];
+                                        float* acc_ptr = &acc[dh * tile_w + dw][0];
                                         acc_ptr[b] += contrib;
                                     }
                                 }
@@ -337,7 +468,7 @@ void conv2d_nchw_f32_w8(
                                                 }
                                             }
                                         }
-                                        float* acc_ptr = &conv2d_acc_buf[dh][dw][0];
+                                        float* acc_ptr = &acc[dh * tile_w + dw][0];
                                         acc_ptr[b] += contrib;
                                     }
                                 }
@@ -351,7 +482,7 @@ void conv2d_nchw_f32_w8(
                             const int32_t ow = ow0 + dw;
                             const int32_t y_row_off = (ni * c_out + oc0) * h_out * w_out + oh * w_out + ow;
                             for (int32_t b = 0; b < n_oc; b++) {
-                                y[y_row_off + b * h_out * w_out] = conv2d_acc_buf[dh][dw][b];
+                                y[y_row_off + b * h_out * w_out] = conv2d_epilogue_apply(ep, acc[dh * tile_w + dw][b], (size_t)(y_row_off + b * h_out * w_out));
                             }
                         }
                     }
@@ -360,3 +491,381 @@ void conv2d_nchw_f32_w8(
         }
     }
 }
+
+static void direct_w8_impl(
+    const float* x, int32_t n, int32_t c_in, int32_t h_in, int32_t w_in,
+    const int8_t* w, int32_t w_b_stride, int32_t w_ic_stride, float scale,
+    int32_t c_out, int32_t k_h, int32_t k_w,
+    const float* bias_or_null,
+    int32_t stride_h, int32_t stride_w,
+    int32_t pad_h, int32_t pad_w,
+    float* y, int32_t h_out, int32_t w_out, const conv2d_epilogue_t* ep)
+{
+    direct_args_t a = { x, n, c_in, h_in, w_in, w, w_b_stride, w_ic_stride, scale,
+                              c_out, k_h, k_w, bias_or_null, stride_h, stride_w, pad_h, pad_w,
+                              y, h_out, w_out, ep, 0, 0, 0 };
+    direct_set_blocking(&a);
+    thread_pool_run(direct_num_items(&a), direct_w8_range, &a);
+}
+
+void conv2d_direct_nchw_f32_w8(
+    const float* x, int32_t n, int32_t c_in, int32_t h_in, int32_t w_in,
+    const int8_t* w, float scale, int32_t c_out, int32_t k_h, int32_t k_w,
+    const float* bias_or_null,
+    int32_t stride_h, int32_t stride_w,
+    int32_t pad_h, int32_t pad_w,
+    int32_t groups,
+    float* y, int32_t h_out, int32_t w_out)
+{
+    if (groups != 1) return;
+    direct_w8_impl(x, n, c_in, h_in, w_in, w, c_in * k_h * k_w, k_h * k_w, scale, c_out, k_h, k_w,
+                   bias_or_null, stride_h, stride_w, pad_h, pad_w, y, h_out, w_out, NULL);
+}
+
+/* ---- 런타임 알고리즘 선택 (DIRECT = reference, GEMM = im2col + packed GEMM, WINOGRAD) ---- */
+
+static conv2d_algo_t s_algo = CONV2D_ALGO_DEFAULT;
+
+/* GEMM A 패널 scratch (weight_pack 패널이 없을 때만 호출마다 재패킹, 최대 레이어 크기로 1회 성장) */
+static float* s_gemm_w_buf;
+static size_t s_gemm_w_cap;
+
+/* 1x1 짝 conv의 연결 bias (BSS) */
+#define CONV2D_PAIR_MAX_C 512
+static float s_pair_bias[CONV2D_PAIR_MAX_C];
+
+void conv2d_set_algo(conv2d_algo_t algo) {
+    s_algo = algo;
+}
+
+conv2d_algo_t conv2d_get_algo(void) {
+    return s_algo;
+}
+
+static const float* gemm_pack_scratch(const void* w, float scale, int is_int8,
+                                      int32_t c_out, int32_t c_in, int32_t k_h, int32_t k_w)
+{
+    size_t need = conv2d_gemm_packed_size(c_out, c_in, k_h, k_w);
+    if (need > s_gemm_w_cap) {
+        float* p = (float*)realloc(s_gemm_w_buf, need * sizeof(float));
+        if (!p) return NULL;
+        s_gemm_w_buf = p;
+        s_gemm_w_cap = need;
+    }
+    conv2d_gemm_pack_weights(w, scale, is_int8, c_out, c_in, k_h, k_w, s_gemm_w_buf);
+    return s_gemm_w_buf;
+}
+
+unsigned conv2d_weight_pack_flags(void) {
+    unsigned flags = 0;
+    if (s_algo == CONV2D_ALGO_DIRECT) flags |= WEIGHT_PACK_DIRECT | WEIGHT_PACK_DEQUANT;
+    if (s_algo != CONV2D_ALGO_DIRECT) flags |= WEIGHT_PACK_PANEL;
+    if (s_algo == CONV2D_ALGO_WINOGRAD) flags |= WEIGHT_PACK_WINOGRAD;
+    return flags;
+}
+
+/* 공통 dispatch: weight_pack 배치가 있으면 우선 사용 (호출마다 변환 없음).
+ * x_img / y_img: 이미지 간격 (원소). Winograd/1x1/GEMM은 (이미지, 블록) 작업 단위가 간격을 직접 써서
+ * 채널 구간 batch도 호출 한 번, stem/direct는 밀집이 아니면 이미지마다 호출 */
+static void conv2d_dispatch(
+    const float* x, int32_t n, int32_t c_in, int32_t h_in, int32_t w_in,
+    const void* w, float scale, int is_int8, int32_t c_out, int32_t k_h, int32_t k_w,
+    const float* bias_or_null,
+    int32_t stride_h, int32_t stride_w,
+    int32_t pad_h, int32_t pad_w,
+    const conv2d_epilogue_t* ep,
+    float* y, int32_t h_out, int32_t w_out,
+    size_t x_img, size_t y_img)
+{
+    const weight_pack_t* pk = weight_pack_find(w);
+    if (pk && (pk->c_out != c_out || pk->c_in != c_in || pk->k_h != k_h || pk->k_w != k_w))
+        pk = NULL;
+    const int32_t ksz = k_h * k_w;
+    const int dense = n == 1 || (x_img == (size_t)c_in * h_in * w_in && y_img == (size_t)c_out * h_out * w_out);
+    /* stem/direct는 밀집 배치만: 채널 구간이면 이미지마다 n=1로 다시 (residual도 y와 같은 간격으로 이동) */
+#define DISPATCH_PER_IMAGE()                                                                              \
+    do {                                                                                                  \
+        conv2d_epilogue_t ep_img;                                                                         \
+        if (ep) ep_img = *ep;                                                                             \
+        for (int32_t b = 0; b < n; b++) {                                                                 \
+            if (ep && ep->residual) ep_img.residual = ep->residual + (size_t)b * y_img;                   \
+            conv2d_dispatch(x + (size_t)b * x_img, 1, c_in, h_in, w_in, w, scale, is_int8, c_out, k_h, k_w, \
+                            bias_or_null, stride_h, stride_w, pad_h, pad_w, ep ? &ep_img : NULL,          \
+                            y + (size_t)b * y_img, h_out, w_out, x_img, y_img);                           \
+        }                                                                                                 \
+    } while (0)
+
+#if CONV2D_STEM
+    /* stem 6x6/s2 (c_in 3): ic 루프가 짧아 일반 커널 효율이 낮음 → DIRECT(reference) 외 알고리즘에서
+     * 로드 시 만든 stem 패널이 있으면 전용 커널 */
+    if (s_algo != CONV2D_ALGO_DIRECT && pk && pk->stem &&
+        conv2d_stem_supported(c_in, c_out, k_h, k_w, stride_h, stride_w, pad_h, pad_w)) {
+        if (!dense) {
+            DISPATCH_PER_IMAGE();
+            return;
+        }
+        conv2d_stem_nchw_f32(x, n, c_in, h_in, w_in, pk->stem, c_out, bias_or_null,
+                             pad_h, pad_w, ep, y, h_out, w_out);
+        return;
+    }
+#endif
+    /* WINOGRAD: 3x3/s1 이고 로드 시 변환된 필터가 있을 때만 */
+    if (s_algo == CONV2D_ALGO_WINOGRAD && pk && pk->wino &&
+        k_h == 3 && k_w == 3 && stride_h == 1 && stride_w == 1) {
+        conv2d_winograd_f2x3_nchw_f32(x, n, c_in, h_in, w_in, pk->wino, c_out, bias_or_null,
+                                      pad_h, pad_w, ep, y, h_out, w_out, x_img, y_img);
+        return;
+    }
+#if CONV2D_1X1_SIMD
+    /* 1x1/s1/p0: 재패킹 없는 SIMD 커널이 GEMM보다 빠름 → DIRECT(reference) 외 알고리즘에서 사용 */
+    if (s_algo != CONV2D_ALGO_DIRECT &&
+        k_h == 1 && k_w == 1 && stride_h == 1 && stride_w == 1 && pad_h == 0 && pad_w == 0 &&
+        h_in == h_out && w_in == w_out) {
+#if CONV2D_GEMM_MR == CONV2D_1X1_OCB
+        if (pk && pk->panel) {
+            conv2d_1x1_f32_packed(x, n, c_in, h_in, w_in, pk->panel, c_out, bias_or_null, ep, y, x_img, y_img);
+            return;
+        }
+#endif
+        if (is_int8 && conv2d_1x1_w8_nchw_f32(x, n, c_in, h_in, w_in, (const int8_t*)w, scale,
+                                              c_out, bias_or_null, ep, y, x_img, y_img))
+            return;
+    }
+#endif
+    if (s_algo != CONV2D_ALGO_DIRECT) {
+        const float* a = (pk && pk->panel) ? pk->panel
+                                           : gemm_pack_scratch(w, scale, is_int8, c_out, c_in, k_h, k_w);
+        if (a) {
+            conv2d_gemm_nchw_f32(x, n, c_in, h_in, w_in, a, c_out, k_h, k_w, bias_or_null,
+                                 stride_h, stride_w, pad_h, pad_w, ep, y, h_out, w_out, x_img, y_img);
+            return;
+        }
+    }
+    if (!dense) {
+        DISPATCH_PER_IMAGE();
+        return;
+    }
+#undef DISPATCH_PER_IMAGE
+    /* DIRECT: [oc/OCB][ic][OCB][kh*kw] 배치면 oc 블록×ic 단위로 연속 스트리밍 */
+    if (pk && pk->direct_f32) {
+        direct_f32_impl(x, n, c_in, h_in, w_in, pk->direct_f32, ksz, CONV2D_OC_BLOCK * ksz,
+                        c_out, k_h, k_w, bias_or_null, stride_h, stride_w, pad_h, pad_w,
+                        y, h_out, w_out, ep);
+    } else if (pk && pk->direct_i8) {
+        direct_w8_impl(x, n, c_in, h_in, w_in, pk->direct_i8, ksz, CONV2D_OC_BLOCK * ksz, scale,
+                       c_out, k_h, k_w, bias_or_null, stride_h, stride_w, pad_h, pad_w,
+                       y, h_out, w_out, ep);
+    } else if (is_int8) {
+        direct_w8_impl(x, n, c_in, h_in, w_in, (const int8_t*)w, c_in * ksz, ksz, scale,
+                       c_out, k_h, k_w, bias_or_null, stride_h, stride_w, pad_h, pad_w,
+                       y, h_out, w_out, ep);
+    } else {
+        direct_f32_impl(x, n, c_in, h_in, w_in, (const float*)w, c_in * ksz, ksz,
+                        c_out, k_h, k_w, bias_or_null, stride_h, stride_w, pad_h, pad_w,
+                        y, h_out, w_out, ep);
+    }
+}
+
+void conv2d_nchw_f32(
+    const float* x, int32_t n, int32_t c_in, int32_t h_in, int32_t w_in,
+    const float* w, int32_t c_out, int32_t k_h, int32_t k_w,
+    const float* bias_or_null,
+    int32_t stride_h, int32_t stride_w,
+    int32_t pad_h, int32_t pad_w,
+    int32_t groups,
+    float* y, int32_t h_out, int32_t w_out)
+{
+    if (groups != 1) return;
+    conv2d_dispatch(x, n, c_in, h_in, w_in, w, 1.0f, 0, c_out, k_h, k_w, bias_or_null,
+                    stride_h, stride_w, pad_h, pad_w, NULL, y, h_out, w_out,
+                    (size_t)c_in * h_in * w_in, (size_t)c_out * h_out * w_out);
+}
+
+void conv2d_nchw_f32_w8(
+    const float* x, int32_t n, int32_t c_in, int32_t h_in, int32_t w_in,
+    const int8_t* w, float scale, int32_t c_out, int32_t k_h, int32_t k_w,
+    const float* bias_or_null,
+    int32_t stride_h, int32_t stride_w,
+    int32_t pad_h, int32_t pad_w,
+    int32_t groups,
+    float* y, int32_t h_out, int32_t w_out)
+{
+    if (groups != 1) return;
+    conv2d_dispatch(x, n, c_in, h_in, w_in, w, scale, 1, c_out, k_h, k_w, bias_or_null,
+                    stride_h, stride_w, pad_h, pad_w, NULL, y, h_out, w_out,
+                    (size_t)c_in * h_in * w_in, (size_t)c_out * h_out * w_out);
+}
+
+/* 연결 패널용 bias [a | b] (없으면 NULL) */
+static const float* pair_bias(const float* bias_a, int32_t c_a, const float* bias_b, int32_t c_b)
+{
+    if (!bias_a && !bias_b) return NULL;
+    for (int32_t i = 0; i < c_a; i++) s_pair_bias[i] = bias_a ? bias_a[i] : 0.0f;
+    for (int32_t i = 0; i < c_b; i++) s_pair_bias[c_a + i] = bias_b ? bias_b[i] : 0.0f;
+    return s_pair_bias;
+}
+
+/* 호출자 epilogue에 현재 SiLU 모드를 채운 사본 (커널은 ep만 봄) */
+static const conv2d_epilogue_t* epilogue_resolve(const conv2d_epilogue_t* ep, conv2d_epilogue_t* tmp)
+{
+    if (!ep) return NULL;
+    *tmp = *ep;
+    tmp->silu_fast = ep->silu && silu_get_mode() == SILU_FAST;
+    return tmp;
+}
+
+int conv2d_pair_1x1_nchw_f32(
+    const float* x, int32_t n, int32_t c_in, int32_t h, int32_t w,
+    const void* w_a, int32_t c_a, const float* bias_a,
+    const void* w_b, int32_t c_b, const float* bias_b,
+    const conv2d_epilogue_t* ep,
+    float* y)
+{
+    const weight_pack_t* pk = weight_pack_find(w_a);
+    if (!pk || !pk->panel || pk->pair_src != w_b || pk->c_in != c_in || pk->c_out != c_a ||
+        pk->pair_c_out != c_b || c_a + c_b > CONV2D_PAIR_MAX_C)
+        return 0;
+    const float* bias = pair_bias(bias_a, c_a, bias_b, c_b);
+    conv2d_epilogue_t ep_buf;
+    ep = epilogue_resolve(ep, &ep_buf);
+    /* 연결 패널은 단독 1x1과 같은 경로로 (oc 블록 경계가 같아 결과 bit-identical) */
+    if (s_algo == CONV2D_ALGO_DIRECT) return 0;
+#if CONV2D_1X1_SIMD && CONV2D_GEMM_MR == CONV2D_1X1_OCB
+    conv2d_1x1_f32_packed(x, n, c_in, h, w, pk->panel, c_a + c_b, bias, ep, y,
+                          (size_t)c_in * h * w, (size_t)(c_a + c_b) * h * w);
+    return 1;
+#else
+    conv2d_gemm_nchw_f32(x, n, c_in, h, w, pk->panel, c_a + c_b, 1, 1, bias, 1, 1, 0, 0, ep, y, h, w,
+                         (size_t)c_in * h * w, (size_t)(c_a + c_b) * h * w);
+    return 1;
+#endif
+}
+
+/* 가상 concat 입력 스칼라 경로: item = (ni, oc) 출력 plane. bias로 시작해 ic 순서로 plane 전체에 누적
+ * (업샘플 채널은 행마다 up 행 하나를 ow/2로 읽음), 마지막에 epilogue */
+typedef struct {
+    const conv2d_up_concat_t* v; int32_t c_in, h, w;
+    const void* wt; float scale; int is_int8; int32_t c_out;
+    const float* bias_or_null;
+    const conv2d_epilogue_t* ep;
+    float* y; size_t y_img;
+} up_concat_args_t;
+
+static void up_concat_range(void* ctx, int32_t it0, int32_t it1, int32_t tid)
+{
+    const up_concat_args_t* g = (const up_concat_args_t*)ctx;
+    const conv2d_up_concat_t* v = g->v;
+    const int32_t h = g->h, w = g->w, P = h * w, w_up = w >> 1;
+    (void)tid;
+
+    for (int32_t it = it0; it < it1; it++) {
+        const int32_t ni = it / g->c_out, oc = it % g->c_out;
+        const size_t off = (size_t)ni * g->y_img + (size_t)oc * P;
+        float* yp = g->y + off;
+        const float b = g->bias_or_null ? g->bias_or_null[oc] : 0.0f;
+        for (int32_t p = 0; p < P; p++) yp[p] = b;
+        for (int32_t ic = 0; ic < g->c_in; ic++) {
+            const size_t wi = (size_t)oc * g->c_in + ic;
+            const float wv = g->is_int8 ? (float)((const int8_t*)g->wt)[wi] * g->scale : ((const float*)g->wt)[wi];
+            if (ic < v->c_up) {
+                const float* u = v->up + (size_t)ni * v->up_img + (size_t)ic * (P >> 2);
+                for (int32_t oh = 0; oh < h; oh++) {
+                    const float* ur = u + (size_t)(oh >> 1) * w_up;
+                    float* yr = yp + (size_t)oh * w;
+                    for (int32_t ow = 0; ow < w; ow++) yr[ow] += wv * ur[ow >> 1];
+                }
+            } else {
+                const float* xr = v->x + (size_t)ni * v->x_img + (size_t)(ic - v->c_up) * P;
+                for (int32_t p = 0; p < P; p++) yp[p] += wv * xr[p];
+            }
+        }
+        if (g->ep) {
+            for (int32_t p = 0; p < P; p++) yp[p] = conv2d_epilogue_apply(g->ep, yp[p], off + (size_t)p);
+        }
+    }
+}
+
+static void up_concat_one(
+    const conv2d_up_concat_t* v, int32_t n, int32_t c_in, int32_t h, int32_t w,
+    const void* wt, float scale, int is_int8, int32_t c_out, const float* bias_or_null,
+    const conv2d_epilogue_t* ep, float* y, size_t y_img)
+{
+#if CONV2D_1X1_SIMD
+    /* DIRECT(reference)는 아래 스칼라 경로 */
+    if (s_algo != CONV2D_ALGO_DIRECT) {
+        const float* panel = NULL;
+#if CONV2D_GEMM_MR == CONV2D_1X1_OCB
+        const weight_pack_t* pk = weight_pack_find(wt);
+        if (pk && pk->panel && pk->c_out == c_out && pk->c_in == c_in && pk->k_h == 1 && pk->k_w == 1)
+            panel = pk->panel;
+#endif
+        if (!panel && is_int8) panel = conv2d_1x1_unpack_panel((const int8_t*)wt, scale, c_out, c_in);
+        if (panel && conv2d_1x1_up_concat_f32_packed(v, n, c_in, h, w, panel, c_out, bias_or_null, ep, y, y_img))
+            return;
+    }
+#endif
+    up_concat_args_t g = { v, c_in, h, w, wt, scale, is_int8, c_out, bias_or_null, ep, y, y_img };
+    thread_pool_run(n * c_out, up_concat_range, &g);
+}
+
+void conv2d_up_concat_1x1_nchw_f32(
+    const conv2d_up_concat_t* v, int32_t n, int32_t c_in, int32_t h, int32_t w,
+    const void* w_a, float scale_a, int is_int8_a, int32_t c_a, const float* bias_a,
+    const void* w_b, float scale_b, int is_int8_b, int32_t c_b, const float* bias_b,
+    const conv2d_epilogue_t* ep,
+    float* y)
+{
+    conv2d_epilogue_t ep_buf;
+    const size_t P = (size_t)h * (size_t)w;
+    const size_t y_img = (size_t)(c_a + (w_b ? c_b : 0)) * P;
+    if (!v || !w_a || (h & 1) || (w & 1)) return;
+    ep = epilogue_resolve(ep, &ep_buf);
+#if CONV2D_1X1_SIMD && CONV2D_GEMM_MR == CONV2D_1X1_OCB
+    /* [a | b] 연결 패널이면 업샘플 타일 한 번으로 두 conv */
+    if (w_b && s_algo != CONV2D_ALGO_DIRECT) {
+        const weight_pack_t* pk = weight_pack_find(w_a);
+        if (pk && pk->panel && pk->pair_src == w_b && pk->c_in == c_in && pk->c_out == c_a &&
+            pk->pair_c_out == c_b && c_a + c_b <= CONV2D_PAIR_MAX_C &&
+            conv2d_1x1_up_concat_f32_packed(v, n, c_in, h, w, pk->panel, c_a + c_b,
+                                            pair_bias(bias_a, c_a, bias_b, c_b), ep, y, y_img))
+            return;
+    }
+#endif
+    up_concat_one(v, n, c_in, h, w, w_a, scale_a, is_int8_a, c_a, bias_a, ep, y, y_img);
+    if (w_b)
+        up_concat_one(v, n, c_in, h, w, w_b, scale_b, is_int8_b, c_b, bias_b, ep, y + (size_t)c_a * P, y_img);
+}
+
+void conv2d_fused_nchw_f32(
+    const float* x, int32_t n, int32_t c_in, int32_t h_in, int32_t w_in,
+    const void* w, float scale, int is_int8, int32_t c_out, int32_t k_h, int32_t k_w,
+    const float* bias_or_null,
+    int32_t stride_h, int32_t stride_w,
+    int32_t pad_h, int32_t pad_w,
+    const conv2d_epilogue_t* ep,
+    float* y, int32_t h_out, int32_t w_out)
+{
+    conv2d_epilogue_t ep_buf;
+    if (!w) return;
+    conv2d_dispatch(x, n, c_in, h_in, w_in, w, is_int8 ? scale : 1.0f, is_int8, c_out, k_h, k_w,
+                    bias_or_null, stride_h, stride_w, pad_h, pad_w, epilogue_resolve(ep, &ep_buf),
+                    y, h_out, w_out, (size_t)c_in * h_in * w_in, (size_t)c_out * h_out * w_out);
+}
+
+void conv2d_fused_slice_nchw_f32(
+    const float* x, int32_t x_c_total, int32_t n, int32_t c_in, int32_t h_in, int32_t w_in,
+    const void* w, float scale, int is_int8, int32_t c_out, int32_t k_h, int32_t k_w,
+    const float* bias_or_null,
+    int32_t stride_h, int32_t stride_w,
+    int32_t pad_h, int32_t pad_w,
+    const conv2d_epilogue_t* ep,
+    float* y, int32_t y_c_total, int32_t h_out, int32_t w_out)
+{
+    conv2d_epilogue_t ep_buf;
+    if (!w) return;
+    if (x_c_total <= 0) x_c_total = c_in;
+    if (y_c_total <= 0) y_c_total = c_out;
+    conv2d_dispatch(x, n, c_in, h_in, w_in, w, is_int8 ? scale : 1.0f, is_int8, c_out, k_h, k_w,
+                    bias_or_null, stride_h, stride_w, pad_h, pad_w, epilogue_resolve(ep, &ep_buf),
+                    y, h_out, w_out, (size_t)x_c_total * h_in * w_in, (size_t)y_c_total * h_out * w_out);
+}
@@ -2,6 +2,8 @@
 #define CONV2D_H
 
 #include <stdint.h>
+#include "conv2d_epilogue.h"
+#include "conv2d_1x1.h"
 
 /* W8A32: conv에 넘길 가중치 (float* 또는 int8_t* + scale) */
 typedef struct {
@@ -10,6 +12,35 @@ typedef struct {
     int is_int8;
 } w8_conv_t;
 
+/* direct 커널 출력 채널 블록(기본 32). weight_pack의 DIRECT 배치도 같은 블록 사용 */
+#ifndef CONV2D_OC_BLOCK
+#define CONV2D_OC_BLOCK 32
+#endif
+
+/* conv 알고리즘 (런타임 선택). DIRECT: 타일 direct 커널 (reference), GEMM: im2col + packed GEMM,
+ * WINOGRAD: 3x3/s1 중 weight_pack에 변환 필터가 있으면 Winograd F(2x2,3x3), 나머지는 GEMM */
+typedef enum {
+    CONV2D_ALGO_DIRECT = 0,
+    CONV2D_ALGO_GEMM = 1,
+    CONV2D_ALGO_WINOGRAD = 2
+} conv2d_algo_t;
+
+/* 기본값: 호스트 WINOGRAD, BARE_METAL은 DIRECT (A 패널 scratch를 힙에서 잡지 않음) */
+#ifndef CONV2D_ALGO_DEFAULT
+#ifdef BARE_METAL
+#define CONV2D_ALGO_DEFAULT CONV2D_ALGO_DIRECT
+#else
+#define CONV2D_ALGO_DEFAULT CONV2D_ALGO_WINOGRAD
+#endif
+#endif
+
+void conv2d_set_algo(conv2d_algo_t algo);
+conv2d_algo_t conv2d_get_algo(void);
+
+/** 현재 알고리즘이 쓰는 weight_pack 배치 (WEIGHT_PACK_* 조합). 로드 직후 weight_pack_prepare()에 전달 */
+unsigned conv2d_weight_pack_flags(void);
+
+/* 선택된 알고리즘으로 dispatch */
 void conv2d_nchw_f32(
     const float* x, int32_t n, int32_t c_in, int32_t h_in, int32_t w_in,
     const float* w, int32_t c_out, int32_t k_h, int32_t k_w,
@@ -19,7 +50,7 @@ void conv2d_nchw_f32(
     int32_t groups,
     float* y, int32_t h_out, int32_t w_out);
 
-/* W8A32: 가중치 INT8, 루프 내 (float)w_int8*scale 로 즉시 복원 (DDR→레지스터만, FP32 버퍼 없음) */
+/* W8A32: 가중치 INT8. weight_pack에 재배치된 가중치가 있으면 그것을, 없으면 루프 내 (float)w_int8*scale 즉시 복원 */
 void conv2d_nchw_f32_w8(
     const float* x, int32_t n, int32_t c_in, int32_t h_in, int32_t w_in,
     const int8_t* w, float scale, int32_t c_out, int32_t k_h, int32_t k_w,
@@ -29,4 +60,65 @@ void conv2d_nchw_f32_w8(
     int32_t groups,
     float* y, int32_t h_out, int32_t w_out);
 
+/* conv + epilogue (SiLU, residual add)를 한 패스로. w: float* 또는 int8_t*+scale (is_int8).
+ * 모든 경로(Winograd/1x1/GEMM/direct)가 출력 타일을 y에 쓸 때 적용. ep NULL이면 conv만 */
+void conv2d_fused_nchw_f32(
+    const float* x, int32_t n, int32_t c_in, int32_t h_in, int32_t w_in,
+    const void* w, float scale, int is_int8, int32_t c_out, int32_t k_h, int32_t k_w,
+    const float* bias_or_null,
+    int32_t stride_h, int32_t stride_w,
+    int32_t pad_h, int32_t pad_w,
+    const conv2d_epilogue_t* ep,
+    float* y, int32_t h_out, int32_t w_out);
+
+/* conv2d_fused_nchw_f32와 같되 x / y가 더 큰 채널 텐서 (x_c_total / y_c_total 채널)의 구간일 수 있음
+ * (C3 concat 절반, SPPF cat 앞부분 등). batch 전체를 호출 한 번으로 → 가중치를 이미지 사이에 재사용.
+ * ep->residual은 y와 같은 배치. *_c_total <= 0이면 밀집 (c_in / c_out) */
+void conv2d_fused_slice_nchw_f32(
+    const float* x, int32_t x_c_total, int32_t n, int32_t c_in, int32_t h_in, int32_t w_in,
+    const void* w, float scale, int is_int8, int32_t c_out, int32_t k_h, int32_t k_w,
+    const float* bias_or_null,
+    int32_t stride_h, int32_t stride_w,
+    int32_t pad_h, int32_t pad_w,
+    const conv2d_epilogue_t* ep,
+    float* y, int32_t y_c_total, int32_t h_out, int32_t w_out);
+
+/* 같은 입력 x에 대한 1x1/s1 conv 두 개(C3 cv1·cv2)를 입력 한 번 읽기로: y = [a 출력 c_a | b 출력 c_b] 채널.
+ * weight_pack이 [a | b] 연결 패널을 만들어 둔 경우만 실행하고 1, 아니면 0 (호출 측이 따로 실행) */
+int conv2d_pair_1x1_nchw_f32(
+    const float* x, int32_t n, int32_t c_in, int32_t h, int32_t w,
+    const void* w_a, int32_t c_a, const float* bias_a,
+    const void* w_b, int32_t c_b, const float* bias_b,
+    const conv2d_epilogue_t* ep,
+    float* y);
+
+/* 입력이 가상 concat [up2x(v->up) | v->x] (conv2d_up_concat_t)인 1x1/s1 conv — 업샘플·concat 버퍼 없음.
+ * w_b != NULL이면 C3 cv1·cv2처럼 y = [a 출력 c_a | b 출력 c_b] (연결 패널이 있으면 한 번에, 없으면 각각).
+ * 1x1 SIMD 빌드는 strip 타일 커널, 그 외는 스칼라 경로. h/w 짝수, ep->residual은 NULL (y에 누적) */
+void conv2d_up_concat_1x1_nchw_f32(
+    const conv2d_up_concat_t* v, int32_t n, int32_t c_in, int32_t h, int32_t w,
+    const void* w_a, float scale_a, int is_int8_a, int32_t c_a, const float* bias_a,
+    const void* w_b, float scale_b, int is_int8_b, int32_t c_b, const float* bias_b,
+    const conv2d_epilogue_t* ep,
+    float* y);
+
+/* Direct 커널 (reference 경로, 알고리즘 선택과 무관하게 직접 호출 가능) */
+void conv2d_direct_nchw_f32(
+    const float* x, int32_t n, int32_t c_in, int32_t h_in, int32_t w_in,
+    const float* w, int32_t c_out, int32_t k_h, int32_t k_w,
+    const float* bias_or_null,
+    int32_t stride_h, int32_t stride_w,
+    int32_t pad_h, int32_t pad_w,
+    int32_t groups,
+    float* y, int32_t h_out, int32_t w_out);
+
+void conv2d_direct_nchw_f32_w8(
+    const float* x, int32_t n, int32_t c_in, int32_t h_in, int32_t w_in,
+    const int8_t* w, float scale, int32_t c_out, int32_t k_h, int32_t k_w,
+    const float* bias_or_null,
+    int32_t stride_h, int32_t stride_w,
+    int32_t pad_h, int32_t pad_w,
+    int32_t groups,
+    float* y, int32_t h_out, int32_t w_out);
+
 #endif // CONV2D_H
@@ -0,0 +1,299 @@
+#include "conv2d_1x1.h"
+#include "../utils/thread_pool.h"
+
+#if CONV2D_1X1_SIMD
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+typedef __m256 vf_t;
+#define VL 8
+#define NV 3                                   /* 4 x 24 픽셀 = 12 누적 레지스터 */
+#define V_LOAD(p)        _mm256_loadu_ps(p)
+#define V_STORE(p, v)    _mm256_storeu_ps((p), (v))
+#define V_SET1(s)        _mm256_set1_ps(s)
+#define V_FMA(acc, a, b) _mm256_fmadd_ps((a), (b), (acc))
+#else
+#include <arm_neon.h>
+typedef float32x4_t vf_t;
+#define VL 4
+#define NV 4                                   /* 4 x 16 픽셀 = 16 누적 레지스터 */
+#define V_LOAD(p)        vld1q_f32(p)
+#define V_STORE(p, v)    vst1q_f32((p), (v))
+#define V_SET1(s)        vdupq_n_f32(s)
+#define V_FMA(acc, a, b) vfmaq_f32((acc), (a), (b))
+#endif
+
+#define OCB CONV2D_1X1_OCB
+
+/* 복원된 가중치 패널 [ceil(c_out/OCB)][c_in][OCB] (BSS) */
+static float w1x1_panel[CONV2D_1X1_MAX_W];
+
+/* 누적 레지스터를 명시적으로 나열 (-O2에서도 배열 spill 없이 레지스터 유지) */
+#if NV == 3
+#define ACC_DECL(i)   vf_t c##i##0 = b##i, c##i##1 = b##i, c##i##2 = b##i
+#define ACC_FMA(i, w) c##i##0 = V_FMA(c##i##0, w, x0); c##i##1 = V_FMA(c##i##1, w, x1); \
+                      c##i##2 = V_FMA(c##i##2, w, x2)
+#define X_LOAD(xr)    const vf_t x0 = V_LOAD(xr), x1 = V_LOAD(xr + VL), x2 = V_LOAD(xr + 2 * VL)
+#define ACC_STORE(i, yr) V_STORE(yr, c##i##0); V_STORE(yr + VL, c##i##1); V_STORE(yr + 2 * VL, c##i##2)
+#else
+#define ACC_DECL(i)   vf_t c##i##0 = b##i, c##i##1 = b##i, c##i##2 = b##i, c##i##3 = b##i
+#define ACC_FMA(i, w) c##i##0 = V_FMA(c##i##0, w, x0); c##i##1 = V_FMA(c##i##1, w, x1); \
+                      c##i##2 = V_FMA(c##i##2, w, x2); c##i##3 = V_FMA(c##i##3, w, x3)
+#define X_LOAD(xr)    const vf_t x0 = V_LOAD(xr), x1 = V_LOAD(xr + VL), \
+                                 x2 = V_LOAD(xr + 2 * VL), x3 = V_LOAD(xr + 3 * VL)
+#define ACC_STORE(i, yr) V_STORE(yr, c##i##0); V_STORE(yr + VL, c##i##1); \
+                         V_STORE(yr + 2 * VL, c##i##2); V_STORE(yr + 3 * VL, c##i##3)
+#endif
+
+/* 입력 채널은 두 구간 [0, c_a) = x_a (행 간격 ld_a), [c_a, c_a + c_b) = x_b (ld_b) — 밀집 입력은 c_b = 0,
+ * 가상 업샘플 concat은 x_a가 strip 타일. 패널 a는 c_a + c_b 행 그대로 (누적 순서 = ic 순서) */
+
+/* 4 oc x (NV*VL) 픽셀 */
+static void kernel_4xnv(int32_t c_a, size_t ld_a, const float* x_a, int32_t c_b, size_t ld_b, const float* x_b,
+                        const float* a, const float bias4[OCB], int32_t mr, float* y_p, int32_t ldy)
+{
+    const vf_t b0 = V_SET1(bias4[0]), b1 = V_SET1(bias4[1]);
+    const vf_t b2 = V_SET1(bias4[2]), b3 = V_SET1(bias4[3]);
+    ACC_DECL(0); ACC_DECL(1); ACC_DECL(2); ACC_DECL(3);
+    for (int32_t seg = 0; seg < 2; seg++) {
+        const int32_t cs = seg ? c_b : c_a;
+        const size_t ld = seg ? ld_b : ld_a;
+        const float* xs = seg ? x_b : x_a;
+        const float* as = seg ? a + (size_t)c_a * OCB : a;
+        for (int32_t ic = 0; ic < cs; ic++) {
+            const float* xr = xs + (size_t)ic * ld;
+            const float* ar = as + ic * OCB;
+            X_LOAD(xr);
+            const vf_t w0 = V_SET1(ar[0]);
+            ACC_FMA(0, w0);
+            const vf_t w1 = V_SET1(ar[1]);
+            ACC_FMA(1, w1);
+            const vf_t w2 = V_SET1(ar[2]);
+            ACC_FMA(2, w2);
+            const vf_t w3 = V_SET1(ar[3]);
+            ACC_FMA(3, w3);
+        }
+    }
+    ACC_STORE(0, y_p);
+    if (mr > 1) { ACC_STORE(1, y_p + (size_t)ldy); }
+    if (mr > 2) { ACC_STORE(2, y_p + (size_t)2 * ldy); }
+    if (mr > 3) { ACC_STORE(3, y_p + (size_t)3 * ldy); }
+}
+
+/* 4 oc x VL 픽셀 (P % (NV*VL) 나머지용) */
+static void kernel_4x1(int32_t c_a, size_t ld_a, const float* x_a, int32_t c_b, size_t ld_b, const float* x_b,
+                       const float* a, const float bias4[OCB], int32_t mr, float* y_p, int32_t ldy)
+{
+    vf_t c0 = V_SET1(bias4[0]), c1 = V_SET1(bias4[1]);
+    vf_t c2 = V_SET1(bias4[2]), c3 = V_SET1(bias4[3]);
+    for (int32_t seg = 0; seg < 2; seg++) {
+        const int32_t cs = seg ? c_b : c_a;
+        const size_t ld = seg ? ld_b : ld_a;
+        const float* xs = seg ? x_b : x_a;
+        const float* as = seg ? a + (size_t)c_a * OCB : a;
+        for (int32_t ic = 0; ic < cs; ic++) {
+            const vf_t xv = V_LOAD(xs + (size_t)ic * ld);
+            const float* ar = as + ic * OCB;
+            c0 = V_FMA(c0, V_SET1(ar[0]), xv);
+            c1 = V_FMA(c1, V_SET1(ar[1]), xv);
+            c2 = V_FMA(c2, V_SET1(ar[2]), xv);
+            c3 = V_FMA(c3, V_SET1(ar[3]), xv);
+        }
+    }
+    V_STORE(y_p, c0);
+    if (mr > 1) V_STORE(y_p + (size_t)ldy, c1);
+    if (mr > 2) V_STORE(y_p + (size_t)2 * ldy, c2);
+    if (mr > 3) V_STORE(y_p + (size_t)3 * ldy, c3);
+}
+
+/* 가상 업샘플 채널의 strip 타일 [c_up][NV*VL] (스레드별, BSS) */
+static float up_tile_buf[YOLO_MAX_THREADS][CONV2D_1X1_UP_MAX_C * NV * VL];
+
+/* thread_pool 작업: item = (ni, strip). strip < n_full: NV*VL 픽셀, 마지막 strip: 나머지 픽셀.
+ * up != NULL이면 입력 채널 [0, c_up)은 up(h/2 × w/2)의 2x nearest, 나머지는 x */
+typedef struct {
+    const float* x; int32_t c_in, P;
+    const float* panel; int32_t c_out;
+    const float* bias_or_null;
+    const conv2d_epilogue_t* ep;
+    float* y;
+    size_t x_img, y_img;                 /* 이미지 간격 (원소) */
+    const float* up; int32_t c_up, w;
+    size_t up_img;
+} conv1x1_args_t;
+
+/* strip [p_lo, p_hi) 픽셀의 업샘플 채널을 타일 [c_up][ld]로 (출력 (oh, ow) ← up (oh/2, ow/2)) */
+static void gather_up_strip(const conv1x1_args_t* g, const float* up_img, int32_t p_lo, int32_t p_hi,
+                            float* tile, int32_t ld)
+{
+    const int32_t w = g->w, hw_up = (g->P >> 2), w_up = w >> 1;
+    int32_t src[NV * VL];
+    for (int32_t p = p_lo; p < p_hi; p++)
+        src[p - p_lo] = ((p / w) >> 1) * w_up + ((p % w) >> 1);
+    for (int32_t ic = 0; ic < g->c_up; ic++) {
+        const float* u = up_img + (size_t)ic * hw_up;
+        float* t = tile + (size_t)ic * ld;
+        for (int32_t j = 0; j < p_hi - p_lo; j++) t[j] = u[src[j]];
+    }
+}
+
+/* epilogue가 있으면 커널은 스택 타일 [OCB][NV*VL]에 저장하고, 여기서 적용하며 y에 1회 씀
+ * (residual이 y와 같은 주소여도 읽기 전에 덮어쓰지 않음) */
+static inline void epilogue_store(const conv2d_epilogue_t* ep, float* tile, int32_t ld,
+                                  float* y, size_t off, int32_t P, int32_t mr, int32_t len)
+{
+    for (int32_t i = 0; i < mr; i++) {
+        const size_t row = off + (size_t)i * P;
+        if (ep->silu && ep->silu_fast) {
+            /* FAST SiLU는 타일 행 단위 벡터 (스칼라와 bit-identical) */
+            silu_fast_span_f32(tile + i * ld, tile + i * ld, len);
+            if (ep->residual) {
+                for (int32_t j = 0; j < len; j++) y[row + j] = ep->residual[row + j] + tile[i * ld + j];
+            } else {
+                memcpy(y + row, tile + i * ld, (size_t)len * sizeof(float));
+            }
+            continue;
+        }
+        for (int32_t j = 0; j < len; j++)
+            y[row + j] = conv2d_epilogue_apply(ep, tile[i * ld + j], row + j);
+    }
+}
+
+static void conv1x1_range(void* ctx, int32_t it0, int32_t it1, int32_t tid)
+{
+    const conv1x1_args_t* g = (const conv1x1_args_t*)ctx;
+    const int32_t c_in = g->c_in, P = g->P, c_out = g->c_out;
+    const float* panel = g->panel;
+    const float* bias_or_null = g->bias_or_null;
+    const conv2d_epilogue_t* ep = g->ep;
+    const int32_t n_blk = (c_out + OCB - 1) / OCB;
+    const int32_t step = NV * VL;
+    const int32_t n_full = P / step;
+    const int32_t c_a = g->up ? g->c_up : 0, c_b = c_in - c_a;
+    float tile[OCB * NV * VL];
+    float* up_tile = up_tile_buf[tid];
+
+    for (int32_t it = it0; it < it1; it++) {
+        const int32_t ni = it / (n_full + 1);
+        const int32_t si = it % (n_full + 1);
+        const float* x_img = g->x + (size_t)ni * g->x_img;
+        const size_t y_img_off = (size_t)ni * g->y_img;
+        float* y_img = g->y + y_img_off;
+        const int32_t p_lo = si * step, p_hi = si < n_full ? p_lo + step : P;
+        if (p_lo >= p_hi) continue;
+        /* 업샘플 채널은 strip마다 타일로 한 번 모아 모든 oc 블록에 재사용 (x_a[p - p_lo]) */
+        if (c_a) gather_up_strip(g, g->up + (size_t)ni * g->up_img, p_lo, p_hi, up_tile, step);
+
+        /* 픽셀 strip(c_in x step)을 L1에 두고 모든 oc 블록에 재사용 */
+        if (si < n_full) {
+            const int32_t p0 = p_lo;
+            for (int32_t blk = 0; blk < n_blk; blk++) {
+                const int32_t oc0 = blk * OCB;
+                const int32_t mr = oc0 + OCB <= c_out ? OCB : c_out - oc0;
+                float b4[OCB];
+                for (int32_t i = 0; i < OCB; i++)
+                    b4[i] = (bias_or_null && i < mr) ? bias_or_null[oc0 + i] : 0.0f;
+                if (!ep) {
+                    kernel_4xnv(c_a, step, up_tile, c_b, P, x_img + p0, panel + (size_t)blk * c_in * OCB,
+                                b4, mr, y_img + (size_t)oc0 * P + p0, P);
+                    continue;
+                }
+                kernel_4xnv(c_a, step, up_tile, c_b, P, x_img + p0, panel + (size_t)blk * c_in * OCB,
+                            b4, mr, tile, step);
+                epilogue_store(ep, tile, step, g->y, y_img_off + (size_t)oc0 * P + p0, P, mr, step);
+            }
+            continue;
+        }
+        int32_t p0 = p_lo;
+        for (; p0 + VL <= P; p0 += VL) {
+            for (int32_t blk = 0; blk < n_blk; blk++) {
+                const int32_t oc0 = blk * OCB;
+                const int32_t mr = oc0 + OCB <= c_out ? OCB : c_out - oc0;
+                float b4[OCB];
+                for (int32_t i = 0; i < OCB; i++)
+                    b4[i] = (bias_or_null && i < mr) ? bias_or_null[oc0 + i] : 0.0f;
+                if (!ep) {
+                    kernel_4x1(c_a, step, up_tile + (p0 - p_lo), c_b, P, x_img + p0,
+                               panel + (size_t)blk * c_in * OCB, b4, mr, y_img + (size_t)oc0 * P + p0, P);
+                    continue;
+                }
+                kernel_4x1(c_a, step, up_tile + (p0 - p_lo), c_b, P, x_img + p0,
+                           panel + (size_t)blk * c_in * OCB, b4, mr, tile, VL);
+                epilogue_store(ep, tile, VL, g->y, y_img_off + (size_t)oc0 * P + p0, P, mr, VL);
+            }
+        }
+        /* 나머지 픽셀 (P % VL): 스칼라 */
+        for (; p0 < P; p0++) {
+            for (int32_t oc = 0; oc < c_out; oc++) {
+                const float* a = panel + (size_t)(oc / OCB) * c_in * OCB + (oc % OCB);
+                float acc = bias_or_null ? bias_or_null[oc] : 0.0f;
+                for (int32_t ic = 0; ic < c_a; ic++)
+                    acc += a[ic * OCB] * up_tile[(size_t)ic * step + (p0 - p_lo)];
+                for (int32_t ic = c_a; ic < c_in; ic++)
+                    acc += a[ic * OCB] * x_img[(size_t)(ic - c_a) * P + p0];
+                y_img[(size_t)oc * P + p0] = conv2d_epilogue_apply(ep, acc, y_img_off + (size_t)oc * P + p0);
+            }
+        }
+    }
+}
+
+void conv2d_1x1_f32_packed(
+    const float* x, int32_t n, int32_t c_in, int32_t h, int32_t w,
+    const float* panel, int32_t c_out,
+    const float* bias_or_null,
+    const conv2d_epilogue_t* ep,
+    float* y, size_t x_img, size_t y_img)
+{
+    const int32_t P = h * w;
+    conv1x1_args_t g = { x, c_in, P, panel, c_out, bias_or_null, ep, y,
+                         x_img, y_img, NULL, 0, w, 0 };
+    thread_pool_run(n * (P / (NV * VL) + 1), conv1x1_range, &g);
+}
+
+int conv2d_1x1_up_concat_f32_packed(
+    const conv2d_up_concat_t* v, int32_t n, int32_t c_in, int32_t h, int32_t w,
+    const float* panel, int32_t c_out,
+    const float* bias_or_null,
+    const conv2d_epilogue_t* ep,
+    float* y, size_t y_img_stride)
+{
+    if (v->c_up > CONV2D_1X1_UP_MAX_C || v->c_up > c_in || (h & 1) || (w & 1)) return 0;
+    const int32_t P = h * w;
+    conv1x1_args_t g = { v->x, c_in, P, panel, c_out, bias_or_null, ep, y,
+                         v->x_img, y_img_stride, v->up, v->c_up, w, v->up_img };
+    thread_pool_run(n * (P / (NV * VL) + 1), conv1x1_range, &g);
+    return 1;
+}
+
+const float* conv2d_1x1_unpack_panel(const int8_t* wt, float scale, int32_t c_out, int32_t c_in)
+{
+    const int32_t n_blk = (c_out + OCB - 1) / OCB;
+    if ((size_t)n_blk * OCB * (size_t)c_in > sizeof(w1x1_panel) / sizeof(float)) return NULL;
+
+    /* oc 블록 단위 int8 → float (scale 포함) 1회 복원, 끝 블록은 0 패딩 */
+    for (int32_t blk = 0; blk < n_blk; blk++) {
+        float* a = w1x1_panel + (size_t)blk * c_in * OCB;
+        for (int32_t i = 0; i < OCB; i++) {
+            const int32_t oc = blk * OCB + i;
+            const int8_t* wr = wt + (size_t)oc * c_in;
+            for (int32_t ic = 0; ic < c_in; ic++)
+                a[ic * OCB + i] = oc < c_out ? (float)wr[ic] * scale : 0.0f;
+        }
+    }
+    return w1x1_panel;
+}
+
+int conv2d_1x1_w8_nchw_f32(
+    const float* x, int32_t n, int32_t c_in, int32_t h, int32_t w,
+    const int8_t* wt, float scale, int32_t c_out,
+    const float* bias_or_null,
+    const conv2d_epilogue_t* ep,
+    float* y, size_t x_img, size_t y_img)
+{
+    const float* panel = conv2d_1x1_unpack_panel(wt, scale, c_out, c_in);
+    if (!panel) return 0;
+    conv2d_1x1_f32_packed(x, n, c_in, h, w, panel, c_out, bias_or_null, ep, y, x_img, y_img);
+    return 1;
+}
+
+#endif /* CONV2D_1X1_SIMD */
@@ -0,0 +1,77 @@
+#ifndef CONV2D_1X1_H
+#define CONV2D_1X1_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "conv2d_epilogue.h"
+
+/* 1x1 / stride 1 / pad 0 W8A32 conv SIMD 커널 (빌드 타임 선택).
+ * y[oc][p] = bias[oc] + sum_ic (w[oc][ic]*scale) * x[ic][p]
+ * - 가중치: 패널 [c_out/4][c_in][4] (FP32, scale 포함) = GEMM A 패널(MR=4)과 같은 배치.
+ *   weight_pack이 로드 시 만들어 두면 그대로, 없으면 호출마다 oc 블록 단위로 1회 복원
+ * - 누적: 4 oc x (NV*VL) 픽셀을 벡터 레지스터에 유지, 가중치는 broadcast
+ * - epilogue(ep): 누적 레지스터를 스택 타일(L1)에 내린 뒤 SiLU/residual 적용하며 y에 1회 씀 (NULL이면 바로 y)
+ * - AVX2+FMA (-mavx2 -mfma / -march=native) 또는 FMA 있는 NEON (AArch64, ARMv7 VFPv4: vfmaq_f32), 그 외는 CONV2D_1X1_SIMD=0
+ * - 알고리즘 DIRECT(reference)에서는 dispatch가 쓰지 않음 */
+#if defined(__AVX2__) && defined(__FMA__)
+#define CONV2D_1X1_SIMD 1
+#define CONV2D_1X1_ISA "avx2+fma"
+#elif defined(__ARM_NEON) && (defined(__aarch64__) || defined(__ARM_FEATURE_FMA))
+#define CONV2D_1X1_SIMD 1
+#define CONV2D_1X1_ISA "neon"
+#else
+#define CONV2D_1X1_SIMD 0
+#define CONV2D_1X1_ISA "scalar"
+#endif
+
+#define CONV2D_1X1_OCB 4
+
+/* 패널 버퍼 크기 (c_in * c_out 상한, BSS). 초과 시 0 반환 → 호출 측 스칼라 경로 */
+#ifndef CONV2D_1X1_MAX_W
+#define CONV2D_1X1_MAX_W (512 * 256)
+#endif
+
+/* 가상 업샘플 concat 입력의 업샘플 채널 상한 (스레드별 strip 타일 [c_up][NV*VL], BSS) */
+#ifndef CONV2D_1X1_UP_MAX_C
+#define CONV2D_1X1_UP_MAX_C 256
+#endif
+
+/* 가상 concat 입력 [up2x(up) | x]: 채널 [0, c_up) = up (h/2 × w/2)의 nearest 2x, [c_up, c_in) = x (h × w).
+ * 업샘플·concat 버퍼 없이 소비 1x1 conv가 index halving으로 직접 읽음.
+ * up_img / x_img: 이미지 간격 (원소) → 다른 concat 버퍼의 채널 구간 뷰도 그대로 */
+typedef struct {
+    const float* up; int32_t c_up; size_t up_img;
+    const float* x; size_t x_img;
+} conv2d_up_concat_t;
+
+#if CONV2D_1X1_SIMD
+/** 1x1/s1/p0 conv, 미리 복원된 패널 사용. x_img / y_img: 이미지 간격 (원소, 밀집이면 c*h*w) */
+void conv2d_1x1_f32_packed(
+    const float* x, int32_t n, int32_t c_in, int32_t h, int32_t w,
+    const float* panel, int32_t c_out,
+    const float* bias_or_null,
+    const conv2d_epilogue_t* ep,
+    float* y, size_t x_img, size_t y_img);
+
+/** 입력이 가상 concat (conv2d_up_concat_t)인 1x1 conv. strip마다 업샘플 채널을 L1 타일로 모아 모든 oc 블록에 재사용.
+ *  y 이미지 간격 y_img_stride (원소). 1 처리 완료, 0 미지원 (c_up > CONV2D_1X1_UP_MAX_C, h/w 홀수) */
+int conv2d_1x1_up_concat_f32_packed(
+    const conv2d_up_concat_t* v, int32_t n, int32_t c_in, int32_t h, int32_t w,
+    const float* panel, int32_t c_out,
+    const float* bias_or_null,
+    const conv2d_epilogue_t* ep,
+    float* y, size_t y_img_stride);
+
+/** INT8 가중치를 BSS 패널로 복원 (다음 호출 전까지 유효). NULL이면 패널 크기 초과 */
+const float* conv2d_1x1_unpack_panel(const int8_t* wt, float scale, int32_t c_out, int32_t c_in);
+
+/** 1x1/s1/p0 W8 conv (패널을 BSS에 복원 후 실행). 1 처리 완료, 0 미지원(패널 크기 초과) */
+int conv2d_1x1_w8_nchw_f32(
+    const float* x, int32_t n, int32_t c_in, int32_t h, int32_t w,
+    const int8_t* wt, float scale, int32_t c_out,
+    const float* bias_or_null,
+    const conv2d_epilogue_t* ep,
+    float* y, size_t x_img, size_t y_img);
+#endif
+
+#endif // CONV2D_1X1_H
@@ -0,0 +1,26 @@
+#ifndef CONV2D_EPILOGUE_H
+#define CONV2D_EPILOGUE_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "silu.h"
+
+/* conv 출력 epilogue: 누적값(bias 포함)을 y에 쓰는 순간 적용 → SiLU/residual 별도 패스 없음.
+ * y = act(acc) [+ residual]. residual은 y와 같은 배치 (n, c_out, h_out, w_out, 이미지 간격도 y와 같음)이고 y와 같은 주소 가능
+ * (커널은 각 출력 원소를 마지막에 한 번만 쓰고, 그 직전에 같은 원소의 residual만 읽음). */
+typedef struct {
+    int32_t silu;            /* 1이면 SiLU */
+    const float* residual;   /* NULL이면 없음 */
+    int32_t silu_fast;       /* 내부용: conv2d 진입점이 silu_get_mode()로 채움 (호출자는 0) */
+} conv2d_epilogue_t;
+
+/** idx = y 기준 원소 오프셋 (residual도 같은 오프셋). ep NULL이면 v 그대로 */
+static inline float conv2d_epilogue_apply(const conv2d_epilogue_t* ep, float v, size_t idx)
+{
+    if (!ep) return v;
+    if (ep->silu) v = ep->silu_fast ? silu_fast_f32(v) : silu_f32(v);
+    if (ep->residual) v = ep->residual[idx] + v;
+    return v;
+}
+
+#endif // CONV2D_EPILOGUE_H
@@ -0,0 +1,227 @@
+#include "conv2d_gemm.h"
+#include "../utils/thread_pool.h"
+#include <stdint.h>
+
+#define MR CONV2D_GEMM_MR
+#define NR CONV2D_GEMM_NR
+#define KC CONV2D_GEMM_KC
+#define NC CONV2D_GEMM_NC
+#define MC CONV2D_GEMM_MC
+
+#if (NC % NR) != 0
+#error "CONV2D_GEMM_NC must be a multiple of CONV2D_GEMM_NR"
+#endif
+#if (MC % MR) != 0
+#error "CONV2D_GEMM_MC must be a multiple of CONV2D_GEMM_MR"
+#endif
+
+/* im2col B 블록: strip(NR열)마다 [kc][NR] 연속. BSS, 스레드별 (64KB @ KC=256, NC=64) */
+static float gemm_b_buf[YOLO_MAX_THREADS][KC * NC];
+/* K 블록 간 부분합 [MC][NC]. y에는 마지막 K 블록에서 epilogue 적용값만 1회 씀 (residual이 y와 같아도 안전) */
+static float gemm_c_buf[YOLO_MAX_THREADS][MC * NC];
+
+size_t conv2d_gemm_packed_size(int32_t c_out, int32_t c_in, int32_t k_h, int32_t k_w) {
+    const size_t panels = (size_t)((c_out + MR - 1) / MR);
+    return panels * (size_t)c_in * (size_t)k_h * (size_t)k_w * MR;
+}
+
+void conv2d_gemm_pack_weights(
+    const void* w, float scale, int is_int8,
+    int32_t c_out, int32_t c_in, int32_t k_h, int32_t k_w,
+    float* dst)
+{
+    const int32_t K = c_in * k_h * k_w;
+    for (int32_t oc0 = 0; oc0 < c_out; oc0 += MR) {
+        float* panel = dst + (size_t)oc0 * K;  /* (oc0/MR) * K * MR */
+        for (int32_t k = 0; k < K; k++) {
+            for (int32_t i = 0; i < MR; i++) {
+                const int32_t oc = oc0 + i;
+                float v = 0.0f;
+                if (oc < c_out) {
+                    if (is_int8)
+                        v = (float)((const int8_t*)w)[(size_t)oc * K + k] * scale;
+                    else
+                        v = ((const float*)w)[(size_t)oc * K + k];
+                }
+                panel[k * MR + i] = v;
+            }
+        }
+    }
+}
+
+/* MR x NR 마이크로 커널: acc(레지스터) += A[kc][MR] * B[kc][ldb] */
+static inline void gemm_kernel(int32_t kc, const float* a, const float* b, int32_t ldb,
+                               float acc[MR][NR])
+{
+    float c[MR][NR];
+    for (int32_t i = 0; i < MR; i++)
+        for (int32_t j = 0; j < NR; j++)
+            c[i][j] = acc[i][j];
+    for (int32_t k = 0; k < kc; k++) {
+        const float* bk = b + k * ldb;
+        for (int32_t i = 0; i < MR; i++) {
+            const float ai = a[k * MR + i];
+            for (int32_t j = 0; j < NR; j++)
+                c[i][j] += ai * bk[j];
+        }
+    }
+    for (int32_t i = 0; i < MR; i++)
+        for (int32_t j = 0; j < NR; j++)
+            acc[i][j] = c[i][j];
+}
+
+/* im2col: B[k0..k0+kc) x [p0..p0+nc) → gemm_b_buf (패딩/경계는 0) */
+static void pack_b_block(
+    const float* x_img, int32_t h_in, int32_t w_in,
+    int32_t k_h, int32_t k_w,
+    int32_t stride_h, int32_t stride_w, int32_t pad_h, int32_t pad_w,
+    int32_t w_out, int32_t p0, int32_t nc, int32_t k0, int32_t kc,
+    float* dst)
+{
+    int32_t ih0[NC], iw0[NC];
+    for (int32_t j = 0; j < nc; j++) {
+        const int32_t p = p0 + j;
+        ih0[j] = (p / w_out) * stride_h - pad_h;
+        iw0[j] = (p % w_out) * stride_w - pad_w;
+    }
+    const int32_t ksz = k_h * k_w;
+    const int32_t n_strips = (nc + NR - 1) / NR;
+    for (int32_t kk = 0; kk < kc; kk++) {
+        const int32_t k = k0 + kk;
+        const int32_t ic = k / ksz;
+        const int32_t r = k - ic * ksz;
+        const int32_t kh = r / k_w;
+        const int32_t kw = r - kh * k_w;
+        const float* x_ch = x_img + (size_t)ic * h_in * w_in;
+        for (int32_t s = 0; s < n_strips; s++) {
+            float* d = dst + (size_t)s * kc * NR + kk * NR;
+            for (int32_t jj = 0; jj < NR; jj++) {
+                const int32_t j = s * NR + jj;
+                float v = 0.0f;
+                if (j < nc) {
+                    const int32_t ih = ih0[j] + kh;
+                    const int32_t iw = iw0[j] + kw;
+                    if ((uint32_t)ih < (uint32_t)h_in && (uint32_t)iw < (uint32_t)w_in)
+                        v = x_ch[ih * w_in + iw];
+                }
+                d[jj] = v;
+            }
+        }
+    }
+}
+
+/* thread_pool 작업: item = (ni, p0) 픽셀 블록. 블록마다 전체 K·oc를 한 스레드가 계산 */
+typedef struct {
+    const float* x; int32_t c_in, h_in, w_in;
+    const float* w_packed; int32_t c_out, k_h, k_w;
+    const float* bias_or_null;
+    int32_t stride_h, stride_w, pad_h, pad_w;
+    const conv2d_epilogue_t* ep;
+    float* y; int32_t h_out, w_out;
+    size_t x_img, y_img;                 /* 이미지 간격 (원소) */
+} gemm_args_t;
+
+static void gemm_range(void* ctx, int32_t it0, int32_t it1, int32_t tid)
+{
+    const gemm_args_t* g = (const gemm_args_t*)ctx;
+    const int32_t c_in = g->c_in, h_in = g->h_in, w_in = g->w_in;
+    const int32_t c_out = g->c_out, k_h = g->k_h, k_w = g->k_w;
+    const int32_t stride_h = g->stride_h, stride_w = g->stride_w, pad_h = g->pad_h, pad_w = g->pad_w;
+    const int32_t h_out = g->h_out, w_out = g->w_out;
+    const float* w_packed = g->w_packed;
+    const float* bias_or_null = g->bias_or_null;
+    const conv2d_epilogue_t* ep = g->ep;
+    float* b_buf = gemm_b_buf[tid];
+    float* c_buf = gemm_c_buf[tid];
+    const int32_t K = c_in * k_h * k_w;
+    const int32_t P = h_out * w_out;
+    /* 1x1/s1/p0: B[k][p] == x[ic][p] → im2col 없이 x를 직접 스트리밍 */
+    const int32_t implicit_b = (k_h == 1 && k_w == 1 && stride_h == 1 && stride_w == 1 &&
+                                pad_h == 0 && pad_w == 0 && h_in == h_out && w_in == w_out);
+
+    const int32_t n_pblk = (P + NC - 1) / NC;
+
+    for (int32_t it = it0; it < it1; it++) {
+        const int32_t ni = it / n_pblk;
+        const int32_t p0 = (it % n_pblk) * NC;
+        const float* x_img = g->x + (size_t)ni * g->x_img;
+        const size_t y_img_off = (size_t)ni * g->y_img;
+        float* y_img = g->y + y_img_off;
+
+        const int32_t nc = p0 + NC <= P ? NC : P - p0;
+        const int32_t n_strips = (nc + NR - 1) / NR;
+
+        /* oc를 MC 단위로 (부분합 버퍼 크기). c_out <= MC면 1회 → B 패킹도 K 블록당 1회 */
+        for (int32_t oc_lo = 0; oc_lo < c_out; oc_lo += MC) {
+            const int32_t oc_hi = oc_lo + MC <= c_out ? oc_lo + MC : c_out;
+
+            for (int32_t k0 = 0; k0 < K; k0 += KC) {
+                const int32_t kc = k0 + KC <= K ? KC : K - k0;
+                const int32_t first = (k0 == 0);
+                const int32_t last = (k0 + kc == K);
+
+                if (!implicit_b || nc % NR != 0)
+                    pack_b_block(x_img, h_in, w_in, k_h, k_w, stride_h, stride_w, pad_h, pad_w,
+                                 w_out, p0, nc, k0, kc, b_buf);
+
+                for (int32_t oc0 = oc_lo; oc0 < oc_hi; oc0 += MR) {
+                    const int32_t mr = oc0 + MR <= c_out ? MR : c_out - oc0;
+                    const float* a = w_packed + (size_t)oc0 * K + (size_t)k0 * MR;
+
+                    for (int32_t s = 0; s < n_strips; s++) {
+                        const int32_t pj = p0 + s * NR;
+                        const int32_t nr = pj + NR <= p0 + nc ? NR : p0 + nc - pj;
+                        float* c_row0 = c_buf + (size_t)(oc0 - oc_lo) * NC + (pj - p0);
+                        float acc[MR][NR];
+
+                        /* 누적 초기값: 첫 K 블록은 bias, 이후는 c_buf의 부분합 */
+                        for (int32_t i = 0; i < MR; i++) {
+                            const int32_t oc = oc0 + i;
+                            for (int32_t j = 0; j < NR; j++) {
+                                if (i >= mr || j >= nr)
+                                    acc[i][j] = 0.0f;
+                                else if (first)
+                                    acc[i][j] = bias_or_null ? bias_or_null[oc] : 0.0f;
+                                else
+                                    acc[i][j] = c_row0[i * NC + j];
+                            }
+                        }
+
+                        if (implicit_b && nc % NR == 0)
+                            gemm_kernel(kc, a, x_img + (size_t)k0 * P + pj, P, acc);
+                        else
+                            gemm_kernel(kc, a, b_buf + (size_t)s * kc * NR, NR, acc);
+
+                        for (int32_t i = 0; i < mr; i++) {
+                            if (last) {
+                                const size_t y_off = y_img_off + (size_t)(oc0 + i) * P + pj;
+                                float* y_row = y_img + (size_t)(oc0 + i) * P + pj;
+                                for (int32_t j = 0; j < nr; j++)
+                                    y_row[j] = conv2d_epilogue_apply(ep, acc[i][j], y_off + j);
+                            } else {
+                                for (int32_t j = 0; j < nr; j++)
+                                    c_row0[i * NC + j] = acc[i][j];
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+
+void conv2d_gemm_nchw_f32(
+    const float* x, int32_t n, int32_t c_in, int32_t h_in, int32_t w_in,
+    const float* w_packed, int32_t c_out, int32_t k_h, int32_t k_w,
+    const float* bias_or_null,
+    int32_t stride_h, int32_t stride_w,
+    int32_t pad_h, int32_t pad_w,
+    const conv2d_epilogue_t* ep,
+    float* y, int32_t h_out, int32_t w_out,
+    size_t x_img, size_t y_img)
+{
+    gemm_args_t g = { x, c_in, h_in, w_in, w_packed, c_out, k_h, k_w, bias_or_null,
+                      stride_h, stride_w, pad_h, pad_w, ep, y, h_out, w_out, x_img, y_img };
+    const int32_t n_pblk = (h_out * w_out + NC - 1) / NC;
+    thread_pool_run(n * n_pblk, gemm_range, &g);
+}
@@ -0,0 +1,53 @@
+#ifndef CONV2D_GEMM_H
+#define CONV2D_GEMM_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "conv2d_epilogue.h"
+
+/* im2col + packed GEMM conv.
+ * y[oc][p] = bias[oc] + sum_k A[oc][k] * B[k][p]   (k = ic*kh*kw, p = oh*w_out + ow)
+ * - A: 가중치 패널 [ceil(c_out/MR)][K][MR] (FP32, INT8이면 scale까지 곱해 둠)
+ * - B: 입력을 KC x NC 블록 단위로 im2col 패킹 (1x1 s1 p0는 x를 그대로 B로 사용)
+ * - 마이크로 커널: MR x NR 출력을 레지스터 누적, K 블록 간 부분합은 스레드별 버퍼
+ * - y는 마지막 K 블록에서 epilogue(SiLU/residual) 적용값으로 1회만 씀 */
+#ifndef CONV2D_GEMM_MR
+#define CONV2D_GEMM_MR 4
+#endif
+#ifndef CONV2D_GEMM_NR
+#define CONV2D_GEMM_NR 8
+#endif
+/* K 블록 (B 패널 깊이) */
+#ifndef CONV2D_GEMM_KC
+#define CONV2D_GEMM_KC 256
+#endif
+/* 픽셀 블록 (NR의 배수) */
+#ifndef CONV2D_GEMM_NC
+#define CONV2D_GEMM_NC 64
+#endif
+/* 부분합 버퍼의 oc 수 (MR의 배수). c_out이 더 크면 oc 구간마다 B를 다시 패킹 */
+#ifndef CONV2D_GEMM_MC
+#define CONV2D_GEMM_MC 256
+#endif
+
+/** 패킹된 가중치 크기 (float 개수) */
+size_t conv2d_gemm_packed_size(int32_t c_out, int32_t c_in, int32_t k_h, int32_t k_w);
+
+/** OIHW 가중치(float* 또는 int8_t*+scale) → A 패널. dst는 conv2d_gemm_packed_size() 개 float */
+void conv2d_gemm_pack_weights(
+    const void* w, float scale, int is_int8,
+    int32_t c_out, int32_t c_in, int32_t k_h, int32_t k_w,
+    float* dst);
+
+/** 패킹된 가중치로 conv 실행 (groups=1). ep NULL 가능 */
+void conv2d_gemm_nchw_f32(
+    const float* x, int32_t n, int32_t c_in, int32_t h_in, int32_t w_in,
+    const float* w_packed, int32_t c_out, int32_t k_h, int32_t k_w,
+    const float* bias_or_null,
+    int32_t stride_h, int32_t stride_w,
+    int32_t pad_h, int32_t pad_w,
+    const conv2d_epilogue_t* ep,
+    float* y, int32_t h_out, int32_t w_out,
+    size_t x_img, size_t y_img);
+
+#endif // CONV2D_GEMM_H
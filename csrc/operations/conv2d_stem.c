@@ -0,0 +1,196 @@
+#include "conv2d_stem.h"
+#include "conv2d_1x1.h"
+#include "../utils/thread_pool.h"
+#include <stdint.h>
+
+/* ISA 선택은 conv2d_1x1과 같음 (CONV2D_1X1_SIMD). 스칼라는 VL 1 "벡터" */
+#if CONV2D_1X1_SIMD && defined(__AVX2__)
+#include <immintrin.h>
+typedef __m256 vf_t;
+#define VL 8
+#define NV 3                                   /* 4 oc x 24 열 = 12 누적 레지스터 */
+#define V_LOAD(p)        _mm256_loadu_ps(p)
+#define V_STORE(p, v)    _mm256_storeu_ps((p), (v))
+#define V_SET1(s)        _mm256_set1_ps(s)
+#define V_FMA(acc, a, b) _mm256_fmadd_ps((a), (b), (acc))
+#elif CONV2D_1X1_SIMD
+#include <arm_neon.h>
+typedef float32x4_t vf_t;
+#define VL 4
+#define NV 4                                   /* 4 oc x 16 열 = 16 누적 레지스터 */
+#define V_LOAD(p)        vld1q_f32(p)
+#define V_STORE(p, v)    vst1q_f32((p), (v))
+#define V_SET1(s)        vdupq_n_f32(s)
+#define V_FMA(acc, a, b) vfmaq_f32((acc), (a), (b))
+#else
+typedef float vf_t;
+#define VL 1
+#define NV 4                                   /* 4 oc x 4 열 = 16 누적 (FPU 레지스터) */
+#define V_LOAD(p)        (*(p))
+#define V_STORE(p, v)    (*(p) = (v))
+#define V_SET1(s)        (s)
+#define V_FMA(acc, a, b) ((acc) + (a) * (b))
+#endif
+
+#define OCB 4
+#define CB (NV * VL)                           /* 커널 한 번의 출력 열 수 */
+#define K 6
+/* 분리 행 길이: strip 열 + 탭 오프셋 a(0..2) + 마지막 블록 여유 (블록 끝 열까지 0 채움) */
+#define SLEN (CONV2D_STEM_TW + 2 + CB)
+
+/* 누적 레지스터를 명시적으로 나열 (conv2d_1x1과 같은 방식) */
+#if NV == 3
+#define ACC_DECL(i)   vf_t c##i##0 = b##i, c##i##1 = b##i, c##i##2 = b##i
+#define ACC_FMA(i, w) c##i##0 = V_FMA(c##i##0, w, x0); c##i##1 = V_FMA(c##i##1, w, x1); \
+                      c##i##2 = V_FMA(c##i##2, w, x2)
+#define X_LOAD(xr)    const vf_t x0 = V_LOAD(xr), x1 = V_LOAD(xr + VL), x2 = V_LOAD(xr + 2 * VL)
+#define ACC_STORE(i, t) V_STORE(t, c##i##0); V_STORE(t + VL, c##i##1); V_STORE(t + 2 * VL, c##i##2)
+#else
+#define ACC_DECL(i)   vf_t c##i##0 = b##i, c##i##1 = b##i, c##i##2 = b##i, c##i##3 = b##i
+#define ACC_FMA(i, w) c##i##0 = V_FMA(c##i##0, w, x0); c##i##1 = V_FMA(c##i##1, w, x1); \
+                      c##i##2 = V_FMA(c##i##2, w, x2); c##i##3 = V_FMA(c##i##3, w, x3)
+#define X_LOAD(xr)    const vf_t x0 = V_LOAD(xr), x1 = V_LOAD(xr + VL), \
+                                 x2 = V_LOAD(xr + 2 * VL), x3 = V_LOAD(xr + 3 * VL)
+#define ACC_STORE(i, t) V_STORE(t, c##i##0); V_STORE(t + VL, c##i##1); \
+                        V_STORE(t + 2 * VL, c##i##2); V_STORE(t + 3 * VL, c##i##3)
+#endif
+
+/* 스레드별 분리 행 [(c*6 + kh)*2 + q][j] = x[c][2*oh - pad_h + kh][2*(ow0 - pad_w/2 + j) + q] */
+static float stem_s2d_buf[YOLO_MAX_THREADS][CONV2D_STEM_MAX_C * K * 2][SLEN];
+
+typedef struct {
+    const float* x; int32_t c_in, h_in, w_in;
+    const float* w; const float* bias;
+    int32_t c_out, pad_h, pad_w;
+    const conv2d_epilogue_t* ep;
+    float* y; int32_t h_out, w_out, n_strips;
+} stem_args_t;
+
+/* 입력 분리 행 c_in*6개 → 4 oc x CB 열 (tile [4][CB]). 탭 (kh, kw = 2a + q)은 분리 행 q의 열 j + a */
+static void stem_kernel(const float (*s2d)[SLEN], int32_t n_rows, int32_t j0, const float* wp,
+                        const float* bias4, float* tile)
+{
+    const vf_t b0 = V_SET1(bias4[0]), b1 = V_SET1(bias4[1]);
+    const vf_t b2 = V_SET1(bias4[2]), b3 = V_SET1(bias4[3]);
+    ACC_DECL(0); ACC_DECL(1); ACC_DECL(2); ACC_DECL(3);
+    for (int32_t r = 0; r < n_rows; r++) {
+        const float* const even = s2d[2 * r] + j0;
+        const float* const odd = s2d[2 * r + 1] + j0;
+        const float* wr = wp + (size_t)r * K * OCB;
+        for (int32_t a = 0; a < 3; a++) {
+            for (int32_t q = 0; q < 2; q++, wr += OCB) {
+                const float* xr = (q ? odd : even) + a;
+                X_LOAD(xr);
+                const vf_t w0 = V_SET1(wr[0]);
+                ACC_FMA(0, w0);
+                const vf_t w1 = V_SET1(wr[1]);
+                ACC_FMA(1, w1);
+                const vf_t w2 = V_SET1(wr[2]);
+                ACC_FMA(2, w2);
+                const vf_t w3 = V_SET1(wr[3]);
+                ACC_FMA(3, w3);
+            }
+        }
+    }
+    ACC_STORE(0, tile);
+    ACC_STORE(1, (tile + CB));
+    ACC_STORE(2, (tile + 2 * CB));
+    ACC_STORE(3, (tile + 3 * CB));
+}
+
+/* thread_pool 작업: item = (ni, oh, strip), strip = CONV2D_STEM_TW 출력 열 */
+static void stem_range(void* ctx, int32_t it0, int32_t it1, int32_t tid)
+{
+    const stem_args_t* g = (const stem_args_t*)ctx;
+    float (*s2d)[SLEN] = stem_s2d_buf[tid];
+    const int32_t n_rows = g->c_in * K;
+    const int32_t mw = g->pad_w / 2;
+    const size_t x_img = (size_t)g->c_in * g->h_in * g->w_in;
+    const size_t y_ch = (size_t)g->h_out * g->w_out;
+    float tile[OCB * CB];
+
+    for (int32_t it = it0; it < it1; it++) {
+        const int32_t strip = it % g->n_strips;
+        const int32_t oh = (it / g->n_strips) % g->h_out;
+        const int32_t ni = it / g->n_strips / g->h_out;
+        const int32_t ow0 = strip * CONV2D_STEM_TW;
+        const int32_t tw = g->w_out - ow0 < CONV2D_STEM_TW ? g->w_out - ow0 : CONV2D_STEM_TW;
+        const int32_t fill = (tw + CB - 1) / CB * CB + 2;   /* 마지막 블록이 읽는 열까지 */
+
+        /* space-to-depth: 입력 밖(pad)은 0 */
+        for (int32_t r = 0; r < n_rows; r++) {
+            const int32_t c = r / K, ih = 2 * oh - g->pad_h + r % K;
+            const int32_t row_ok = (uint32_t)ih < (uint32_t)g->h_in;
+            const float* row = row_ok ? g->x + ni * x_img + ((size_t)c * g->h_in + ih) * g->w_in : NULL;
+            for (int32_t q = 0; q < 2; q++) {
+                float* d = s2d[2 * r + q];
+                for (int32_t j = 0; j < fill; j++) {
+                    const int32_t col = 2 * (ow0 - mw + j) + q;
+                    d[j] = (row_ok && (uint32_t)col < (uint32_t)g->w_in) ? row[col] : 0.0f;
+                }
+            }
+        }
+
+        for (int32_t oc0 = 0; oc0 < g->c_out; oc0 += OCB) {
+            const int32_t mr = g->c_out - oc0 < OCB ? g->c_out - oc0 : OCB;
+            const float* wp = g->w + (size_t)(oc0 / OCB) * n_rows * K * OCB;
+            float bias4[OCB];   /* oc 끝 블록 0 패딩 */
+            for (int32_t i = 0; i < OCB; i++) bias4[i] = (g->bias && i < mr) ? g->bias[oc0 + i] : 0.0f;
+            for (int32_t j0 = 0; j0 < tw; j0 += CB) {
+                const int32_t cols = tw - j0 < CB ? tw - j0 : CB;
+                stem_kernel((const float (*)[SLEN])s2d, n_rows, j0, wp, bias4, tile);
+                for (int32_t i = 0; i < mr; i++) {
+                    const size_t off = (size_t)(ni * g->c_out + oc0 + i) * y_ch + (size_t)oh * g->w_out + ow0 + j0;
+                    float* yr = g->y + off;
+                    for (int32_t j = 0; j < cols; j++)
+                        yr[j] = conv2d_epilogue_apply(g->ep, tile[i * CB + j], off + (size_t)j);
+                }
+            }
+        }
+    }
+}
+
+int conv2d_stem_supported(int32_t c_in, int32_t c_out, int32_t k_h, int32_t k_w,
+                          int32_t stride_h, int32_t stride_w, int32_t pad_h, int32_t pad_w)
+{
+    return k_h == K && k_w == K && stride_h == 2 && stride_w == 2 &&
+           c_in >= 1 && c_in <= CONV2D_STEM_MAX_C && c_out >= 1 &&
+           pad_h >= 0 && pad_w >= 0 && (pad_w & 1) == 0;
+}
+
+size_t conv2d_stem_packed_size(int32_t c_out, int32_t c_in)
+{
+    return (size_t)((c_out + OCB - 1) / OCB) * OCB * (size_t)c_in * K * K;
+}
+
+/* OIHW → [oc/4][c][kh][kw][4] */
+void conv2d_stem_pack_weights(const void* w, float scale, int is_int8, int32_t c_out, int32_t c_in, float* dst)
+{
+    const int32_t c_out_pad = (c_out + OCB - 1) / OCB * OCB;
+    const int32_t ksz = c_in * K * K;
+    for (int32_t oc = 0; oc < c_out_pad; oc++) {
+        float* d = dst + (size_t)(oc / OCB) * ksz * OCB + oc % OCB;
+        for (int32_t k = 0; k < ksz; k++) {
+            float v = 0.0f;
+            if (oc < c_out) {
+                const size_t src = (size_t)oc * ksz + k;
+                v = is_int8 ? (float)((const int8_t*)w)[src] * scale : ((const float*)w)[src];
+            }
+            d[(size_t)k * OCB] = v;
+        }
+    }
+}
+
+void conv2d_stem_nchw_f32(
+    const float* x, int32_t n, int32_t c_in, int32_t h_in, int32_t w_in,
+    const float* w_stem, int32_t c_out,
+    const float* bias_or_null,
+    int32_t pad_h, int32_t pad_w,
+    const conv2d_epilogue_t* ep,
+    float* y, int32_t h_out, int32_t w_out)
+{
+    if (!w_stem || !conv2d_stem_supported(c_in, c_out, K, K, 2, 2, pad_h, pad_w)) return;
+    stem_args_t a = { x, c_in, h_in, w_in, w_stem, bias_or_null, c_out, pad_h, pad_w, ep, y, h_out, w_out,
+                      (w_out + CONV2D_STEM_TW - 1) / CONV2D_STEM_TW };
+    thread_pool_run(n * h_out * a.n_strips, stem_range, &a);
+}
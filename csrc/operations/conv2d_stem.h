@@ -0,0 +1,49 @@
+#ifndef CONV2D_STEM_H
+#define CONV2D_STEM_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "conv2d_epilogue.h"
+
+/* stem conv 전용 커널: 6x6 / stride 2 / 짝수 pad, c_in <= CONV2D_STEM_MAX_C (YOLOv5 L0: 3 → 16, 640 → 320).
+ * c_in = 3이면 일반 커널의 ic 루프가 거의 돌지 않고 입력 stride 2라 출력 폭 방향 벡터화가 안 됨.
+ * - space-to-depth: 출력 행 strip마다 입력 6행을 짝/홀 열로 분리해 스레드별 scratch에 둠
+ *   → kw = 2a+q 탭은 분리 행 q의 (ow + a) 연속 구간 (6x6/s2 = 12채널 3x3/s1)
+ * - 누적: 4 oc x (NV*VL) 출력 열을 레지스터에 유지, 가중치 broadcast (conv2d_1x1과 같은 구조)
+ * - AVX2+FMA / NEON / 스칼라 (VL 1) 같은 코드 (BARE_METAL 포함)
+ * - DIRECT 알고리즘은 reference라 이 커널을 쓰지 않음 (GEMM/WINOGRAD에서 사용) */
+
+/* 켜면 dispatch가 DIRECT 외 알고리즘에서 stem shape을 이 커널로 */
+#ifndef CONV2D_STEM
+#define CONV2D_STEM 1
+#endif
+#ifndef CONV2D_STEM_MAX_C
+#define CONV2D_STEM_MAX_C 4
+#endif
+/* 작업 단위 출력 열 수 (scratch 폭) */
+#ifndef CONV2D_STEM_TW
+#define CONV2D_STEM_TW 64
+#endif
+
+/** 이 커널이 처리하는 shape이면 1 */
+int conv2d_stem_supported(int32_t c_in, int32_t c_out, int32_t k_h, int32_t k_w,
+                          int32_t stride_h, int32_t stride_w, int32_t pad_h, int32_t pad_w);
+
+/** 패킹된 가중치 크기 (float 개수): [ceil(c_out/4)][c_in][6][6][4] */
+size_t conv2d_stem_packed_size(int32_t c_out, int32_t c_in);
+
+/** OIHW 6x6 가중치(float* 또는 int8_t*+scale) → stem 패널 (oc 끝 블록 0 패딩). dst는 conv2d_stem_packed_size() 개 float.
+ *  weight_pack_prepare(WEIGHT_PACK_PANEL)가 로드 시 1회 호출 */
+void conv2d_stem_pack_weights(const void* w, float scale, int is_int8, int32_t c_out, int32_t c_in, float* dst);
+
+/** 6x6/s2 stem conv. w_stem: conv2d_stem_pack_weights 패널. ep: 출력 저장 시 적용 (NULL 가능).
+ *  conv2d_stem_supported가 0인 shape은 아무것도 하지 않음 */
+void conv2d_stem_nchw_f32(
+    const float* x, int32_t n, int32_t c_in, int32_t h_in, int32_t w_in,
+    const float* w_stem, int32_t c_out,
+    const float* bias_or_null,
+    int32_t pad_h, int32_t pad_w,
+    const conv2d_epilogue_t* ep,
+    float* y, int32_t h_out, int32_t w_out);
+
+#endif // CONV2D_STEM_H
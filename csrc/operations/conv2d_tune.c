@@ -0,0 +1,145 @@
+#include "conv2d_tune.h"
+#include "conv2d.h"
+#include <stdlib.h>
+#include <string.h>
+#ifndef BARE_METAL
+#include <stdio.h>
+#endif
+
+#if CONV2D_TILE_H * CONV2D_TILE_W > CONV2D_TILE_MAX_PIX
+#error "CONV2D_TILE_H * CONV2D_TILE_W must not exceed CONV2D_TILE_MAX_PIX"
+#endif
+
+typedef struct {
+    conv2d_shape_t shape;
+    conv2d_blocking_t blk;
+} tune_entry_t;
+
+/* 항목 수가 작아 선형 탐색 (conv 호출당 1회, 29개 비교) */
+static tune_entry_t s_plan[CONV2D_TUNE_MAX];
+static int32_t s_num_plan;
+/* conv2d_tune_parse 실패 시 되돌릴 사본 (기존 항목 갱신도 복원) */
+static tune_entry_t s_plan_saved[CONV2D_TUNE_MAX];
+
+conv2d_blocking_t conv2d_blocking_default(void) {
+    conv2d_blocking_t b = { CONV2D_TILE_H, CONV2D_TILE_W, CONV2D_OC_BLOCK };
+    return b;
+}
+
+int conv2d_blocking_valid(const conv2d_blocking_t* b) {
+    return b && b->tile_h > 0 && b->tile_w > 0 && b->oc_block > 0 &&
+           (int32_t)b->tile_h * b->tile_w <= CONV2D_TILE_MAX_PIX && CONV2D_OC_BLOCK % b->oc_block == 0;
+}
+
+static int shape_eq(const conv2d_shape_t* a, const conv2d_shape_t* b) {
+    return a->c_in == b->c_in && a->c_out == b->c_out && a->k_h == b->k_h && a->k_w == b->k_w &&
+           a->stride_h == b->stride_h && a->stride_w == b->stride_w && a->h_out == b->h_out && a->w_out == b->w_out;
+}
+
+conv2d_blocking_t conv2d_tune_get(const conv2d_shape_t* s) {
+    for (int32_t i = 0; i < s_num_plan; i++) {
+        if (shape_eq(&s_plan[i].shape, s)) return s_plan[i].blk;
+    }
+    return conv2d_blocking_default();
+}
+
+int conv2d_tune_set(const conv2d_shape_t* s, const conv2d_blocking_t* b) {
+    if (!s || !conv2d_blocking_valid(b)) return -1;
+    for (int32_t i = 0; i < s_num_plan; i++) {
+        if (shape_eq(&s_plan[i].shape, s)) {
+            s_plan[i].blk = *b;
+            return 0;
+        }
+    }
+    if (s_num_plan >= CONV2D_TUNE_MAX) return -1;
+    s_plan[s_num_plan].shape = *s;
+    s_plan[s_num_plan].blk = *b;
+    s_num_plan++;
+    return 0;
+}
+
+void conv2d_tune_clear(void) {
+    memset(s_plan, 0, sizeof(s_plan));
+    s_num_plan = 0;
+}
+
+int32_t conv2d_tune_count(void) {
+    return s_num_plan;
+}
+
+/* 줄 하나: 정수 11개 (공백 구분), 빈 줄·'#' 주석은 0개 */
+static int32_t parse_line(const char* p, const char* end, long v[11]) {
+    int32_t n = 0;
+    while (p < end) {
+        while (p < end && (*p == ' ' || *p == '\t' || *p == '\r')) p++;
+        if (p >= end || *p == '#') break;
+        char buf[16];
+        size_t l = 0;
+        while (p < end && *p != ' ' && *p != '\t' && *p != '\r' && l + 1 < sizeof(buf)) buf[l++] = *p++;
+        buf[l] = '\0';
+        char* e;
+        const long x = strtol(buf, &e, 10);
+        if (*e != '\0' || n >= 11) return -1;
+        v[n++] = x;
+    }
+    return n;
+}
+
+int32_t conv2d_tune_parse(const char* text, size_t len) {
+    const char* p = text;
+    const char* end = text + len;
+    const int32_t num_saved = s_num_plan;
+    if (!text) return -1;
+    memcpy(s_plan_saved, s_plan, sizeof(s_plan));
+    while (p < end) {
+        const char* eol = memchr(p, '\n', (size_t)(end - p));
+        if (!eol) eol = end;
+        long v[11] = { 0 };
+        const int32_t n = parse_line(p, eol, v);
+        if (n != 0) {
+            int ok = n == 11;
+            for (int32_t i = 0; ok && i < 11; i++) ok = v[i] > 0 && v[i] <= 32767;
+            const conv2d_shape_t s = { (int16_t)v[0], (int16_t)v[1], (int16_t)v[2], (int16_t)v[3],
+                                       (int16_t)v[4], (int16_t)v[5], (int16_t)v[6], (int16_t)v[7] };
+            const conv2d_blocking_t b = { (int16_t)v[8], (int16_t)v[9], (int16_t)v[10] };
+            if (!ok || conv2d_tune_set(&s, &b) != 0) {
+                memcpy(s_plan, s_plan_saved, sizeof(s_plan));
+                s_num_plan = num_saved;
+                return -1;
+            }
+        }
+        p = eol + 1;
+    }
+    return s_num_plan;
+}
+
+#ifndef BARE_METAL
+int32_t conv2d_tune_load(const char* path) {
+    FILE* f = fopen(path, "rb");
+    if (!f) return -1;
+    char* buf = NULL;
+    long len = -1;
+    if (fseek(f, 0, SEEK_END) == 0) len = ftell(f);
+    if (len >= 0 && fseek(f, 0, SEEK_SET) == 0) buf = (char*)malloc((size_t)len + 1);
+    int32_t r = -1;
+    if (buf && fread(buf, 1, (size_t)len, f) == (size_t)len) r = conv2d_tune_parse(buf, (size_t)len);
+    free(buf);
+    fclose(f);
+    return r;
+}
+
+int conv2d_tune_save(const char* path) {
+    FILE* f = fopen(path, "w");
+    if (!f) return -1;
+    fprintf(f, "# conv2d direct blocking plan (bench --tune). max pix %d, OC_BLOCK %d\n",
+            CONV2D_TILE_MAX_PIX, CONV2D_OC_BLOCK);
+    fprintf(f, "# c_in c_out k_h k_w stride_h stride_w h_out w_out tile_h tile_w oc_block\n");
+    for (int32_t i = 0; i < s_num_plan; i++) {
+        const conv2d_shape_t* s = &s_plan[i].shape;
+        const conv2d_blocking_t* b = &s_plan[i].blk;
+        fprintf(f, "%d %d %d %d %d %d %d %d %d %d %d\n", s->c_in, s->c_out, s->k_h, s->k_w, s->stride_h,
+                s->stride_w, s->h_out, s->w_out, b->tile_h, b->tile_w, b->oc_block);
+    }
+    return fclose(f) == 0 ? 0 : -1;
+}
+#endif
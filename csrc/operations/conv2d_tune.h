@@ -0,0 +1,69 @@
+#ifndef CONV2D_TUNE_H
+#define CONV2D_TUNE_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/* direct conv 커널 블로킹의 레이어 shape별 plan (auto-tune 결과).
+ * DIRECT 알고리즘(BARE_METAL 기본)의 direct 커널 전용: GEMM·Winograd·1x1 SIMD 블로킹은 컴파일 상수.
+ * 출력 타일 tile_h x tile_w 픽셀 × oc 블록 oc_block 채널을 누적 버퍼에 두고 ic 루프를 돈다.
+ * plan에 없는 shape은 컴파일 기본값 (CONV2D_TILE_H x CONV2D_TILE_W, CONV2D_OC_BLOCK).
+ * 블로킹은 누적 순서를 바꾸지 않음 → 어떤 plan이든 결과 bit-identical.
+ *
+ * 제약: tile_h * tile_w <= CONV2D_TILE_MAX_PIX (스레드별 누적 버퍼, BSS),
+ *       oc_block은 CONV2D_OC_BLOCK의 약수 (weight_pack DIRECT 배치 [oc/OCB][ic][OCB][kh*kw] 안에서 잘림 없음).
+ * 파일 형식 (텍스트, '#' 주석): 한 줄에 "c_in c_out k_h k_w stride_h stride_w h_out w_out tile_h tile_w oc_block" */
+
+#ifndef CONV2D_TILE_H
+#define CONV2D_TILE_H 8
+#endif
+#ifndef CONV2D_TILE_W
+#define CONV2D_TILE_W 8
+#endif
+/* 타일 픽셀 상한: 누적 버퍼 = YOLO_MAX_THREADS × MAX_PIX × CONV2D_OC_BLOCK float */
+#ifndef CONV2D_TILE_MAX_PIX
+#ifdef BARE_METAL
+#define CONV2D_TILE_MAX_PIX 64
+#else
+#define CONV2D_TILE_MAX_PIX 256
+#endif
+#endif
+/* plan 항목 수 상한 (YOLOv5n 고유 conv shape 29개) */
+#ifndef CONV2D_TUNE_MAX
+#define CONV2D_TUNE_MAX 64
+#endif
+
+typedef struct {
+    int16_t c_in, c_out, k_h, k_w, stride_h, stride_w, h_out, w_out;
+} conv2d_shape_t;
+
+typedef struct {
+    int16_t tile_h, tile_w, oc_block;
+} conv2d_blocking_t;
+
+/** 컴파일 기본 블로킹 */
+conv2d_blocking_t conv2d_blocking_default(void);
+
+/** 블로킹이 커널 제약을 만족하면 1 */
+int conv2d_blocking_valid(const conv2d_blocking_t* b);
+
+/** shape의 블로킹 (plan에 없으면 기본값) */
+conv2d_blocking_t conv2d_tune_get(const conv2d_shape_t* s);
+
+/** plan에 등록/갱신. 0 성공, -1 제약 위반 또는 plan 가득 참 */
+int conv2d_tune_set(const conv2d_shape_t* s, const conv2d_blocking_t* b);
+
+void conv2d_tune_clear(void);
+int32_t conv2d_tune_count(void);
+
+/** 텍스트 plan 해석 (파일 내용 또는 BARE_METAL 임베드 문자열). 반환: 등록 항목 수, -1 형식 오류 (plan은 호출 전 그대로) */
+int32_t conv2d_tune_parse(const char* text, size_t len);
+
+#ifndef BARE_METAL
+/** 파일 → plan (기존 항목에 추가/갱신). 반환: 항목 수, -1 실패 */
+int32_t conv2d_tune_load(const char* path);
+/** plan → 파일. 0 성공 */
+int conv2d_tune_save(const char* path);
+#endif
+
+#endif // CONV2D_TUNE_H
@@ -0,0 +1,194 @@
+#include "conv2d_winograd.h"
+#include "../utils/thread_pool.h"
+#include <stdint.h>
+
+#define TB WINOGRAD_TILE_BLOCK
+
+/* 입력 변환 V[e][ic][t], 원소별 곱 M[e][oc][t] (BSS, 스레드별 각 16*128*16 floats = 128KB) */
+static float wino_v_buf[YOLO_MAX_THREADS][16 * WINOGRAD_MAX_C * TB];
+static float wino_m_buf[YOLO_MAX_THREADS][16 * WINOGRAD_MAX_C * TB];
+
+size_t winograd_f2x3_filter_size(int32_t c_out, int32_t c_in) {
+    return (size_t)16 * (size_t)c_out * (size_t)c_in;
+}
+
+/* U = G g G^T, G = [1 0 0; .5 .5 .5; .5 -.5 .5; 0 0 1] */
+void winograd_f2x3_transform_filter(
+    const void* w, float scale, int is_int8,
+    int32_t c_out, int32_t c_in,
+    float* u)
+{
+    const size_t plane = (size_t)c_out * (size_t)c_in;
+    for (int32_t oc = 0; oc < c_out; oc++) {
+        for (int32_t ic = 0; ic < c_in; ic++) {
+            const size_t off = ((size_t)oc * c_in + ic) * 9;
+            float g[9];
+            for (int32_t i = 0; i < 9; i++) {
+                g[i] = is_int8 ? (float)((const int8_t*)w)[off + i] * scale
+                               : ((const float*)w)[off + i];
+            }
+            /* tmp = G g (4x3) */
+            float t[4][3];
+            for (int32_t j = 0; j < 3; j++) {
+                const float g0 = g[0 * 3 + j], g1 = g[1 * 3 + j], g2 = g[2 * 3 + j];
+                t[0][j] = g0;
+                t[1][j] = 0.5f * (g0 + g1 + g2);
+                t[2][j] = 0.5f * (g0 - g1 + g2);
+                t[3][j] = g2;
+            }
+            /* U = tmp G^T (4x4) */
+            for (int32_t i = 0; i < 4; i++) {
+                const float t0 = t[i][0], t1 = t[i][1], t2 = t[i][2];
+                float* dst = u + (size_t)(i * 4) * plane + (size_t)oc * c_in + ic;
+                dst[0 * plane] = t0;
+                dst[1 * plane] = 0.5f * (t0 + t1 + t2);
+                dst[2 * plane] = 0.5f * (t0 - t1 + t2);
+                dst[3 * plane] = t2;
+            }
+        }
+    }
+}
+
+/* thread_pool 작업: item = (ni, t0) 타일 블록 (TB개 2x2 출력 타일) */
+typedef struct {
+    const float* x; int32_t c_in, h_in, w_in;
+    const float* u; int32_t c_out;
+    const float* bias_or_null;
+    int32_t pad_h, pad_w;
+    const conv2d_epilogue_t* ep;
+    float* y; int32_t h_out, w_out;
+    size_t x_img, y_img;                 /* 이미지 간격 (원소) */
+} wino_args_t;
+
+static void wino_range(void* ctx, int32_t it0, int32_t it1, int32_t tid)
+{
+    const wino_args_t* a = (const wino_args_t*)ctx;
+    const int32_t c_in = a->c_in, h_in = a->h_in, w_in = a->w_in, c_out = a->c_out;
+    const int32_t pad_h = a->pad_h, pad_w = a->pad_w, h_out = a->h_out, w_out = a->w_out;
+    const float* u = a->u;
+    const float* bias_or_null = a->bias_or_null;
+    const conv2d_epilogue_t* ep = a->ep;
+    float* v_buf = wino_v_buf[tid];
+    float* m_buf = wino_m_buf[tid];
+    const int32_t tiles_h = (h_out + 1) / 2;
+    const int32_t tiles_w = (w_out + 1) / 2;
+    const int32_t n_tiles = tiles_h * tiles_w;
+    const size_t u_plane = (size_t)c_out * (size_t)c_in;
+    const int32_t v_plane = c_in * TB;
+    const int32_t m_plane = c_out * TB;
+
+    const int32_t n_tblk = (n_tiles + TB - 1) / TB;
+
+    for (int32_t it = it0; it < it1; it++) {
+        const int32_t ni = it / n_tblk;
+        const int32_t t0 = (it % n_tblk) * TB;
+        const float* x_img = a->x + (size_t)ni * a->x_img;
+        const size_t y_img_off = (size_t)ni * a->y_img;
+        float* y_img = a->y + y_img_off;
+
+        const int32_t nt = t0 + TB <= n_tiles ? TB : n_tiles - t0;
+
+        /* 입력 변환: V = B^T d B, B^T = [1 0 -1 0; 0 1 1 0; 0 -1 1 0; 0 1 0 -1] */
+        for (int32_t ic = 0; ic < c_in; ic++) {
+            const float* x_ch = x_img + (size_t)ic * h_in * w_in;
+            for (int32_t t = 0; t < TB; t++) {
+                float d[4][4];
+                if (t < nt) {
+                    const int32_t tile = t0 + t;
+                    const int32_t ih0 = (tile / tiles_w) * 2 - pad_h;
+                    const int32_t iw0 = (tile % tiles_w) * 2 - pad_w;
+                    const int32_t inside = (ih0 >= 0 && ih0 + 4 <= h_in && iw0 >= 0 && iw0 + 4 <= w_in);
+                    for (int32_t r = 0; r < 4; r++) {
+                        const int32_t ih = ih0 + r;
+                        for (int32_t c = 0; c < 4; c++) {
+                            const int32_t iw = iw0 + c;
+                            if (inside || ((uint32_t)ih < (uint32_t)h_in && (uint32_t)iw < (uint32_t)w_in))
+                                d[r][c] = x_ch[ih * w_in + iw];
+                            else
+                                d[r][c] = 0.0f;
+                        }
+                    }
+                } else {
+                    for (int32_t r = 0; r < 4; r++)
+                        for (int32_t c = 0; c < 4; c++)
+                            d[r][c] = 0.0f;
+                }
+                float bd[4][4];
+                for (int32_t c = 0; c < 4; c++) {
+                    bd[0][c] = d[0][c] - d[2][c];
+                    bd[1][c] = d[1][c] + d[2][c];
+                    bd[2][c] = d[2][c] - d[1][c];
+                    bd[3][c] = d[1][c] - d[3][c];
+                }
+                float* v = v_buf + ic * TB + t;
+                for (int32_t r = 0; r < 4; r++) {
+                    v[(r * 4 + 0) * v_plane] = bd[r][0] - bd[r][2];
+                    v[(r * 4 + 1) * v_plane] = bd[r][1] + bd[r][2];
+                    v[(r * 4 + 2) * v_plane] = bd[r][2] - bd[r][1];
+                    v[(r * 4 + 3) * v_plane] = bd[r][1] - bd[r][3];
+                }
+            }
+        }
+
+        /* 원소별 곱 (16개 독립 GEMM): M[e][oc][t] = Σ_ic U[e][oc][ic] V[e][ic][t] */
+        for (int32_t e = 0; e < 16; e++) {
+            const float* u_e = u + (size_t)e * u_plane;
+            const float* v_e = v_buf + e * v_plane;
+            float* m_e = m_buf + e * m_plane;
+            for (int32_t oc = 0; oc < c_out; oc++) {
+                const float* u_row = u_e + (size_t)oc * c_in;
+                float acc[TB];
+                for (int32_t t = 0; t < TB; t++) acc[t] = 0.0f;
+                for (int32_t ic = 0; ic < c_in; ic++) {
+                    const float uv = u_row[ic];
+                    const float* v_row = v_e + ic * TB;
+                    for (int32_t t = 0; t < TB; t++)
+                        acc[t] += uv * v_row[t];
+                }
+                for (int32_t t = 0; t < TB; t++) m_e[oc * TB + t] = acc[t];
+            }
+        }
+
+        /* 출력 변환: Y = A^T M A + bias, A^T = [1 1 1 0; 0 1 -1 -1], 쓰면서 epilogue */
+        for (int32_t oc = 0; oc < c_out; oc++) {
+            const float b = bias_or_null ? bias_or_null[oc] : 0.0f;
+            const size_t y_ch_off = y_img_off + (size_t)oc * h_out * w_out;
+            float* y_ch = y_img + (size_t)oc * h_out * w_out;
+            for (int32_t t = 0; t < nt; t++) {
+                float m[16];
+                for (int32_t e = 0; e < 16; e++) m[e] = m_buf[e * m_plane + oc * TB + t];
+                float am[2][4];
+                for (int32_t c = 0; c < 4; c++) {
+                    am[0][c] = m[0 * 4 + c] + m[1 * 4 + c] + m[2 * 4 + c];
+                    am[1][c] = m[1 * 4 + c] - m[2 * 4 + c] - m[3 * 4 + c];
+                }
+                const int32_t tile = t0 + t;
+                const int32_t oh = (tile / tiles_w) * 2;
+                const int32_t ow = (tile % tiles_w) * 2;
+                for (int32_t r = 0; r < 2; r++) {
+                    if (oh + r >= h_out) break;
+                    const size_t y_off = y_ch_off + (size_t)(oh + r) * w_out + ow;
+                    float* y_row = y_ch + (oh + r) * w_out + ow;
+                    y_row[0] = conv2d_epilogue_apply(ep, am[r][0] + am[r][1] + am[r][2] + b, y_off);
+                    if (ow + 1 < w_out)
+                        y_row[1] = conv2d_epilogue_apply(ep, am[r][1] - am[r][2] - am[r][3] + b, y_off + 1);
+                }
+            }
+        }
+    }
+}
+
+void conv2d_winograd_f2x3_nchw_f32(
+    const float* x, int32_t n, int32_t c_in, int32_t h_in, int32_t w_in,
+    const float* u, int32_t c_out,
+    const float* bias_or_null,
+    int32_t pad_h, int32_t pad_w,
+    const conv2d_epilogue_t* ep,
+    float* y, int32_t h_out, int32_t w_out,
+    size_t x_img, size_t y_img)
+{
+    wino_args_t a = { x, c_in, h_in, w_in, u, c_out, bias_or_null, pad_h, pad_w, ep, y, h_out, w_out,
+                      x_img, y_img };
+    const int32_t n_tiles = ((h_out + 1) / 2) * ((w_out + 1) / 2);
+    thread_pool_run(n * ((n_tiles + TB - 1) / TB), wino_range, &a);
+}
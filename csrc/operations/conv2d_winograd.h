@@ -0,0 +1,40 @@
+#ifndef CONV2D_WINOGRAD_H
+#define CONV2D_WINOGRAD_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "conv2d_epilogue.h"
+
+/* Winograd F(2x2,3x3): 3x3 / stride 1 conv 전용.
+ * 출력 2x2 타일당 곱셈 36 → 16 (2.25x). 필터 변환 U = G g G^T는 로드 시 1회(weight_pack). */
+
+/* 한 번에 변환하는 타일 수 (V/M scratch 크기 결정) */
+#ifndef WINOGRAD_TILE_BLOCK
+#define WINOGRAD_TILE_BLOCK 16
+#endif
+/* scratch가 지원하는 최대 채널 수 (초과 시 호출 측이 다른 경로 사용) */
+#ifndef WINOGRAD_MAX_C
+#define WINOGRAD_MAX_C 128
+#endif
+
+/** 변환된 필터 크기 (float 개수): 16 * c_out * c_in */
+size_t winograd_f2x3_filter_size(int32_t c_out, int32_t c_in);
+
+/** OIHW 3x3 가중치(float* 또는 int8_t*+scale) → U [16][c_out][c_in] */
+void winograd_f2x3_transform_filter(
+    const void* w, float scale, int is_int8,
+    int32_t c_out, int32_t c_in,
+    float* u);
+
+/** 3x3 / stride 1 conv (pad 임의). c_in, c_out <= WINOGRAD_MAX_C 일 때만 호출. ep: 출력 변환 시 적용 (NULL 가능).
+ *  x_img / y_img: 이미지 간격 (원소) — 밀집이면 c*h*w, 더 큰 채널 텐서의 구간이면 그 텐서 기준 */
+void conv2d_winograd_f2x3_nchw_f32(
+    const float* x, int32_t n, int32_t c_in, int32_t h_in, int32_t w_in,
+    const float* u, int32_t c_out,
+    const float* bias_or_null,
+    int32_t pad_h, int32_t pad_w,
+    const conv2d_epilogue_t* ep,
+    float* y, int32_t h_out, int32_t w_out,
+    size_t x_img, size_t y_img);
+
+#endif // CONV2D_WINOGRAD_H
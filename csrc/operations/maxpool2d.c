@@ -1,33 +1,145 @@
 #include "maxpool2d.h"
+#include "../utils/thread_pool.h"
+
+#define MP_NEG (-3.402823466e+38f)    /* -FLT_MAX: 패딩 값 (직접 경로의 초기값과 같음) */
+#define MP_MAX(a, b) ((a) > (b) ? (a) : (b))
+
+/* 스레드별 라인 버퍼: 패딩된 입력 / 블록 앞→뒤 누적 max / 뒤→앞 누적 max */
+static float mp_line_buf[YOLO_MAX_THREADS][3][MAXPOOL_LINE_MAX];
+
+/* k×k 직접 (탭별 경계 검사). stride/pad 일반형 */
+static void pool_plane_direct(const float* xp, int32_t h, int32_t w, int32_t k, int32_t stride, int32_t pad,
+                              float* yp, int32_t out_h, int32_t out_w)
+{
+    for (int32_t oh = 0; oh < out_h; oh++) {
+        for (int32_t ow = 0; ow < out_w; ow++) {
+            float m = MP_NEG;
+
+            for (int32_t kh = 0; kh < k; kh++) {
+                for (int32_t kw = 0; kw < k; kw++) {
+                    const int32_t ih = oh * stride - pad + kh;
+                    const int32_t iw = ow * stride - pad + kw;
+                    if ((uint32_t)ih >= (uint32_t)h || (uint32_t)iw >= (uint32_t)w) {
+                        continue;
+                    }
+                    const float v = xp[ih * w + iw];
+                    if (v > m) m = v;
+                }
+            }
+
+            yp[oh * out_w + ow] = m;
+        }
+    }
+}
+
+/* 1D van Herk/Gil-Werman: src(len개, 간격 s_in, 앞 pad개는 패딩)를 k 블록으로 나눠
+ * g = 블록 내 앞→뒤 누적 max, r = 뒤→앞 누적 max → 창 [i, i+k) max = max(r[i], g[i+k-1]).
+ * 라인 전체를 버퍼에 옮긴 뒤 쓰므로 dst == src 가능 */
+static void vhgw_line(const float* src, int32_t len, ptrdiff_t s_in, int32_t k, int32_t pad,
+                      float* dst, int32_t out_len, ptrdiff_t s_out, float (*buf)[MAXPOOL_LINE_MAX])
+{
+    float* p = buf[0];
+    float* g = buf[1];
+    float* r = buf[2];
+    const int32_t need = out_len + k - 1;
+    const int32_t lb = (need + k - 1) / k * k;
+    const int32_t v1 = pad + len < lb ? pad + len : lb;
+    int32_t i = 0;
+
+    for (; i < pad; i++) p[i] = MP_NEG;
+    for (; i < v1; i++) p[i] = src[(ptrdiff_t)(i - pad) * s_in];
+    for (; i < lb; i++) p[i] = MP_NEG;
+
+    for (int32_t b = 0; b < lb; b += k) {
+        g[b] = p[b];
+        for (int32_t j = b + 1; j < b + k; j++) g[j] = MP_MAX(p[j], g[j - 1]);
+        r[b + k - 1] = p[b + k - 1];
+        for (int32_t j = b + k - 2; j >= b; j--) r[j] = MP_MAX(p[j], r[j + 1]);
+    }
+    for (i = 0; i < out_len; i++) dst[(ptrdiff_t)i * s_out] = MP_MAX(r[i], g[i + k - 1]);
+}
+
+static int sep_ok(int32_t h, int32_t w, int32_t k, int32_t pad)
+{
+    const int32_t line = (h > w ? h : w) + 2 * k;
+    return k >= 1 && pad >= 0 && pad < k && line <= MAXPOOL_LINE_MAX;
+}
+
+/* 분리형: 행 방향 x → y, 열 방향 y → y (제자리). stride 1, 출력 크기 = 입력 크기 */
+static void pool_plane_sep(const float* xp, int32_t h, int32_t w, int32_t k, int32_t pad,
+                           float* yp, float (*buf)[MAXPOOL_LINE_MAX])
+{
+    for (int32_t ih = 0; ih < h; ih++)
+        vhgw_line(xp + (size_t)ih * w, w, 1, k, pad, yp + (size_t)ih * w, w, 1, buf);
+    for (int32_t iw = 0; iw < w; iw++)
+        vhgw_line(yp + iw, h, w, k, pad, yp + iw, h, w, buf);
+}
+
+/* item = (ni, ci) 출력 plane */
+typedef struct {
+    const float* x; int32_t h, w;
+    int32_t k, stride, pad;
+    float* y; int32_t out_h, out_w;
+    int32_t sep;
+} maxpool_args_t;
+
+static void maxpool_range(void* ctx, int32_t it0, int32_t it1, int32_t tid)
+{
+    const maxpool_args_t* g = (const maxpool_args_t*)ctx;
+    const int32_t h = g->h, w = g->w;
+
+    for (int32_t plane = it0; plane < it1; plane++) {
+        const float* xp = g->x + (size_t)plane * h * w;
+        float* yp = g->y + (size_t)plane * g->out_h * g->out_w;
+        if (g->sep)
+            pool_plane_sep(xp, h, w, g->k, g->pad, yp, mp_line_buf[tid]);
+        else
+            pool_plane_direct(xp, h, w, g->k, g->stride, g->pad, yp, g->out_h, g->out_w);
+    }
+}
 
 void maxpool2d_nchw_f32(
     const float* x, int32_t n, int32_t c, int32_t h, int32_t w,
     int32_t k, int32_t stride, int32_t pad,
     float* y, int32_t out_h, int32_t out_w)
 {
-    for (int32_t ni = 0; ni < n; ni++) {
-        for (int32_t ci = 0; ci < c; ci++) {
-            for (int32_t oh = 0; oh < out_h; oh++) {
-                for (int32_t ow = 0; ow < out_w; ow++) {
-                    float m = -3.402823466e+38f; // -FLT_MAX
-
-                    for (int32_t kh = 0; kh < k; kh++) {
-                        for (int32_t kw = 0; kw < k; kw++) {
-                            const int32_t ih = oh * stride - pad + kh;
-                            const int32_t iw = ow * stride - pad + kw;
-                            if ((uint32_t)ih >= (uint32_t)h || (uint32_t)iw >= (uint32_t)w) {
-                                continue;
-                            }
-                            const int32_t idx = ((ni * c + ci) * h + ih) * w + iw;
-                            const float v = x[idx];
-                            if (v > m) m = v;
-                        }
-                    }
+    const int32_t sep = stride == 1 && out_h == h && out_w == w && h + 2 * pad - k + 1 == h &&
+                        sep_ok(h, w, k, pad);
+    maxpool_args_t g = { x, h, w, k, stride, pad, y, out_h, out_w, sep };
+    thread_pool_run(n * c, maxpool_range, &g);
+}
 
-                    const int32_t oidx = ((ni * c + ci) * out_h + oh) * out_w + ow;
-                    y[oidx] = m;
-                }
-            }
+/* item = (ni, ci): 같은 스레드가 plane 하나의 3단을 연속 계산 */
+typedef struct {
+    const float* x; int32_t c, h, w, k;
+    float* y[3]; size_t img_stride;
+    int32_t sep;
+} maxpool_sppf_args_t;
+
+static void maxpool_sppf_range(void* ctx, int32_t it0, int32_t it1, int32_t tid)
+{
+    const maxpool_sppf_args_t* g = (const maxpool_sppf_args_t*)ctx;
+    const int32_t h = g->h, w = g->w, k = g->k, pad = k / 2;
+
+    for (int32_t plane = it0; plane < it1; plane++) {
+        const size_t off = (size_t)(plane / g->c) * g->img_stride + (size_t)(plane % g->c) * h * w;
+        const float* src = g->x + off;
+        for (int32_t s = 0; s < 3; s++) {
+            float* dst = g->y[s] + off;
+            if (g->sep)
+                pool_plane_sep(src, h, w, k, pad, dst, mp_line_buf[tid]);
+            else
+                pool_plane_direct(src, h, w, k, 1, pad, dst, h, w);
+            src = dst;
         }
     }
 }
+
+void maxpool2d_sppf_nchw_f32(
+    const float* x, int32_t n, int32_t c, int32_t h, int32_t w, int32_t k,
+    float* y1, float* y2, float* y3, size_t img_stride)
+{
+    maxpool_sppf_args_t g = { x, c, h, w, k, { y1, y2, y3 }, img_stride,
+                                (k & 1) && sep_ok(h, w, k, k / 2) };
+    thread_pool_run(n * c, maxpool_sppf_range, &g);
+}
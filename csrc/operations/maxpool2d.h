@@ -2,10 +2,25 @@
 #define MAXPOOL2D_H
 
 #include <stdint.h>
+#include <stddef.h>
 
+/* 분리형(행 → 열) van Herk/Gil-Werman 경로의 1D 라인 버퍼 길이 (스레드별 BSS 3줄).
+ * 라인(max(h, w) + 2k)이 이보다 길면 k×k 직접 경로 */
+#ifndef MAXPOOL_LINE_MAX
+#define MAXPOOL_LINE_MAX 1024
+#endif
+
+/* stride 1, 출력 크기 = 입력 크기 (pad < k)면 분리형 sliding window (출력당 비교 ~6회, k 무관, 탭별 경계 분기 없음),
+ * 그 외는 k×k 직접 */
 void maxpool2d_nchw_f32(
     const float* x, int32_t n, int32_t c, int32_t h, int32_t w,
     int32_t k, int32_t stride, int32_t pad,
     float* y, int32_t out_h, int32_t out_w);
 
+/** SPPF 풀 단계 한 패스: y1 = pool(x), y2 = pool(y1), y3 = pool(y2) (k×k, stride 1, pad k/2, 출력 h×w)를
+ *  plane마다 이어서 계산 (plane이 캐시에 있는 동안 3단). x와 y1..y3의 이미지 간격은 img_stride (원소, SPPF concat 1장) */
+void maxpool2d_sppf_nchw_f32(
+    const float* x, int32_t n, int32_t c, int32_t h, int32_t w, int32_t k,
+    float* y1, float* y2, float* y3, size_t img_stride);
+
 #endif // MAXPOOL2D_H
@@ -1,20 +1,117 @@
 #include "silu.h"
-#include <math.h>
+#include "../utils/thread_pool.h"
 
-static inline float silu_f32(float x) {
-    if (!isfinite(x)) {
-        return (x > 0.0f) ? 100.0f : 0.0f;
+#if defined(__AVX2__) && defined(__FMA__)
+#include <immintrin.h>
+#define SILU_VL 8
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#define SILU_VL 4
+#else
+#define SILU_VL 0
+#endif
+
+/* 스레드 분배 단위 (원소 수) */
+#define SILU_CHUNK 4096
+
+static silu_mode_t s_mode = SILU_MODE_DEFAULT;
+
+void silu_set_mode(silu_mode_t mode) {
+    s_mode = mode;
+}
+
+silu_mode_t silu_get_mode(void) {
+    return s_mode;
+}
+
+/* silu_fast_f32와 같은 연산 순서의 벡터판 (비유한 입력은 마스크로 포화값 선택) */
+#if SILU_VL == 8
+static inline __m256 silu_fast_v(__m256 x)
+{
+    const __m256 sign = _mm256_set1_ps(-0.0f);
+    const __m256 finite = _mm256_cmp_ps(_mm256_andnot_ps(sign, x), _mm256_set1_ps(INFINITY), _CMP_LT_OQ);
+    const __m256 sat = _mm256_and_ps(_mm256_cmp_ps(x, _mm256_setzero_ps(), _CMP_GT_OQ), _mm256_set1_ps(100.0f));
+    __m256 t = _mm256_xor_ps(x, sign);
+    t = _mm256_max_ps(t, _mm256_set1_ps(SILU_EXP_LO));
+    t = _mm256_min_ps(t, _mm256_set1_ps(SILU_EXP_HI));
+    const __m256 rnd = _mm256_set1_ps(SILU_ROUND);
+    const __m256 n = _mm256_sub_ps(_mm256_fmadd_ps(t, _mm256_set1_ps(SILU_LOG2E), rnd), rnd);
+    __m256 r = _mm256_fmadd_ps(n, _mm256_set1_ps(-SILU_LN2_HI), t);
+    r = _mm256_fmadd_ps(n, _mm256_set1_ps(-SILU_LN2_LO), r);
+    __m256 p = _mm256_set1_ps(SILU_P0);
+    p = _mm256_fmadd_ps(p, r, _mm256_set1_ps(SILU_P1));
+    p = _mm256_fmadd_ps(p, r, _mm256_set1_ps(SILU_P2));
+    p = _mm256_fmadd_ps(p, r, _mm256_set1_ps(SILU_P3));
+    p = _mm256_fmadd_ps(p, r, _mm256_set1_ps(SILU_P4));
+    p = _mm256_fmadd_ps(p, r, _mm256_set1_ps(SILU_P5));
+    const __m256 r2 = _mm256_mul_ps(r, r);
+    const __m256 er = _mm256_add_ps(_mm256_fmadd_ps(p, r2, r), _mm256_set1_ps(1.0f));
+    const __m256i e = _mm256_slli_epi32(_mm256_add_epi32(_mm256_cvttps_epi32(n), _mm256_set1_epi32(127)), 23);
+    const __m256 y = _mm256_div_ps(x, _mm256_fmadd_ps(er, _mm256_castsi256_ps(e), _mm256_set1_ps(1.0f)));
+    return _mm256_blendv_ps(sat, y, finite);
+}
+#define SILU_V_LOAD(p)     _mm256_loadu_ps(p)
+#define SILU_V_STORE(p, v) _mm256_storeu_ps((p), (v))
+#elif SILU_VL == 4
+static inline float32x4_t silu_fast_v(float32x4_t x)
+{
+    const uint32x4_t finite = vcltq_f32(vabsq_f32(x), vdupq_n_f32(INFINITY));
+    const float32x4_t sat = vbslq_f32(vcgtq_f32(x, vdupq_n_f32(0.0f)), vdupq_n_f32(100.0f), vdupq_n_f32(0.0f));
+    float32x4_t t = vnegq_f32(x);
+    t = vmaxq_f32(t, vdupq_n_f32(SILU_EXP_LO));
+    t = vminq_f32(t, vdupq_n_f32(SILU_EXP_HI));
+    const float32x4_t rnd = vdupq_n_f32(SILU_ROUND);
+    const float32x4_t n = vsubq_f32(vfmaq_f32(rnd, t, vdupq_n_f32(SILU_LOG2E)), rnd);
+    float32x4_t r = vfmaq_f32(t, n, vdupq_n_f32(-SILU_LN2_HI));
+    r = vfmaq_f32(r, n, vdupq_n_f32(-SILU_LN2_LO));
+    float32x4_t p = vdupq_n_f32(SILU_P0);
+    p = vfmaq_f32(vdupq_n_f32(SILU_P1), p, r);
+    p = vfmaq_f32(vdupq_n_f32(SILU_P2), p, r);
+    p = vfmaq_f32(vdupq_n_f32(SILU_P3), p, r);
+    p = vfmaq_f32(vdupq_n_f32(SILU_P4), p, r);
+    p = vfmaq_f32(vdupq_n_f32(SILU_P5), p, r);
+    const float32x4_t r2 = vmulq_f32(r, r);
+    const float32x4_t er = vaddq_f32(vfmaq_f32(r, p, r2), vdupq_n_f32(1.0f));
+    const int32x4_t e = vshlq_n_s32(vaddq_s32(vcvtq_s32_f32(n), vdupq_n_s32(127)), 23);
+    const float32x4_t y = vdivq_f32(x, vfmaq_f32(vdupq_n_f32(1.0f), er, vreinterpretq_f32_s32(e)));
+    return vbslq_f32(finite, y, sat);
+}
+#define SILU_V_LOAD(p)     vld1q_f32(p)
+#define SILU_V_STORE(p, v) vst1q_f32((p), (v))
+#endif
+
+void silu_fast_span_f32(const float* x, float* y, int32_t len)
+{
+    int32_t i = 0;
+#if SILU_VL > 0
+    for (; i + SILU_VL <= len; i += SILU_VL)
+        SILU_V_STORE(y + i, silu_fast_v(SILU_V_LOAD(x + i)));
+#endif
+    for (; i < len; i++)
+        y[i] = silu_fast_f32(x[i]);
+}
+
+typedef struct { const float* x; float* y; int32_t total; } silu_args_t;
+
+static void silu_range(void* ctx, int32_t it0, int32_t it1, int32_t tid)
+{
+    const silu_args_t* g = (const silu_args_t*)ctx;
+    const int32_t i0 = it0 * SILU_CHUNK;
+    const int32_t i1 = it1 * SILU_CHUNK < g->total ? it1 * SILU_CHUNK : g->total;
+    (void)tid;
+    if (s_mode == SILU_FAST) {
+        silu_fast_span_f32(g->x + i0, g->y + i0, i1 - i0);
+        return;
+    }
+    for (int32_t i = i0; i < i1; i++) {
+        g->y[i] = silu_f32(g->x[i]);
     }
-    float s = 1.0f / (1.0f + expf(-x));
-    return x * s;
 }
 
 void silu_nchw_f32(
     const float* x, int32_t n, int32_t c, int32_t h, int32_t w,
     float* y)
 {
-    int32_t total = n * c * h * w;
-    for (int32_t i = 0; i < total; i++) {
-        y[i] = silu_f32(x[i]);
-    }
+    silu_args_t g = { x, y, n * c * h * w };
+    thread_pool_run((g.total + SILU_CHUNK - 1) / SILU_CHUNK, silu_range, &g);
 }
@@ -1,33 +1,41 @@
 #include "upsample.h"
+#include <stddef.h>
 #include "../utils/timing.h"
+#include "../utils/thread_pool.h"
 
-void upsample_nearest2x_nchw_f32(
-    const float* x, int32_t n, int32_t c, int32_t h, int32_t w,
-    float* y)
+/* item = (ni, ci) 입력 plane */
+typedef struct { const float* x; int32_t h, w; float* y; } upsample_args_t;
+
+static void upsample_range(void* ctx, int32_t it0, int32_t it1, int32_t tid)
 {
-    yolo_timing_begin("upsample");
-    const int32_t out_h = h * 2;
+    const upsample_args_t* g = (const upsample_args_t*)ctx;
+    const int32_t h = g->h, w = g->w;
     const int32_t out_w = w * 2;
+    (void)tid;
 
-    for (int32_t ni = 0; ni < n; ni++) {
-        for (int32_t ci = 0; ci < c; ci++) {
-            for (int32_t ih = 0; ih < h; ih++) {
-                for (int32_t iw = 0; iw < w; iw++) {
-                    const int32_t in_idx = ((ni * c + ci) * h + ih) * w + iw;
-                    const float val = x[in_idx];
-
-                    const int32_t oh0 = ih * 2;
-                    const int32_t oh1 = ih * 2 + 1;
-                    const int32_t ow0 = iw * 2;
-                    const int32_t ow1 = iw * 2 + 1;
-
-                    y[((ni * c + ci) * out_h + oh0) * out_w + ow0] = val;
-                    y[((ni * c + ci) * out_h + oh0) * out_w + ow1] = val;
-                    y[((ni * c + ci) * out_h + oh1) * out_w + ow0] = val;
-                    y[((ni * c + ci) * out_h + oh1) * out_w + ow1] = val;
-                }
+    for (int32_t plane = it0; plane < it1; plane++) {
+        const float* xp = g->x + (size_t)plane * h * w;
+        float* yp = g->y + (size_t)plane * (h * 2) * out_w;
+        for (int32_t ih = 0; ih < h; ih++) {
+            float* y0 = yp + (ih * 2) * out_w;
+            float* y1 = y0 + out_w;
+            for (int32_t iw = 0; iw < w; iw++) {
+                const float val = xp[ih * w + iw];
+                y0[iw * 2] = val;
+                y0[iw * 2 + 1] = val;
+                y1[iw * 2] = val;
+                y1[iw * 2 + 1] = val;
             }
         }
     }
+}
+
+void upsample_nearest2x_nchw_f32(
+    const float* x, int32_t n, int32_t c, int32_t h, int32_t w,
+    float* y)
+{
+    yolo_timing_begin("upsample");
+    upsample_args_t g = { x, h, w, y };
+    thread_pool_run(n * c, upsample_range, &g);
     yolo_timing_end();
 }
@@ -0,0 +1,256 @@
+#include "weight_pack.h"
+#include "conv2d.h"
+#include "conv2d_gemm.h"
+#include "conv2d_stem.h"
+#include "conv2d_winograd.h"
+#include <string.h>
+
+#ifdef BARE_METAL
+#include "platform_config.h"
+#else
+#include <stdlib.h>
+#endif
+
+#define PACK_MAX     256   /* YOLOv5n conv 60개 */
+#define PACK_HASH    512   /* 2의 거듭제곱, open addressing */
+#define PACK_ALIGN   64u   /* 캐시 라인 / AVX-512 로드 정렬 */
+
+static weight_pack_t s_packs[PACK_MAX];
+static int32_t s_num_packs;
+static int16_t s_hash[PACK_HASH];  /* s_packs 인덱스 + 1, 0 = 빈 슬롯 */
+static unsigned s_flags;
+static size_t s_bytes;
+#ifndef BARE_METAL
+static uint8_t* s_arena_raw;
+#endif
+
+static inline uint32_t ptr_hash(const void* p) {
+    uintptr_t u = (uintptr_t)p;
+    return (uint32_t)((u >> 4) ^ (u >> 13)) * 2654435761u;
+}
+
+static inline size_t align_up(size_t x) {
+    return (x + PACK_ALIGN - 1) & ~(size_t)(PACK_ALIGN - 1);
+}
+
+static weight_pack_t* pack_insert(const void* src) {
+    if (s_num_packs >= PACK_MAX) return NULL;
+    uint32_t h = ptr_hash(src) & (PACK_HASH - 1);
+    while (s_hash[h]) {
+        if (s_packs[s_hash[h] - 1].src == src) return &s_packs[s_hash[h] - 1];
+        h = (h + 1) & (PACK_HASH - 1);
+    }
+    weight_pack_t* pk = &s_packs[s_num_packs++];
+    memset(pk, 0, sizeof(*pk));
+    pk->src = src;
+    s_hash[h] = (int16_t)s_num_packs;
+    return pk;
+}
+
+const weight_pack_t* weight_pack_find(const void* src) {
+    if (!src || s_num_packs == 0) return NULL;
+    uint32_t h = ptr_hash(src) & (PACK_HASH - 1);
+    while (s_hash[h]) {
+        const weight_pack_t* pk = &s_packs[s_hash[h] - 1];
+        if (pk->src == src) return pk;
+        h = (h + 1) & (PACK_HASH - 1);
+    }
+    return NULL;
+}
+
+/* YOLOv5 C3 bottleneck의 cv2 (model.N.m.K.cv2.conv.weight) = 3x3 / s1 / p1 */
+static int is_bottleneck_cv2(const char* name) {
+    return strstr(name, ".m.") != NULL && strstr(name, ".cv2.") != NULL;
+}
+
+/* conv 가중치 텐서의 원본 포인터 (INT8이면 data_int8 + scale) */
+static const void* conv_src(const tensor_info_t* t, float* scale, int* is_int8) {
+    *is_int8 = (t->dtype == WEIGHTS_DTYPE_INT8 && t->data_int8);
+    *scale = *is_int8 ? t->scale : 1.0f;
+    return *is_int8 ? (const void*)t->data_int8 : (const void*)t->data;
+}
+
+/* C3 cv1(model.N.cv1.conv.weight)이면 같은 입력을 받는 cv2 텐서. 1x1·같은 c_in이고
+ * cv1 c_out이 패널 블록(MR) 배수일 때만 (SPPF cv1/cv2는 c_in이 달라 제외). 없으면 NULL */
+static const tensor_info_t* c3_cv2_pair(const weights_loader_t* loader, const tensor_info_t* t) {
+    char name[128];
+    const char* p = strstr(t->name, ".cv1.conv.weight");
+    if (!p || strstr(t->name, ".m.") || t->ndim != 4 || t->shape[2] != 1 || t->shape[3] != 1) return NULL;
+    if (t->shape[0] % CONV2D_GEMM_MR != 0 || (size_t)(p - t->name) + 17 > sizeof(name)) return NULL;
+    memcpy(name, t->name, (size_t)(p - t->name));
+    strcpy(name + (p - t->name), ".cv2.conv.weight");
+    const tensor_info_t* u = weights_find_tensor(loader, name);
+    if (!u || u->ndim != 4 || u->shape[1] != t->shape[1] || u->shape[2] != 1 || u->shape[3] != 1) return NULL;
+    return u;
+}
+
+/* cv2가 cv1 짝으로 이미 패널을 받는지 (cv1 이름으로 역조회) */
+static int is_c3_cv2_paired(const weights_loader_t* loader, const tensor_info_t* t) {
+    char name[128];
+    const char* p = strstr(t->name, ".cv2.conv.weight");
+    if (!p || strstr(t->name, ".m.") || (size_t)(p - t->name) + 17 > sizeof(name)) return 0;
+    memcpy(name, t->name, (size_t)(p - t->name));
+    strcpy(name + (p - t->name), ".cv1.conv.weight");
+    const tensor_info_t* c1 = weights_find_tensor(loader, name);
+    return c1 && c3_cv2_pair(loader, c1) == t;
+}
+
+/* OIHW → [oc/OCB][ic][OCB][kh*kw]. dst_f32 != NULL이면 FP32(w*scale), 아니면 INT8 그대로 */
+static void pack_direct(const void* w, float scale, int is_int8,
+                        int32_t c_out, int32_t c_in, int32_t ksz,
+                        float* dst_f32, int8_t* dst_i8)
+{
+    const int32_t ocb = CONV2D_OC_BLOCK;
+    size_t d = 0;
+    for (int32_t oc0 = 0; oc0 < c_out; oc0 += ocb) {
+        for (int32_t ic = 0; ic < c_in; ic++) {
+            for (int32_t b = 0; b < ocb; b++) {
+                const int32_t oc = oc0 + b;
+                const size_t s = ((size_t)oc * c_in + ic) * ksz;
+                for (int32_t k = 0; k < ksz; k++, d++) {
+                    if (oc >= c_out) {
+                        if (dst_f32) dst_f32[d] = 0.0f; else dst_i8[d] = 0;
+                    } else if (dst_f32) {
+                        dst_f32[d] = is_int8 ? (float)((const int8_t*)w)[s + k] * scale
+                                             : ((const float*)w)[s + k];
+                    } else {
+                        dst_i8[d] = ((const int8_t*)w)[s + k];
+                    }
+                }
+            }
+        }
+    }
+}
+
+/* arena == NULL이면 필요한 바이트만 계산, 아니면 배치를 채우고 테이블 등록 */
+static size_t pack_pass(const weights_loader_t* loader, unsigned flags, uint8_t* arena) {
+    size_t off = 0;
+    for (int32_t i = 0; i < loader->num_tensors; i++) {
+        const tensor_info_t* t = &loader->tensors[i];
+        if (t->ndim != 4) continue;
+        int is_int8;
+        float scale;
+        const void* src = conv_src(t, &scale, &is_int8);
+        if (!src) continue;
+        const int32_t c_out = t->shape[0], c_in = t->shape[1], k_h = t->shape[2], k_w = t->shape[3];
+        const int32_t ksz = k_h * k_w;
+        const int want_wino = (flags & WEIGHT_PACK_WINOGRAD) && k_h == 3 && k_w == 3 &&
+                              is_bottleneck_cv2(t->name) &&
+                              c_in <= WINOGRAD_MAX_C && c_out <= WINOGRAD_MAX_C;
+        const int want_panel = (flags & WEIGHT_PACK_PANEL) != 0;
+        /* stem 6x6 (c_in 작음): 패널 외에 stem 커널 배치도 (stride/pad는 호출 시 확인, 아니면 GEMM 패널) */
+        const int want_stem = CONV2D_STEM && want_panel && k_h == 6 && k_w == 6 &&
+                              c_in <= CONV2D_STEM_MAX_C;
+        const int want_direct = (flags & WEIGHT_PACK_DIRECT) != 0;
+        /* FP32 원본은 DEQUANT 여부와 무관하게 FP32 배치 */
+        const int direct_f32 = want_direct && (!is_int8 || (flags & WEIGHT_PACK_DEQUANT));
+        if (!want_wino && !want_panel && !want_direct) continue;
+
+        weight_pack_t* pk = NULL;
+        if (arena) {
+            pk = pack_insert(src);
+            if (!pk) return (size_t)-1;
+            pk->c_out = c_out; pk->c_in = c_in; pk->k_h = k_h; pk->k_w = k_w;
+        }
+        if (want_wino) {
+            if (pk) {
+                pk->wino = (float*)(arena + off);
+                winograd_f2x3_transform_filter(src, scale, is_int8, c_out, c_in, pk->wino);
+            }
+            off += align_up(winograd_f2x3_filter_size(c_out, c_in) * sizeof(float));
+        }
+        const tensor_info_t* pair = want_panel ? c3_cv2_pair(loader, t) : NULL;
+        int pair_is_int8;
+        float pair_scale;
+        const void* pair_src = pair ? conv_src(pair, &pair_scale, &pair_is_int8) : NULL;
+        if (pair_src) {
+            /* [cv1 | cv2] 연결 패널: cv1 c_out이 MR 배수라 cv2 패널이 그대로 이어 붙음 */
+            const int32_t pair_c_out = pair->shape[0];
+            if (pk) {
+                pk->panel = (float*)(arena + off);
+                pk->pair_src = pair_src;
+                pk->pair_c_out = pair_c_out;
+                conv2d_gemm_pack_weights(src, scale, is_int8, c_out, c_in, 1, 1, pk->panel);
+                weight_pack_t* pp = pack_insert(pair_src);
+                if (!pp) return (size_t)-1;
+                pp->c_out = pair_c_out; pp->c_in = c_in; pp->k_h = 1; pp->k_w = 1;
+                pp->panel = pk->panel + (size_t)c_out * c_in;
+                conv2d_gemm_pack_weights(pair_src, pair_scale, pair_is_int8, pair_c_out, c_in, 1, 1, pp->panel);
+            }
+            off += align_up(conv2d_gemm_packed_size(c_out + pair_c_out, c_in, 1, 1) * sizeof(float));
+        } else if (want_panel && !is_c3_cv2_paired(loader, t)) {
+            if (pk) {
+                pk->panel = (float*)(arena + off);
+                conv2d_gemm_pack_weights(src, scale, is_int8, c_out, c_in, k_h, k_w, pk->panel);
+            }
+            off += align_up(conv2d_gemm_packed_size(c_out, c_in, k_h, k_w) * sizeof(float));
+        }
+        if (want_stem) {
+            if (pk) {
+                pk->stem = (float*)(arena + off);
+                conv2d_stem_pack_weights(src, scale, is_int8, c_out, c_in, pk->stem);
+            }
+            off += align_up(conv2d_stem_packed_size(c_out, c_in) * sizeof(float));
+        }
+        if (want_direct) {
+            const int32_t n_blk = (c_out + CONV2D_OC_BLOCK - 1) / CONV2D_OC_BLOCK;
+            const size_t elems = (size_t)n_blk * CONV2D_OC_BLOCK * (size_t)c_in * (size_t)ksz;
+            if (pk) {
+                if (direct_f32) pk->direct_f32 = (float*)(arena + off);
+                else pk->direct_i8 = (int8_t*)(arena + off);
+                pack_direct(src, scale, is_int8, c_out, c_in, ksz, pk->direct_f32, pk->direct_i8);
+            }
+            off += align_up(elems * (direct_f32 ? sizeof(float) : sizeof(int8_t)));
+        }
+    }
+    return off;
+}
+
+int weight_pack_prepare(const weights_loader_t* loader, unsigned flags) {
+    /* 메모리 부족 시 덜 중요한 FP32 사본부터 포기 */
+    static const unsigned drop_order[] = { 0u, WEIGHT_PACK_DEQUANT, WEIGHT_PACK_PANEL, WEIGHT_PACK_WINOGRAD };
+    weight_pack_release();
+    if (!loader) return -1;
+
+    for (unsigned d = 0; d < sizeof(drop_order) / sizeof(drop_order[0]); d++) {
+        flags &= ~drop_order[d];
+        const size_t need = pack_pass(loader, flags, NULL);
+        if (need == 0) return 0;
+#ifdef BARE_METAL
+        if (need > (size_t)WEIGHT_PACK_DDR_SIZE) continue;
+        uint8_t* arena = (uint8_t*)(((uintptr_t)WEIGHT_PACK_DDR_BASE + PACK_ALIGN - 1) & ~(uintptr_t)(PACK_ALIGN - 1));
+#else
+        s_arena_raw = (uint8_t*)malloc(need + PACK_ALIGN);
+        if (!s_arena_raw) continue;
+        uint8_t* arena = (uint8_t*)(((uintptr_t)s_arena_raw + PACK_ALIGN - 1) & ~(uintptr_t)(PACK_ALIGN - 1));
+#endif
+        if (pack_pass(loader, flags, arena) != need) {
+            weight_pack_release();
+            return -1;
+        }
+        s_flags = flags;
+        s_bytes = need;
+        return 0;
+    }
+    return -1;
+}
+
+unsigned weight_pack_flags(void) {
+    return s_flags;
+}
+
+size_t weight_pack_bytes(void) {
+    return s_bytes;
+}
+
+void weight_pack_release(void) {
+#ifndef BARE_METAL
+    if (s_arena_raw) free(s_arena_raw);
+    s_arena_raw = NULL;
+#endif
+    memset(s_packs, 0, sizeof(s_packs));
+    memset(s_hash, 0, sizeof(s_hash));
+    s_num_packs = 0;
+    s_flags = 0;
+    s_bytes = 0;
+}
@@ -0,0 +1,44 @@
+#ifndef WEIGHT_PACK_H
+#define WEIGHT_PACK_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "../utils/weights_loader.h"
+
+/* 로드 직후 1회 수행하는 conv 가중치 재배치/변환 캐시.
+ * 원본 가중치 포인터(W_CONV 반환값)를 key로 조회 → conv 호출 시 변환 비용 없음.
+ * 모든 배치는 64B 정렬, oc 끝 블록은 0 패딩. 메모리: 호스트 malloc 1회, BARE_METAL WEIGHT_PACK_DDR_BASE. */
+
+#define WEIGHT_PACK_WINOGRAD 0x1u  /* C3 bottleneck cv2 (3x3 s1): Winograd F(2x2,3x3) U */
+#define WEIGHT_PACK_PANEL    0x2u  /* FP32 [oc/MR][ic*kh*kw][MR]: GEMM A 패널 / 1x1 SIMD (+ 6x6 stem 패널) */
+#define WEIGHT_PACK_DIRECT   0x4u  /* [oc/OCB][ic][OCB][kh*kw]: direct 커널 (INT8 그대로) */
+#define WEIGHT_PACK_DEQUANT  0x8u  /* DIRECT 배치를 FP32(w*scale)로 복원해 둠 (메모리 4배) */
+
+typedef struct {
+    const void* src;        /* 원본 OIHW (float* 또는 int8_t*) */
+    int32_t c_out, c_in, k_h, k_w;
+    float* wino;            /* [16][c_out][c_in], 없으면 NULL */
+    float* panel;           /* FP32 [ceil(c_out/CONV2D_GEMM_MR)][c_in*kh*kw][CONV2D_GEMM_MR] */
+    float* stem;            /* FP32 [ceil(c_out/4)][c_in][6][6][4] (6x6, c_in <= CONV2D_STEM_MAX_C), 없으면 NULL */
+    float* direct_f32;      /* FP32 [ceil(c_out/CONV2D_OC_BLOCK)][c_in][CONV2D_OC_BLOCK][kh*kw] */
+    int8_t* direct_i8;      /* INT8 동일 배치 (DEQUANT 없을 때) */
+    /* C3 cv1: 같은 입력의 1x1 짝(cv2). 있으면 panel 바로 뒤에 짝의 panel이 이어져
+     * panel = [cv1 | cv2] c_out + pair_c_out 채널 연결 패널 (1x1 한 패스로 둘 다 계산) */
+    const void* pair_src;
+    int32_t pair_c_out;
+} weight_pack_t;
+
+/** 로드된 텐서들을 훑어 flags에 해당하는 배치를 만들어 둔다.
+ *  메모리가 부족하면 DEQUANT → PANEL → WINOGRAD 순으로 빼고 재시도. 0 성공, -1 실패 */
+int weight_pack_prepare(const weights_loader_t* loader, unsigned flags);
+
+/** 원본 포인터로 변환 결과 조회. 없으면 NULL */
+const weight_pack_t* weight_pack_find(const void* src);
+
+/** 실제 적용된 flags / 사용 바이트 (로그용) */
+unsigned weight_pack_flags(void);
+size_t weight_pack_bytes(void);
+
+void weight_pack_release(void);
+
+#endif // WEIGHT_PACK_H
@@ -2,7 +2,7 @@
  * 플랫폼 설정 (BARE_METAL: Vitis DDR 맵, 호스트: 무관)
  * BARE_METAL 시 xparameters.h 로 XPAR_* 덮어쓰기 가능.
  * DDR 맵: 0x80000000 코드/스택/힙 32MB, 0x82000000 피처맵 풀 32MB,
- *         0x88000000 가중치 16MB, 0x8E000000 Detect 9MB, 0x8F000000 이미지+결과 16MB.
+ *         0x88000000 가중치 16MB (뒤 8MB: weight_pack 재배치), 0x8E000000 Detect 9MB, 0x8F000000 이미지+결과 16MB.
  */
 #ifndef PLATFORM_CONFIG_H
 #define PLATFORM_CONFIG_H
@@ -32,6 +32,14 @@
 #define WEIGHTS_W8_DDR_SIZE  (4u * 1024u * 1024u)  /* ~2MB */
 #endif
 
+/* 로드 시 재배치된 conv 가중치 (weight_pack). 가중치 영역 뒤 8MB (FP32 weights.bin ~7.6MB 이후) */
+#ifndef WEIGHT_PACK_DDR_BASE
+#define WEIGHT_PACK_DDR_BASE  (WEIGHTS_DDR_BASE + 0x00800000u)
+#endif
+#ifndef WEIGHT_PACK_DDR_SIZE
+#define WEIGHT_PACK_DDR_SIZE  (WEIGHTS_DDR_SIZE - 0x00800000u)
+#endif
+
 #ifndef DETECT_HEAD_BASE
 #define DETECT_HEAD_BASE  (PLATFORM_DDR_BASE + 0x0E000000u)
 #endif
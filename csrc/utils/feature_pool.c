@@ -34,11 +34,16 @@ static inline size_t align_up(size_t x, size_t a) {
 }
 
 void feature_pool_init(void) {
+    feature_pool_init_bytes(FEATURE_POOL_HOST_SIZE);
+}
+
+void feature_pool_init_bytes(size_t bytes) {
 #ifdef BARE_METAL
+    (void)bytes;
     pool_base = (uint8_t*)FEATURE_POOL_BASE;
     pool_size = FEATURE_POOL_SIZE;
 #else
-    pool_size = 22u * 1024u * 1024u;  /* 호스트: 22MB */
+    pool_size = bytes;
     host_pool = (uint8_t*)malloc(pool_size);
     pool_base = host_pool;
     if (!pool_base) pool_size = 0;
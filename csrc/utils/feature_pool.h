@@ -11,7 +11,12 @@
 extern "C" {
 #endif
 
+/* 호스트 기본 풀 크기 (batch 1 피크 기준) */
+#define FEATURE_POOL_HOST_SIZE (22u * 1024u * 1024u)
+
 void feature_pool_init(void);
+/** 호스트: bytes 크기로 생성 (batch N은 N배). BARE_METAL: 무시하고 FEATURE_POOL_SIZE 사용 */
+void feature_pool_init_bytes(size_t bytes);
 void* feature_pool_alloc(size_t size);
 void feature_pool_free(void* ptr);
 void feature_pool_reset(void);
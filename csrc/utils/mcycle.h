@@ -1,7 +1,7 @@
 /**
  * 단계별 시간/사이클 측정
  * - BARE_METAL (MicroBlaze V / RISC-V): mcycle + mcycleh → 64비트 사이클
- * - 호스트: 고해상도 타이머 → 마이크로초 (출력 시 ms/sec)
+ * - 호스트: 단조 시계 → 마이크로초 (출력 시 ms/sec), 벤치마크는 host_time_ns
  * 파일 I/O 없음.
  */
 #ifndef MCYCLE_H
@@ -50,26 +50,42 @@ static inline uint64_t mcycle_delta64(uint64_t start, uint64_t end) {
 
 #else
 
-/* -------- 호스트: 고해상도 타이머 (마이크로초) -------- */
+/* -------- 호스트: 단조 시계 (나노초 → 마이크로초) --------
+ * POSIX는 CLOCK_MONOTONIC (시계 조정·NTP에 영향 없음). 시계를 읽는 번역 단위는 include 전에
+ * _POSIX_C_SOURCE를 정의해 두므로 -std=c99에서도 같은 시계. 선언이 없는 환경만 gettimeofday */
 #if defined(_WIN32) || defined(_WIN64)
 #include <windows.h>
-static inline uint64_t host_time_us(void) {
+static inline uint64_t host_time_ns(void) {
     static LARGE_INTEGER freq = { 0 };
     LARGE_INTEGER c;
     if (freq.QuadPart == 0)
         QueryPerformanceFrequency(&freq);
     QueryPerformanceCounter(&c);
-    return (uint64_t)((double)c.QuadPart * 1000000.0 / (double)freq.QuadPart);
+    /* 초와 나머지로 나눠 정수 환산 (double은 uptime이 길면 µs 단위 정밀도 손실) */
+    const uint64_t f = (uint64_t)freq.QuadPart, t = (uint64_t)c.QuadPart;
+    return t / f * 1000000000ULL + t % f * 1000000000ULL / f;
 }
 #else
+#include <stddef.h>
+#include <time.h>
 #include <sys/time.h>
-static inline uint64_t host_time_us(void) {
+static inline uint64_t host_time_ns(void) {
+#if defined(CLOCK_MONOTONIC)
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+#else
     struct timeval tv;
     gettimeofday(&tv, NULL);
-    return (uint64_t)tv.tv_sec * 1000000ULL + (uint64_t)tv.tv_usec;
+    return (uint64_t)tv.tv_sec * 1000000000ULL + (uint64_t)tv.tv_usec * 1000ULL;
+#endif
 }
 #endif
 
+static inline uint64_t host_time_us(void) {
+    return host_time_ns() / 1000ULL;
+}
+
 static inline uint64_t timer_delta64(uint64_t start, uint64_t end) {
     return end - start;
 }
@@ -0,0 +1,87 @@
+/**
+ * 정적 메모리 플래너 (greedy by size + best-fit).
+ * 큰 버퍼부터, 수명이 겹치는 이미 배치된 버퍼들 사이의 빈 구간 중
+ * 들어가는 가장 작은 구간에 놓고, 없으면 그 위에 쌓는다.
+ */
+#include "memory_plan.h"
+
+static size_t align_up(size_t x) {
+    return (x + MEMORY_PLAN_ALIGN - 1u) & ~(size_t)(MEMORY_PLAN_ALIGN - 1u);
+}
+
+static int lifetimes_overlap(const memory_plan_buf_t* a, const memory_plan_buf_t* b) {
+    return a->first <= b->last && b->first <= a->last;
+}
+
+size_t memory_plan_solve(memory_plan_buf_t* bufs, int32_t count, size_t* lower_bound_out) {
+    int32_t order[MEMORY_PLAN_MAX_BUFS];
+    int32_t placed[MEMORY_PLAN_MAX_BUFS];
+    int32_t n_placed = 0;
+    size_t peak = 0;
+
+    if (lower_bound_out) *lower_bound_out = 0;
+    if (!bufs || count <= 0 || count > MEMORY_PLAN_MAX_BUFS) return 0;
+
+    /* 크기 내림차순, 같으면 먼저 생성되는 순 (삽입 정렬, 버퍼 수 수십 개) */
+    for (int32_t i = 0; i < count; i++) {
+        int32_t j = i;
+        bufs[i].offset = 0;
+        while (j > 0) {
+            const memory_plan_buf_t* p = &bufs[order[j - 1]];
+            if (p->size > bufs[i].size || (p->size == bufs[i].size && p->first <= bufs[i].first)) break;
+            order[j] = order[j - 1];
+            j--;
+        }
+        order[j] = i;
+    }
+
+    for (int32_t k = 0; k < count; k++) {
+        memory_plan_buf_t* b = &bufs[order[k]];
+        if (b->size == 0) continue;
+        const size_t need = align_up(b->size);
+
+        /* 수명이 겹치는 배치 완료 버퍼를 오프셋 순으로 */
+        int32_t conf[MEMORY_PLAN_MAX_BUFS];
+        int32_t n_conf = 0;
+        for (int32_t i = 0; i < n_placed; i++) {
+            const memory_plan_buf_t* q = &bufs[placed[i]];
+            if (!lifetimes_overlap(b, q)) continue;
+            int32_t j = n_conf++;
+            while (j > 0 && bufs[conf[j - 1]].offset > q->offset) {
+                conf[j] = conf[j - 1];
+                j--;
+            }
+            conf[j] = placed[i];
+        }
+
+        /* 빈 구간 중 들어가는 최소 구간 (best-fit), 없으면 맨 위 */
+        size_t best = (size_t)-1, best_gap = (size_t)-1, top = 0;
+        for (int32_t i = 0; i < n_conf; i++) {
+            const memory_plan_buf_t* q = &bufs[conf[i]];
+            if (q->offset > top && q->offset - top >= need && q->offset - top < best_gap) {
+                best_gap = q->offset - top;
+                best = top;
+            }
+            const size_t end = q->offset + align_up(q->size);
+            if (end > top) top = end;
+        }
+        b->offset = (best != (size_t)-1) ? best : top;
+        if (b->offset + need > peak) peak = b->offset + need;
+        placed[n_placed++] = order[k];
+    }
+
+    if (lower_bound_out) {
+        /* step별 live 합의 최댓값 (수명 경계 step만 보면 충분) */
+        size_t lb = 0;
+        for (int32_t i = 0; i < count; i++) {
+            size_t live = 0;
+            for (int32_t j = 0; j < count; j++) {
+                if (bufs[j].first <= bufs[i].first && bufs[i].first <= bufs[j].last)
+                    live += align_up(bufs[j].size);
+            }
+            if (live > lb) lb = live;
+        }
+        *lower_bound_out = lb;
+    }
+    return peak;
+}
@@ -0,0 +1,37 @@
+/**
+ * 정적 메모리 플래너: 그래프가 고정이므로 버퍼별 수명 [first, last] step을 미리 알고
+ * 시작 시 1회 오프셋을 정한다 (크기 큰 순 + best-fit 구간 배치).
+ * 같은 step에 살아 있는 버퍼끼리는 주소가 겹치지 않음 → 추론 중 할당/해제 호출 없음.
+ */
+#ifndef MEMORY_PLAN_H
+#define MEMORY_PLAN_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define MEMORY_PLAN_MAX_BUFS 64
+#define MEMORY_PLAN_ALIGN    64u   /* 캐시 라인 / SIMD 정렬 */
+
+typedef struct {
+    const char* name;
+    size_t size;      /* 바이트 (0이면 배치하지 않음, offset 0) */
+    int32_t first;    /* 생성 step */
+    int32_t last;     /* 마지막 사용 step (포함) */
+    size_t offset;    /* 결과: arena 기준 오프셋 (MEMORY_PLAN_ALIGN 배수) */
+} memory_plan_buf_t;
+
+/**
+ * bufs[0..count) 오프셋 배치. 반환: arena 크기(배치 결과 최대 끝 주소), 실패 시 0.
+ * lower_bound_out(선택): 어떤 배치로도 못 줄이는 하한 = step별 살아 있는 크기 합의 최댓값
+ */
+size_t memory_plan_solve(memory_plan_buf_t* bufs, int32_t count, size_t* lower_bound_out);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MEMORY_PLAN_H */
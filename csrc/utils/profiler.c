@@ -0,0 +1,213 @@
+/**
+ * 계층 프로파일러 구현. 이벤트는 닫힐 때 BSS 배열에 기록 (슬롯은 원자적 증가, 넘치면 dropped만 셈).
+ * 스코프 스택은 호출 스레드 전용 (워커는 prof_task만).
+ */
+#if !defined(BARE_METAL) && !defined(_WIN32) && !defined(_POSIX_C_SOURCE) && !defined(_DEFAULT_SOURCE)
+#define _POSIX_C_SOURCE 199309L  /* mcycle.h: -std=c99에서 clock_gettime(CLOCK_MONOTONIC) */
+#endif
+#include "profiler.h"
+
+#if YOLO_PROFILE
+
+#include <stddef.h>
+#include <string.h>
+#include "mcycle.h"
+
+#ifdef BARE_METAL
+#include "../platform_config.h"
+#include "xil_printf.h"
+#ifndef CPU_MHZ
+#define CPU_MHZ 100
+#endif
+#define PROF_LOG(...) xil_printf(__VA_ARGS__)
+#else
+#include <stdio.h>
+#define PROF_LOG(...) printf(__VA_ARGS__)
+#endif
+
+typedef struct {
+    const char* name;
+    uint64_t t0;
+    uint64_t child;   /* 직속 자식 스코프 시간 합 */
+} prof_frame_t;
+
+static prof_event_t s_events[PROF_MAX_EVENTS];
+static volatile int32_t s_next;
+static volatile int32_t s_dropped;
+static int s_enabled = YOLO_PROFILE_DEFAULT;
+static uint64_t s_base;
+static prof_frame_t s_stack[PROF_MAX_DEPTH];
+static int32_t s_depth;
+static int32_t s_skip;   /* 스택 초과로 기록하지 않은 begin 수 (end 짝 맞춤) */
+
+/* yolo_timing_set_layer 번호 (0..23: L0..L23, 24: det, 25: dec, 26: nms) */
+static const char* const s_layer_names[] = {
+    "L0", "L1", "L2", "L3", "L4", "L5", "L6", "L7", "L8", "L9", "L10", "L11",
+    "L12", "L13", "L14", "L15", "L16", "L17", "L18", "L19", "L20", "L21", "L22", "L23",
+    "det", "dec", "nms"
+};
+#define PROF_NUM_LAYERS ((int)(sizeof(s_layer_names) / sizeof(s_layer_names[0])))
+
+static void push_event(const char* name, uint64_t t0, uint64_t dur, uint64_t self, int32_t tid, int32_t depth) {
+    const int32_t i = __sync_fetch_and_add(&s_next, 1);
+    if (i >= PROF_MAX_EVENTS) {
+        __sync_fetch_and_add(&s_dropped, 1);
+        return;
+    }
+    prof_event_t* e = &s_events[i];
+    e->name = name;
+    e->t0 = t0 > s_base ? t0 - s_base : 0;
+    e->dur = dur;
+    e->self = self;
+    e->tid = (int16_t)tid;
+    e->depth = (int16_t)depth;
+}
+
+void prof_enable(int on) {
+    s_enabled = on != 0;
+}
+
+int prof_enabled(void) {
+    return s_enabled;
+}
+
+void prof_reset(void) {
+    s_next = 0;
+    s_dropped = 0;
+    s_depth = 0;
+    s_skip = 0;
+    s_base = timer_read64();
+}
+
+void prof_begin(const char* name) {
+    if (!s_enabled) return;
+    if (s_depth >= PROF_MAX_DEPTH) { s_skip++; return; }
+    s_stack[s_depth].name = name;
+    s_stack[s_depth].child = 0;
+    s_stack[s_depth].t0 = timer_read64();
+    s_depth++;
+}
+
+void prof_end(void) {
+    if (!s_enabled) return;
+    if (s_skip > 0) { s_skip--; return; }
+    if (s_depth <= 0) return;
+    const uint64_t t1 = timer_read64();
+    const prof_frame_t* f = &s_stack[--s_depth];
+    const uint64_t dur = timer_delta64(f->t0, t1);
+    if (s_depth > 0) s_stack[s_depth - 1].child += dur;
+    push_event(f->name, f->t0, dur, dur > f->child ? dur - f->child : 0, 0, s_depth);
+}
+
+void prof_layer(int layer_id) {
+    if (!s_enabled) return;
+    s_skip = 0;
+    while (s_depth > 0) prof_end();
+    if (layer_id >= 0 && layer_id < PROF_NUM_LAYERS) prof_begin(s_layer_names[layer_id]);
+}
+
+void prof_task(int32_t tid, uint64_t t0, uint64_t t1) {
+    if (!s_enabled) return;
+    const uint64_t dur = timer_delta64(t0, t1);
+    push_event("task", t0, dur, dur, tid, -1);
+}
+
+int32_t prof_count(void) {
+    return s_next < PROF_MAX_EVENTS ? s_next : PROF_MAX_EVENTS;
+}
+
+int32_t prof_dropped(void) {
+    return s_dropped;
+}
+
+const prof_event_t* prof_events(void) {
+    return s_events;
+}
+
+#ifndef BARE_METAL
+
+int prof_write_chrome_trace(const char* path) {
+    FILE* f = fopen(path, "w");
+    if (!f) return -1;
+    const int32_t n = prof_count();
+    /* 호스트 시각 단위가 µs → trace_event ts/dur 그대로 */
+    fprintf(f, "{\"displayTimeUnit\":\"ms\",\"otherData\":{\"clock\":\"us\",\"events\":%d,\"dropped\":%d},\n",
+            (int)n, (int)s_dropped);
+    fprintf(f, "\"traceEvents\":[\n");
+    fprintf(f, "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"tid\":0,\"args\":{\"name\":\"yolov5n\"}}");
+    for (int32_t i = 0; i < n; i++) {
+        const prof_event_t* e = &s_events[i];
+        const char* cat = e->depth < 0 ? "task" : e->depth == 0 ? "layer" : "scope";
+        fprintf(f, ",\n{\"name\":\"%s\",\"cat\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":%d,"
+                   "\"ts\":%llu,\"dur\":%llu,\"args\":{\"depth\":%d,\"self\":%llu}}",
+                e->name, cat, (int)e->tid, (unsigned long long)e->t0, (unsigned long long)e->dur,
+                (int)e->depth, (unsigned long long)e->self);
+    }
+    fprintf(f, "\n]}\n");
+    return fclose(f) == 0 ? 0 : -1;
+}
+
+#define PROF_CSV_ROWS 256
+
+typedef struct {
+    const char* name;
+    int32_t depth, tid;
+    int32_t count;
+    uint64_t total, self, max;
+} prof_row_t;
+
+int prof_write_csv(const char* path) {
+    static prof_row_t rows[PROF_CSV_ROWS];
+    int32_t n_rows = 0;
+    const int32_t n = prof_count();
+    /* (깊이, 이름) 별 집계, 작업 구간은 스레드별. 첫 등장 순서 유지 */
+    for (int32_t i = 0; i < n; i++) {
+        const prof_event_t* e = &s_events[i];
+        const int32_t tid = e->depth < 0 ? e->tid : 0;
+        int32_t r = 0;
+        while (r < n_rows && !(rows[r].depth == e->depth && rows[r].tid == tid && strcmp(rows[r].name, e->name) == 0))
+            r++;
+        if (r == n_rows) {
+            if (n_rows >= PROF_CSV_ROWS) continue;
+            memset(&rows[r], 0, sizeof(rows[r]));
+            rows[r].name = e->name;
+            rows[r].depth = e->depth;
+            rows[r].tid = tid;
+            n_rows++;
+        }
+        rows[r].count++;
+        rows[r].total += e->dur;
+        rows[r].self += e->self;
+        if (e->dur > rows[r].max) rows[r].max = e->dur;
+    }
+    FILE* f = fopen(path, "w");
+    if (!f) return -1;
+    fprintf(f, "depth,name,tid,count,total_us,self_us,mean_us,max_us\n");
+    for (int32_t r = 0; r < n_rows; r++) {
+        fprintf(f, "%d,%s,%d,%d,%llu,%llu,%.1f,%llu\n", (int)rows[r].depth, rows[r].name, (int)rows[r].tid,
+                (int)rows[r].count, (unsigned long long)rows[r].total, (unsigned long long)rows[r].self,
+                (double)rows[r].total / (double)rows[r].count, (unsigned long long)rows[r].max);
+    }
+    return fclose(f) == 0 ? 0 : -1;
+}
+
+#endif /* !BARE_METAL */
+
+void prof_dump_text(void) {
+    const int32_t n = prof_count();
+#ifdef BARE_METAL
+    PROF_LOG("PROF %d %d %d\n", (int)CPU_MHZ, (int)n, (int)s_dropped);
+#else
+    PROF_LOG("PROF 1 %d %d\n", (int)n, (int)s_dropped);
+#endif
+    for (int32_t i = 0; i < n; i++) {
+        const prof_event_t* e = &s_events[i];
+        PROF_LOG("P %d %d %s %llu %llu %llu\n", (int)e->tid, (int)e->depth, e->name,
+                 (unsigned long long)e->t0, (unsigned long long)e->dur, (unsigned long long)e->self);
+    }
+    PROF_LOG("PROF END\n");
+}
+
+#else
+typedef int prof_disabled_t;  /* 빈 번역 단위 방지 */
+#endif /* YOLO_PROFILE */
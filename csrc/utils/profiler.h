@@ -0,0 +1,88 @@
+/**
+ * 계층 프로파일러: 레이어 → 블록 → 연산 스코프 중첩 + thread_pool 작업 구간(스레드별).
+ * 이벤트마다 시작 시각·길이·self 시간·깊이·tid 기록 → Chrome trace_event JSON / CSV 요약
+ * (호스트: 파일), BARE_METAL: UART 한 줄씩 (tools/prof_uart_to_trace.py로 JSON/CSV 변환).
+ *
+ * - 레이어 스코프: yolo_timing_set_layer가 prof_layer로 전환 (이전 레이어 스코프를 닫고 새로 엶)
+ * - 블록 스코프: c3/sppf/conv/head 블록이 prof_begin/prof_end
+ * - 연산 스코프: yolo_timing_begin/end가 그대로 prof_begin/prof_end
+ * - 작업 구간: thread_pool_run에서 스레드마다 1개 (tid 0 = 호출 스레드)
+ * 스코프 begin/end는 호출 스레드 전용. 이름은 정적 문자열 (포인터만 저장).
+ * 시각 단위: timer_read64 (호스트 µs, BARE_METAL mcycle).
+ */
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include <stdint.h>
+
+/* 0이면 모든 훅이 빈 함수 (코드/BSS 없음) */
+#ifndef YOLO_PROFILE
+#define YOLO_PROFILE 1
+#endif
+
+/* 기본 활성 여부 (호스트는 main --profile, BARE_METAL은 -DYOLO_PROFILE_DEFAULT=1로 UART 덤프) */
+#ifndef YOLO_PROFILE_DEFAULT
+#define YOLO_PROFILE_DEFAULT 0
+#endif
+
+#ifndef PROF_MAX_EVENTS
+#ifdef BARE_METAL
+#define PROF_MAX_EVENTS 2048
+#else
+#define PROF_MAX_EVENTS 16384
+#endif
+#endif
+#define PROF_MAX_DEPTH 16
+
+typedef struct {
+    const char* name;
+    uint64_t t0;      /* 시작 (prof_reset 기준 상대) */
+    uint64_t dur;
+    uint64_t self;    /* dur - 직속 자식 스코프 합 (작업 구간은 dur) */
+    int16_t tid;      /* 0 = 호출 스레드, 1.. = 워커 */
+    int16_t depth;    /* 0 = 레이어, 작업 구간은 -1 */
+} prof_event_t;
+
+#if YOLO_PROFILE
+void prof_enable(int on);
+int prof_enabled(void);
+/** 이벤트 비우고 기준 시각 재설정 (추론 시작 시) */
+void prof_reset(void);
+void prof_begin(const char* name);
+void prof_end(void);
+/** 레이어 전환: 열린 스코프를 모두 닫고 layer_id 스코프를 엶. 음수면 닫기만 */
+void prof_layer(int layer_id);
+/** thread_pool 작업 구간 (워커에서 호출 가능, 이벤트 슬롯은 원자적으로 확보) */
+void prof_task(int32_t tid, uint64_t t0, uint64_t t1);
+
+int32_t prof_count(void);
+int32_t prof_dropped(void);
+const prof_event_t* prof_events(void);
+
+#ifndef BARE_METAL
+/** Chrome trace_event JSON (chrome://tracing, Perfetto). 0 성공 */
+int prof_write_chrome_trace(const char* path);
+/** CSV 요약: 스코프 (깊이, 이름)별 호출 수, 합계/self/평균/최대. 0 성공 */
+int prof_write_csv(const char* path);
+#endif
+/** UART(BARE_METAL) / stdout(호스트) 한 줄씩 덤프: "PROF <mhz> <count> <dropped>", "P <tid> <depth> <name> <t0> <dur> <self>", "PROF END" */
+void prof_dump_text(void);
+#else
+static inline void prof_enable(int on) { (void)on; }
+static inline int prof_enabled(void) { return 0; }
+static inline void prof_reset(void) {}
+static inline void prof_begin(const char* name) { (void)name; }
+static inline void prof_end(void) {}
+static inline void prof_layer(int layer_id) { (void)layer_id; }
+static inline void prof_task(int32_t tid, uint64_t t0, uint64_t t1) { (void)tid; (void)t0; (void)t1; }
+static inline int32_t prof_count(void) { return 0; }
+static inline int32_t prof_dropped(void) { return 0; }
+static inline const prof_event_t* prof_events(void) { return 0; }
+#ifndef BARE_METAL
+static inline int prof_write_chrome_trace(const char* path) { (void)path; return -1; }
+static inline int prof_write_csv(const char* path) { (void)path; return -1; }
+#endif
+static inline void prof_dump_text(void) {}
+#endif
+
+#endif /* PROFILER_H */
@@ -0,0 +1,125 @@
+/**
+ * Roofline 계정 구현. 레이어 번호는 timing 모듈의 현재 레이어를 따름.
+ * 출력은 정수만 (xil_printf %f 미지원): 비율은 소수 둘째 자리 고정소수점.
+ */
+#include "roofline.h"
+#include "timing.h"
+
+#ifdef BARE_METAL
+#include "../platform_config.h"
+#include "xil_printf.h"
+#ifndef CPU_MHZ
+#define CPU_MHZ 100
+#endif
+#define ROOFLINE_TICK_MHZ ((uint64_t)CPU_MHZ)
+#define ROOFLINE_LOG(...) xil_printf(__VA_ARGS__)
+#else
+#include <stdio.h>
+#define ROOFLINE_TICK_MHZ 1ULL   /* host_time_us: 1 tick = 1 µs */
+#define ROOFLINE_LOG(...) printf(__VA_ARGS__)
+#endif
+
+static uint64_t work_bytes(const roofline_work_t* w) {
+    return w->weight_bytes + w->act_read + w->act_write;
+}
+
+uint32_t roofline_mflops(const roofline_work_t* w, uint64_t ticks) {
+    if (!w || ticks == 0) return 0;
+    return (uint32_t)(2ULL * w->macs * ROOFLINE_TICK_MHZ / ticks);
+}
+
+uint32_t roofline_mbps(const roofline_work_t* w, uint64_t ticks) {
+    if (!w || ticks == 0) return 0;
+    return (uint32_t)(work_bytes(w) * ROOFLINE_TICK_MHZ / ticks);
+}
+
+#if YOLO_ROOFLINE
+
+static roofline_work_t s_work[ROOFLINE_LAYERS];
+
+void roofline_reset(void) {
+    for (int i = 0; i < ROOFLINE_LAYERS; i++) {
+        s_work[i].macs = 0;
+        s_work[i].weight_bytes = 0;
+        s_work[i].act_read = 0;
+        s_work[i].act_write = 0;
+    }
+}
+
+void roofline_add(uint64_t macs, uint64_t weight_bytes, uint64_t act_read, uint64_t act_write) {
+    const int l = yolo_timing_get_layer();
+    if (l < 0 || l >= ROOFLINE_LAYERS) return;
+    s_work[l].macs += macs;
+    s_work[l].weight_bytes += weight_bytes;
+    s_work[l].act_read += act_read;
+    s_work[l].act_write += act_write;
+}
+
+void roofline_conv(int32_t n, int32_t c_in, int32_t h_in, int32_t w_in, int32_t c_out,
+                   int32_t k_h, int32_t k_w, int32_t h_out, int32_t w_out, int w_is_int8) {
+    const uint64_t out = (uint64_t)n * (uint64_t)c_out * (uint64_t)h_out * (uint64_t)w_out;
+    const uint64_t k = (uint64_t)c_in * (uint64_t)k_h * (uint64_t)k_w;
+    roofline_add(out * k,
+                 (uint64_t)c_out * k * (w_is_int8 ? 1u : 4u) + (uint64_t)c_out * 4u,
+                 (uint64_t)n * (uint64_t)c_in * (uint64_t)h_in * (uint64_t)w_in * 4u,
+                 out * 4u);
+}
+
+const roofline_work_t* roofline_layer(int layer_id) {
+    if (layer_id < 0 || layer_id >= ROOFLINE_LAYERS) return 0;
+    return &s_work[layer_id];
+}
+
+/* x100 고정소수점 "a.bc" */
+static void log_fix2(uint64_t v100) {
+    ROOFLINE_LOG(" %5llu.%02u", (unsigned long long)(v100 / 100u), (unsigned)(v100 % 100u));
+}
+
+static void log_row(const char* name, int idx, const roofline_work_t* w, uint64_t ticks) {
+    const uint64_t flops = 2ULL * w->macs, bytes = work_bytes(w);
+    const uint64_t ai100 = bytes ? flops * 100u / bytes : 0;
+    const uint64_t mf = roofline_mflops(w, ticks), mb = roofline_mbps(w, ticks);
+    /* roof = min(peak, 강도 · 대역폭) [MFLOP/s]. FLOP 없는 구간은 대역폭 roof 대비 */
+    const uint64_t bw_roof = bytes ? flops * (uint64_t)ROOFLINE_PEAK_MBPS / bytes : 0;
+    const uint64_t roof = bw_roof < (uint64_t)ROOFLINE_PEAK_MFLOPS ? bw_roof : (uint64_t)ROOFLINE_PEAK_MFLOPS;
+    const uint64_t pct = flops ? (roof ? mf * 100u / roof : 0) : mb * 100u / (uint64_t)ROOFLINE_PEAK_MBPS;
+    const int mem = (uint64_t)ROOFLINE_PEAK_MBPS * ai100 < (uint64_t)ROOFLINE_PEAK_MFLOPS * 100u;
+    if (idx >= 0) ROOFLINE_LOG("  L%-4d", idx);
+    else ROOFLINE_LOG("  %-5s", name);
+    ROOFLINE_LOG(" %10llu %8llu %7llu %8llu", (unsigned long long)(ticks / ROOFLINE_TICK_MHZ),
+                 (unsigned long long)(flops / 1000000u), (unsigned long long)(w->weight_bytes / 1024u),
+                 (unsigned long long)((w->act_read + w->act_write) / 1024u));
+    log_fix2(ai100);
+    ROOFLINE_LOG(" %8llu %8llu %5llu%%  %s\n", (unsigned long long)mf, (unsigned long long)mb,
+                 (unsigned long long)pct, mem ? "mem" : "compute");
+}
+
+void roofline_print_summary(const uint64_t ticks[ROOFLINE_LAYERS]) {
+    static const char* const names[3] = { "det", "dec", "nms" };
+    roofline_work_t total = { 0, 0, 0, 0 };
+    uint64_t total_ticks = 0;
+    const uint64_t ridge100 = (uint64_t)ROOFLINE_PEAK_MFLOPS * 100u / (uint64_t)ROOFLINE_PEAK_MBPS;
+    ROOFLINE_LOG("[roofline] peak %u MFLOP/s, %u MB/s, ridge %llu.%02u FLOP/B\n",
+                 (unsigned)ROOFLINE_PEAK_MFLOPS, (unsigned)ROOFLINE_PEAK_MBPS,
+                 (unsigned long long)(ridge100 / 100u), (unsigned)(ridge100 % 100u));
+    ROOFLINE_LOG("  layer         us    MFLOP     wKB    actKB   FLOP/B  MFLOP/s     MB/s  roof%%  bound\n");
+    for (int l = 0; l < ROOFLINE_LAYERS; l++) {
+        const roofline_work_t* w = &s_work[l];
+        if (ticks[l] == 0 || work_bytes(w) == 0) continue;
+        log_row(l < 24 ? 0 : names[l - 24], l < 24 ? l : -1, w, ticks[l]);
+        total.macs += w->macs;
+        total.weight_bytes += w->weight_bytes;
+        total.act_read += w->act_read;
+        total.act_write += w->act_write;
+        total_ticks += ticks[l];
+    }
+    log_row("total", -1, &total, total_ticks);
+}
+
+#else
+
+void roofline_print_summary(const uint64_t ticks[ROOFLINE_LAYERS]) {
+    (void)ticks;
+}
+
+#endif /* YOLO_ROOFLINE */
@@ -0,0 +1,79 @@
+/**
+ * Roofline 계정: conv/C3/SPPF/Detect 호출마다 shape로 MAC·가중치 바이트·활성값 읽기/쓰기 바이트를 계산해
+ * 현재 레이어(yolo_timing_set_layer 번호)에 누적 → 레이어 시간과 합쳐 달성 MFLOP/s·MB/s, 연산 강도(FLOP/B),
+ * compute/memory bound 판정.
+ *
+ * 바이트는 compulsory 모델: 각 conv가 입력을 한 번 읽고 출력을 한 번 쓰고 가중치를 한 번 읽는다고 봄
+ * (캐시 재사용·타일 재읽기 제외, 융합으로 실제로 안 읽는 중간 버퍼는 블록에서 빼지 않음 → 상한).
+ * 1 MAC = 2 FLOP. 시각 단위는 timer_read64 (호스트 µs, BARE_METAL mcycle).
+ */
+#ifndef ROOFLINE_H
+#define ROOFLINE_H
+
+#include <stdint.h>
+
+#ifndef YOLO_ROOFLINE
+#define YOLO_ROOFLINE 1
+#endif
+
+/* 레이어 번호 (0..23: L0..L23, 24: det, 25: dec, 26: nms) */
+#define ROOFLINE_LAYERS 27
+
+/* 판정용 최고 성능 (-D로 측정값 지정). 호스트: AVX2+FMA 1코어 / 2채널 DDR4 근사,
+ * BARE_METAL: FPU 1 FLOP/cycle, 32비트 AXI 1 beat/cycle */
+#ifndef ROOFLINE_PEAK_MFLOPS
+#ifdef BARE_METAL
+#define ROOFLINE_PEAK_MFLOPS 100
+#else
+#define ROOFLINE_PEAK_MFLOPS 100000
+#endif
+#endif
+#ifndef ROOFLINE_PEAK_MBPS
+#ifdef BARE_METAL
+#define ROOFLINE_PEAK_MBPS 400
+#else
+#define ROOFLINE_PEAK_MBPS 20000
+#endif
+#endif
+
+typedef struct {
+    uint64_t macs;
+    uint64_t weight_bytes;   /* 가중치 + bias */
+    uint64_t act_read;       /* 입력 활성값 (residual 포함) */
+    uint64_t act_write;
+} roofline_work_t;
+
+#if YOLO_ROOFLINE
+/** 누적 비우기 (추론 시작 시) */
+void roofline_reset(void);
+/** 현재 레이어에 직접 누적 (maxpool, sparse head 등) */
+void roofline_add(uint64_t macs, uint64_t weight_bytes, uint64_t act_read, uint64_t act_write);
+/** conv 1회: MAC = n·c_out·h_out·w_out·c_in·k_h·k_w, 가중치 INT8 1B / FP32 4B + bias 4B·c_out */
+void roofline_conv(int32_t n, int32_t c_in, int32_t h_in, int32_t w_in, int32_t c_out,
+                   int32_t k_h, int32_t k_w, int32_t h_out, int32_t w_out, int w_is_int8);
+/** layer_id 누적값 (범위 밖이면 NULL) */
+const roofline_work_t* roofline_layer(int layer_id);
+#else
+static inline void roofline_reset(void) {}
+static inline void roofline_add(uint64_t macs, uint64_t weight_bytes, uint64_t act_read, uint64_t act_write) {
+    (void)macs; (void)weight_bytes; (void)act_read; (void)act_write;
+}
+static inline void roofline_conv(int32_t n, int32_t c_in, int32_t h_in, int32_t w_in, int32_t c_out,
+                                 int32_t k_h, int32_t k_w, int32_t h_out, int32_t w_out, int w_is_int8) {
+    (void)n; (void)c_in; (void)h_in; (void)w_in; (void)c_out; (void)k_h; (void)k_w; (void)h_out; (void)w_out;
+    (void)w_is_int8;
+}
+static inline const roofline_work_t* roofline_layer(int layer_id) { (void)layer_id; return 0; }
+#endif
+
+/** ticks 동안의 달성 MFLOP/s, MB/s (w NULL 또는 ticks 0이면 0) */
+uint32_t roofline_mflops(const roofline_work_t* w, uint64_t ticks);
+uint32_t roofline_mbps(const roofline_work_t* w, uint64_t ticks);
+
+/**
+ * 레이어별 roofline 표: 시간, MFLOP, 가중치/활성값 KB, FLOP/B, MFLOP/s, MB/s, roof%(= 달성 / min(peak, 강도·대역폭)),
+ * bound(강도 < ridge면 mem). ticks[layer] = 레이어 시간 (0이면 행 생략), 마지막에 합계 행
+ */
+void roofline_print_summary(const uint64_t ticks[ROOFLINE_LAYERS]);
+
+#endif /* ROOFLINE_H */
@@ -0,0 +1,162 @@
+/**
+ * 상주 워커 풀: mutex + cond로 "세대(generation)"를 깨우고,
+ * item은 공유 카운터에서 grain 단위로 가져간다 (동적 분배, 출력 영역은 item별로 분리).
+ */
+#if !defined(BARE_METAL) && !defined(_WIN32) && !defined(_DEFAULT_SOURCE)
+#define _DEFAULT_SOURCE  /* glibc -std=c99: sysconf(_SC_NPROCESSORS_ONLN) */
+#endif
+#include "thread_pool.h"
+#include "profiler.h"
+#include "mcycle.h"
+
+/* 프로파일러 작업 구간 (스레드별 1개, 비활성이면 시각 읽기도 없음) */
+#define POOL_TASK_BEGIN(t0) const uint64_t t0 = prof_enabled() ? timer_read64() : 0
+#define POOL_TASK_END(tid, t0) do { if (prof_enabled()) prof_task((tid), (t0), timer_read64()); } while (0)
+
+#ifdef BARE_METAL
+
+void thread_pool_init(int32_t num_threads) { (void)num_threads; }
+void thread_pool_shutdown(void) {}
+int32_t thread_pool_size(void) { return 1; }
+
+void thread_pool_run(int32_t n_items, thread_pool_fn fn, void* ctx) {
+    if (n_items <= 0) return;
+    POOL_TASK_BEGIN(t0);
+    fn(ctx, 0, n_items, 0);
+    POOL_TASK_END(0, t0);
+}
+
+#else
+
+#include <pthread.h>
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <unistd.h>
+#endif
+
+/* 스레드당 grain 수 (동적 분배로 경계 타일 불균형 흡수) */
+#define GRAINS_PER_THREAD 4
+
+static pthread_t s_threads[YOLO_MAX_THREADS];
+static pthread_mutex_t s_mu = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t s_cv_start = PTHREAD_COND_INITIALIZER;
+static pthread_cond_t s_cv_done = PTHREAD_COND_INITIALIZER;
+static int32_t s_num_threads = 1;
+static uint32_t s_generation;
+static int32_t s_pending;
+static int s_quit;
+static int s_in_run;
+
+/* 현재 작업 (s_mu 아래에서 설정, 세대 증가 후 워커가 읽음) */
+static thread_pool_fn s_fn;
+static void* s_ctx;
+static int32_t s_n_items;
+static int32_t s_grain;
+static volatile int32_t s_next;
+
+static int32_t cpu_count(void) {
+#ifdef _WIN32
+    SYSTEM_INFO si;
+    GetSystemInfo(&si);
+    return (int32_t)si.dwNumberOfProcessors;
+#elif defined(_SC_NPROCESSORS_ONLN)
+    long n = sysconf(_SC_NPROCESSORS_ONLN);
+    return n > 0 ? (int32_t)n : 1;
+#else
+    return 1;
+#endif
+}
+
+static void run_items(int32_t tid) {
+    POOL_TASK_BEGIN(t0);
+    int32_t done = 0;
+    for (;;) {
+        const int32_t b = __sync_fetch_and_add(&s_next, s_grain);
+        if (b >= s_n_items) break;
+        const int32_t e = b + s_grain < s_n_items ? b + s_grain : s_n_items;
+        s_fn(s_ctx, b, e, tid);
+        done = 1;
+    }
+    if (done) POOL_TASK_END(tid, t0);
+}
+
+static void* worker_main(void* arg) {
+    const int32_t tid = (int32_t)(intptr_t)arg;
+    uint32_t seen = 0;
+    pthread_mutex_lock(&s_mu);
+    for (;;) {
+        while (!s_quit && s_generation == seen)
+            pthread_cond_wait(&s_cv_start, &s_mu);
+        if (s_quit) break;
+        seen = s_generation;
+        pthread_mutex_unlock(&s_mu);
+
+        run_items(tid);
+
+        pthread_mutex_lock(&s_mu);
+        if (--s_pending == 0) pthread_cond_signal(&s_cv_done);
+    }
+    pthread_mutex_unlock(&s_mu);
+    return NULL;
+}
+
+void thread_pool_init(int32_t num_threads) {
+    thread_pool_shutdown();
+    if (num_threads <= 0) num_threads = cpu_count();
+    if (num_threads > YOLO_MAX_THREADS) num_threads = YOLO_MAX_THREADS;
+    s_quit = 0;
+    s_num_threads = 1;
+    for (int32_t t = 1; t < num_threads; t++) {
+        if (pthread_create(&s_threads[t], NULL, worker_main, (void*)(intptr_t)t) != 0) break;
+        s_num_threads++;
+    }
+}
+
+void thread_pool_shutdown(void) {
+    if (s_num_threads <= 1) return;
+    pthread_mutex_lock(&s_mu);
+    s_quit = 1;
+    pthread_cond_broadcast(&s_cv_start);
+    pthread_mutex_unlock(&s_mu);
+    for (int32_t t = 1; t < s_num_threads; t++)
+        pthread_join(s_threads[t], NULL);
+    s_num_threads = 1;
+    s_generation = 0;
+}
+
+int32_t thread_pool_size(void) {
+    return s_num_threads;
+}
+
+void thread_pool_run(int32_t n_items, thread_pool_fn fn, void* ctx) {
+    if (n_items <= 0) return;
+    if (s_num_threads <= 1 || n_items == 1 || s_in_run) {
+        POOL_TASK_BEGIN(t0);
+        fn(ctx, 0, n_items, 0);
+        if (!s_in_run) POOL_TASK_END(0, t0);
+        return;
+    }
+    s_in_run = 1;
+    pthread_mutex_lock(&s_mu);
+    s_fn = fn;
+    s_ctx = ctx;
+    s_n_items = n_items;
+    s_grain = n_items / (s_num_threads * GRAINS_PER_THREAD);
+    if (s_grain < 1) s_grain = 1;
+    s_next = 0;
+    s_pending = s_num_threads - 1;
+    s_generation++;
+    pthread_cond_broadcast(&s_cv_start);
+    pthread_mutex_unlock(&s_mu);
+
+    run_items(0);
+
+    pthread_mutex_lock(&s_mu);
+    while (s_pending > 0)
+        pthread_cond_wait(&s_cv_done, &s_mu);
+    pthread_mutex_unlock(&s_mu);
+    s_in_run = 0;
+}
+
+#endif /* BARE_METAL */
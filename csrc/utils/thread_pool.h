@@ -0,0 +1,41 @@
+/**
+ * 상주 워커 풀 (호스트 전용, pthread). feature_pool_init 옆에서 1회 생성.
+ * 연산은 출력 타일/채널/원소 범위 [0, n_items)를 나눠 워커에 분배한다.
+ * 각 item은 정확히 한 스레드가 같은 순서로 계산 → 스레드 수와 무관하게 결과 동일.
+ * BARE_METAL: 워커 없음, thread_pool_run은 호출 스레드에서 그대로 실행.
+ */
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* 스레드별 scratch(acc/B 패널 등) 배열 크기 */
+#ifndef YOLO_MAX_THREADS
+#ifdef BARE_METAL
+#define YOLO_MAX_THREADS 1
+#else
+#define YOLO_MAX_THREADS 32
+#endif
+#endif
+
+/** [begin, end) item 처리. tid: 0 = 호출 스레드, 1.. = 워커 (스레드별 scratch 인덱스) */
+typedef void (*thread_pool_fn)(void* ctx, int32_t begin, int32_t end, int32_t tid);
+
+/** num_threads <= 0: CPU 수 (최대 YOLO_MAX_THREADS). 1: 워커 없이 단일 스레드 */
+void thread_pool_init(int32_t num_threads);
+void thread_pool_shutdown(void);
+int32_t thread_pool_size(void);
+
+/** n_items를 grain 단위로 나눠 호출 스레드 + 워커가 처리, 모두 끝나면 반환.
+ *  워커 안(fn 내부)에서 다시 호출하지 말 것 */
+void thread_pool_run(int32_t n_items, thread_pool_fn fn, void* ctx);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* THREAD_POOL_H */
@@ -2,8 +2,12 @@
  * 연산별 시간 수집·출력 구현.
  * timer_read64/timer_delta64(mcycle.h) 사용. BARE_METAL에서는 정수 ms만 출력.
  */
+#if !defined(BARE_METAL) && !defined(_WIN32) && !defined(_POSIX_C_SOURCE) && !defined(_DEFAULT_SOURCE)
+#define _POSIX_C_SOURCE 199309L  /* mcycle.h: -std=c99에서 clock_gettime(CLOCK_MONOTONIC) */
+#endif
 #include "timing.h"
 #include "mcycle.h"
+#include "profiler.h"
 #include <string.h>
 
 #ifdef BARE_METAL
@@ -15,7 +19,14 @@
 #define TIMING_LOG(...) xil_printf(__VA_ARGS__)
 #else
 #include <stdio.h>
+#ifndef YOLO_VERBOSE
+#define YOLO_VERBOSE 1
+#endif
+#if YOLO_VERBOSE
 #define TIMING_LOG(...) printf(__VA_ARGS__)
+#else
+#define TIMING_LOG(...) ((void)0)
+#endif
 #endif
 
 typedef struct {
@@ -33,6 +44,11 @@ static char           s_current_op[YOLO_TIMING_OP_MAX];
 
 void yolo_timing_set_layer(int layer_id) {
     s_current_layer = layer_id;
+    prof_layer(layer_id);
+}
+
+int yolo_timing_get_layer(void) {
+    return s_current_layer;
 }
 
 void yolo_timing_begin(const char* op) {
@@ -42,12 +58,14 @@ void yolo_timing_begin(const char* op) {
             s_current_op[len] = op[len], len++;
     }
     s_current_op[len] = '\0';
+    prof_begin(op);
     s_start = timer_read64();
 }
 
 void yolo_timing_end(void) {
-    if (s_count >= YOLO_TIMING_ENTRIES) return;
     uint64_t delta = timer_delta64(s_start, timer_read64());
+    prof_end();
+    if (s_count >= YOLO_TIMING_ENTRIES) return;
     s_entries[s_count].layer = s_current_layer;
     (void)strncpy(s_entries[s_count].op, s_current_op, YOLO_TIMING_OP_MAX - 1);
     s_entries[s_count].op[YOLO_TIMING_OP_MAX - 1] = '\0';
@@ -84,4 +102,5 @@ void yolo_timing_print_layer_ops(int layer_id) {
 void yolo_timing_reset(void) {
     s_count = 0;
     s_cursor = 0;
+    prof_reset();
 }
@@ -20,6 +20,9 @@
 /** 현재 레이어 설정 (0..23: L0..L23, 24: det, 25: dec, 26: nms) */
 void yolo_timing_set_layer(int layer_id);
 
+/** 현재 레이어 (roofline 계정이 누적 위치로 사용) */
+int yolo_timing_get_layer(void);
+
 /** 연산 시작 (op 이름 등록, 시각 기록) */
 void yolo_timing_begin(const char* op);
 
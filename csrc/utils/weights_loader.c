@@ -1,9 +1,23 @@
+#if !defined(BARE_METAL) && !defined(_WIN32) && !defined(_DEFAULT_SOURCE)
+#define _DEFAULT_SOURCE  /* glibc -std=c99: mmap/fstat */
+#endif
 #include "weights_loader.h"
 #include <stdlib.h>
 #include <string.h>
 #include <stdint.h>
 #include <stdio.h>
 
+/* 호스트 POSIX: 파일을 mmap해 텐서가 매핑을 직접 가리킴 (복사 0회, 프로세스 간 page cache 공유) */
+#if !defined(BARE_METAL) && !defined(_WIN32) && (defined(__unix__) || defined(__APPLE__))
+#define WEIGHTS_USE_MMAP 1
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#else
+#define WEIGHTS_USE_MMAP 0
+#endif
+
 #ifndef WEIGHTS_WARN_MISSING
 #define WEIGHTS_WARN_MISSING 1
 #endif
@@ -21,6 +35,53 @@ static inline uint32_t read_u32_unaligned(const uint8_t** src) {
     return v;
 }
 
+/* FNV-1a 32bit */
+static uint32_t name_hash(const char* s) {
+    uint32_t h = 2166136261u;
+    while (*s) {
+        h ^= (uint8_t)*s++;
+        h *= 16777619u;
+    }
+    return h;
+}
+
+/* 로드 직후 1회: 슬롯 수 = 텐서 수 2배 이상의 2의 거듭제곱 (부하율 <= 0.5) */
+static void build_hash_index(weights_loader_t* loader) {
+    uint32_t cap = 16;
+    while (cap < (uint32_t)loader->num_tensors * 2u) cap <<= 1;
+    loader->hash_slots = (int32_t*)calloc(cap, sizeof(int32_t));
+    if (!loader->hash_slots) {
+        loader->hash_mask = 0;
+        return;
+    }
+    loader->hash_mask = cap - 1u;
+    for (int32_t i = 0; i < loader->num_tensors; i++) {
+        uint32_t h = name_hash(loader->tensors[i].name) & loader->hash_mask;
+        while (loader->hash_slots[h] != 0) {
+            /* 같은 이름이 여러 번이면 선형 탐색과 같게 먼저 나온 텐서 유지 */
+            if (strcmp(loader->tensors[loader->hash_slots[h] - 1].name, loader->tensors[i].name) == 0) break;
+            h = (h + 1u) & loader->hash_mask;
+        }
+        if (loader->hash_slots[h] == 0) loader->hash_slots[h] = i + 1;
+    }
+}
+
+static const tensor_info_t* find_exact(const weights_loader_t* loader, const char* name) {
+    if (loader->hash_slots) {
+        uint32_t h = name_hash(name) & loader->hash_mask;
+        for (int32_t slot; (slot = loader->hash_slots[h]) != 0; h = (h + 1u) & loader->hash_mask) {
+            if (strcmp(loader->tensors[slot - 1].name, name) == 0) return &loader->tensors[slot - 1];
+        }
+        return NULL;
+    }
+    for (int i = 0; i < loader->num_tensors; i++) {
+        if (strcmp(loader->tensors[i].name, name) == 0) {
+            return &loader->tensors[i];
+        }
+    }
+    return NULL;
+}
+
 static int parse_weights_data(const uint8_t* ptr, size_t data_len, weights_loader_t* loader, int zero_copy) {
     const uint8_t* curr = ptr;
     const uint8_t* end = ptr + data_len;
@@ -30,6 +91,10 @@ static int parse_weights_data(const uint8_t* ptr, size_t data_len, weights_loade
     safe_read(&num_tensors, &curr, 4);
 
     loader->num_tensors = (int32_t)num_tensors;
+    loader->hash_slots = NULL;
+    loader->hash_mask = 0;
+    loader->map_base = NULL;
+    loader->map_size = 0;
     loader->tensors = (tensor_info_t*)calloc(num_tensors, sizeof(tensor_info_t));
     if (!loader->tensors) return -1;
 
@@ -87,6 +152,7 @@ static int parse_weights_data(const uint8_t* ptr, size_t data_len, weights_loade
         }
     }
 
+    build_hash_index(loader);
     return 0;
 }
 
@@ -101,6 +167,10 @@ static int parse_weights_w8(const uint8_t* w8_ptr, size_t w8_len,
     safe_read(&num_tensors, &curr, 4);
 
     loader->num_tensors = (int32_t)num_tensors;
+    loader->hash_slots = NULL;
+    loader->hash_mask = 0;
+    loader->map_base = NULL;
+    loader->map_size = 0;
     loader->tensors = (tensor_info_t*)calloc(num_tensors, sizeof(tensor_info_t));
     if (!loader->tensors) return -1;
 
@@ -177,6 +247,7 @@ static int parse_weights_w8(const uint8_t* w8_ptr, size_t w8_len,
         } else
             return -1;
     }
+    build_hash_index(loader);
     return 0;
 }
 
@@ -193,7 +264,41 @@ int weights_init_from_memory_w8(uintptr_t w8_base, size_t w8_size, weights_loade
 #endif
 
 #ifndef BARE_METAL
+#if WEIGHTS_USE_MMAP
+/* 읽기 전용 매핑 후 zero_copy 파싱. 매핑 실패 시 1 → 호출자가 fread 경로로 */
+static int load_mapped(const char* path, weights_loader_t* loader, int is_w8) {
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) return 1;
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size <= 0) {
+        close(fd);
+        return 1;
+    }
+    const size_t size = (size_t)st.st_size;
+    void* map = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED) return 1;
+
+    int ret = is_w8 ? parse_weights_w8((const uint8_t*)map, size, loader, 1)
+                    : parse_weights_data((const uint8_t*)map, size, loader, 1);
+    if (ret != 0) {
+        weights_free(loader);
+        munmap(map, size);
+        return -1;
+    }
+    loader->map_base = map;
+    loader->map_size = size;
+    return 0;
+}
+#endif
+
 int weights_load_from_file(const char* bin_path, weights_loader_t* loader) {
+#if WEIGHTS_USE_MMAP
+    {
+        int ret = load_mapped(bin_path, loader, 0);
+        if (ret <= 0) return ret;
+    }
+#endif
     FILE* f = fopen(bin_path, "rb");
     if (!f) {
         fprintf(stderr, "Error: Cannot open %s\n", bin_path);
@@ -227,6 +332,12 @@ int weights_load_from_file(const char* bin_path, weights_loader_t* loader) {
 }
 
 int weights_load_from_file_w8(const char* w8_path, weights_loader_t* loader) {
+#if WEIGHTS_USE_MMAP
+    {
+        int ret = load_mapped(w8_path, loader, 1);
+        if (ret <= 0) return ret;
+    }
+#endif
     FILE* fw = fopen(w8_path, "rb");
     if (!fw) {
         fprintf(stderr, "Error: Cannot open %s\n", w8_path);
@@ -255,20 +366,12 @@ int weights_load_from_file_w8(const char* w8_path, weights_loader_t* loader) {
 
 const tensor_info_t* weights_find_tensor(const weights_loader_t* loader, const char* name) {
     char search_name[512];
-    
-    for (int i = 0; i < loader->num_tensors; i++) {
-        if (strcmp(loader->tensors[i].name, name) == 0) {
-            return &loader->tensors[i];
-        }
-    }
+    const tensor_info_t* t = find_exact(loader, name);
+    if (t) return t;
 
     if (strncmp(name, "model.", 6) == 0) {
         snprintf(search_name, sizeof(search_name), "model.model.%s", name);
-        for (int i = 0; i < loader->num_tensors; i++) {
-            if (strcmp(loader->tensors[i].name, search_name) == 0) {
-                return &loader->tensors[i];
-            }
-        }
+        return find_exact(loader, search_name);
     }
 
     return NULL;
@@ -323,6 +426,14 @@ void weights_free(weights_loader_t* loader) {
         }
     }
     free(loader->tensors);
+    free(loader->hash_slots);
     loader->tensors = NULL;
+    loader->hash_slots = NULL;
+    loader->hash_mask = 0;
     loader->num_tensors = 0;
+#if WEIGHTS_USE_MMAP
+    if (loader->map_base) munmap(loader->map_base, loader->map_size);
+#endif
+    loader->map_base = NULL;
+    loader->map_size = 0;
 }
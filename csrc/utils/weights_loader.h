@@ -25,10 +25,18 @@ typedef struct {
 typedef struct {
     tensor_info_t* tensors;
     int32_t num_tensors;
+    /* 이름 해시 인덱스 (로드 시 1회 생성, open addressing). 슬롯 = 텐서 번호 + 1, 0 = 빈 칸.
+       생성 실패 시 NULL → 선형 탐색 */
+    int32_t* hash_slots;
+    uint32_t hash_mask;
+    /* 호스트 mmap 로드 시 파일 매핑 (텐서 data가 여기를 직접 가리킴, weights_free에서 해제) */
+    void* map_base;
+    size_t map_size;
 } weights_loader_t;
 
 int weights_init_from_memory(uintptr_t base_addr, size_t size, weights_loader_t* loader);
 
+/* 호스트 POSIX는 mmap(읽기 전용) + 제로카피, 그 외(Windows 등)·매핑 실패 시 fread 후 텐서별 복사 */
 int weights_load_from_file(const char* bin_path, weights_loader_t* loader);
 
 /* W8A32: weights_w8.bin 로드 (scale은 w8 내부 텐서 헤더에 포함). */
@@ -38,7 +46,7 @@ int weights_load_from_file_w8(const char* w8_path, weights_loader_t* loader);
 int weights_init_from_memory_w8(uintptr_t w8_base, size_t w8_size, weights_loader_t* loader);
 #endif
 
-// 특정 이름의 텐서 찾기
+// 특정 이름의 텐서 찾기 (해시 인덱스, 평균 O(1)). "model.X"는 "model.model.X"도 시도
 // 반환값: 텐서 포인터, 없으면 NULL
 const tensor_info_t* weights_find_tensor(const weights_loader_t* loader, const char* name);
 
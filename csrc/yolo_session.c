@@ -0,0 +1,732 @@
+/**
+ * YOLOv5n 추론 세션. 레이어 순서/채널 구성은 기존 main.c 그대로,
+ * 가중치 텐서 이름 조회는 create에서 1회 해 두고 infer는 해석된 포인터만 사용.
+ */
+#if !defined(BARE_METAL) && !defined(_WIN32) && !defined(_POSIX_C_SOURCE) && !defined(_DEFAULT_SOURCE)
+#define _POSIX_C_SOURCE 199309L  /* mcycle.h: -std=c99에서 clock_gettime(CLOCK_MONOTONIC) */
+#endif
+#include <stdlib.h>
+#include <string.h>
+#ifndef BARE_METAL
+#include <stdio.h>
+#endif
+
+#include "yolo_session.h"
+#include "utils/weights_loader.h"
+#include "blocks/conv.h"
+#include "blocks/c3.h"
+#include "blocks/sppf.h"
+#include "blocks/detect.h"
+#include "blocks/nms.h"
+#include "operations/conv2d.h"
+#include "operations/conv2d_1x1.h"
+#include "operations/silu.h"
+#include "operations/weight_pack.h"
+#include "utils/feature_pool.h"
+#include "utils/memory_plan.h"
+#include "utils/thread_pool.h"
+#include "utils/mcycle.h"
+#include "utils/timing.h"
+#include "utils/profiler.h"
+#include "utils/roofline.h"
+#ifdef BARE_METAL
+#include "platform_config.h"
+#include "xil_cache.h"
+#include "xil_printf.h"
+#ifndef CPU_MHZ
+#define CPU_MHZ 100
+#endif
+#define LAYER_MS(c) ((double)(c)/((double)CPU_MHZ*1000.0))
+/* xil_printf는 %f 미지원 → BARE_METAL에서는 정수 ms(%llu)만 사용 */
+#define LAYER_MS_INT(c) ((unsigned long long)((c) / ((uint64_t)CPU_MHZ * 1000ULL)))
+#define LAYER_LOG(i, cycles, ptr) YOLO_LOG("  L%d %llu ms (0x%08X) %u MFLOP/s %u MB/s\n", (i), LAYER_MS_INT(cycles), \
+    (unsigned)(*(const uint32_t*)(ptr)), (unsigned)LAYER_MFLOPS(i, cycles), (unsigned)LAYER_MBPS(i, cycles))
+#define RATE_LOG(i, cycles) YOLO_LOG("  %u MFLOP/s %u MB/s\n", (unsigned)LAYER_MFLOPS(i, cycles), (unsigned)LAYER_MBPS(i, cycles))
+#else
+#define LAYER_MS(c) ((c)/1000.0)
+#define LAYER_LOG(i, cycles, ptr) YOLO_LOG("  L%d %.2f ms (0x%08X) %.2f GFLOP/s %.2f GB/s\n", (i), LAYER_MS(cycles), \
+    (unsigned)(*(const uint32_t*)(ptr)), LAYER_MFLOPS(i, cycles) / 1000.0, LAYER_MBPS(i, cycles) / 1000.0)
+#define RATE_LOG(i, cycles) YOLO_LOG("  %.2f GFLOP/s %.2f GB/s\n", LAYER_MFLOPS(i, cycles) / 1000.0, LAYER_MBPS(i, cycles) / 1000.0)
+#endif
+
+/* roofline 계정 (utils/roofline.c) 기준 달성 처리율 */
+#define LAYER_MFLOPS(i, cycles) roofline_mflops(roofline_layer(i), (cycles))
+#define LAYER_MBPS(i, cycles) roofline_mbps(roofline_layer(i), (cycles))
+
+#define CONF_THRESHOLD 0.20f
+#define IOU_THRESHOLD 0.45f
+
+#ifndef YOLO_VERBOSE
+#define YOLO_VERBOSE 1
+#endif
+
+/* 디버그 출력(기본 OFF). 필요 시 빌드 옵션으로 -DYOLO_DEBUG=1 */
+#ifndef YOLO_DEBUG
+#define YOLO_DEBUG 0
+#endif
+
+#if defined(BARE_METAL)
+#define YOLO_LOG(...) xil_printf(__VA_ARGS__)
+#elif YOLO_VERBOSE
+#define YOLO_LOG(...) printf(__VA_ARGS__)
+#else
+/* 출력 없음. 인자는 평가하지 않지만 형식 검사·사용 표시는 유지 (로그 전용 변수 unused 경고 방지) */
+#define YOLO_LOG(...) ((void)(0 && printf(__VA_ARGS__)))
+#endif
+
+static const float STRIDES[3] = {8.0f, 16.0f, 32.0f};
+static const float ANCHORS[3][6] = {
+    {10.0f, 13.0f, 16.0f, 30.0f, 33.0f, 23.0f},
+    {30.0f, 61.0f, 62.0f, 45.0f, 59.0f, 119.0f},
+    {116.0f, 90.0f, 156.0f, 198.0f, 373.0f, 326.0f}
+};
+
+#define C3_MAX_BN 3   /* YOLOv5n 최대 bottleneck 수 (L6) */
+
+/* 정적 메모리 계획 대상: 레이어 출력, Detect 출력, 블록 scratch. step = 레이어 번호 (24 Detect, 25 decode) */
+enum {
+    BUF_INPUT,
+    BUF_L0, BUF_L1, BUF_L2, BUF_L3, BUF_L5, BUF_L7, BUF_L8, BUF_L9,
+    BUF_L4, BUF_L6, BUF_L13, BUF_L17, BUF_L19, BUF_L20, BUF_L22, BUF_L23,
+    BUF_P3, BUF_P4, BUF_P5,
+    BUF_S2, BUF_S4, BUF_S6, BUF_S8, BUF_S9, BUF_S13, BUF_S17, BUF_S20, BUF_S23,
+    BUF_COUNT
+};
+
+/* 해석된 conv 가중치: W_CONV 결과 + bias */
+typedef struct {
+    const void* w;
+    float scale;
+    int is_int8;
+    const float* b;
+} conv_param_t;
+
+typedef struct {
+    conv_param_t cv1, cv2, cv3;
+    int32_t n_bn;
+    const void* bn_cv1_w[C3_MAX_BN]; float bn_cv1_scale[C3_MAX_BN]; int bn_cv1_is_int8[C3_MAX_BN]; const float* bn_cv1_b[C3_MAX_BN];
+    const void* bn_cv2_w[C3_MAX_BN]; float bn_cv2_scale[C3_MAX_BN]; int bn_cv2_is_int8[C3_MAX_BN]; const float* bn_cv2_b[C3_MAX_BN];
+} c3_param_t;
+
+struct yolo_session {
+    weights_loader_t weights;
+    conv_param_t l0, l1, l3, l5, l7, l10, l14, l18, l21;
+    c3_param_t l2, l4, l6, l8, l13, l17, l20, l23;
+    conv_param_t l9_cv1, l9_cv2;
+    conv_param_t det[3];
+    int head_sparse;     /* create 시 detect_get_head_mode() == SPARSE: p3~p5 없이 detect+decode 한 번에 */
+    detection_t* dets;   /* decode 결과 (YOLO_MAX_DETECTIONS, 이미지 1장분씩 재사용) */
+    void* post_scratch;  /* 정렬/NMS scratch (nms_scratch_bytes(YOLO_MAX_DETECTIONS)) */
+    int32_t max_batch;
+    uint8_t* arena;      /* 계획된 피처맵 영역 (feature_pool에서 create 시 1회) */
+    size_t arena_bytes;
+    size_t buf_off[BUF_COUNT];
+};
+
+/* 동시에 1개 (전역 풀 공유) */
+static struct yolo_session s_session;
+static int s_session_used;
+
+/* "<prefix><suffix>" 텐서 조회. 없으면 에러 로그 후 NULL */
+static const char* tensor_name(char* buf, const char* prefix, const char* suffix) {
+    size_t lp = strlen(prefix), ls = strlen(suffix);
+    if (lp + ls >= 64) return "";
+    memcpy(buf, prefix, lp);
+    memcpy(buf + lp, suffix, ls + 1);
+    return buf;
+}
+
+static int resolve_conv(weights_loader_t* wl, const char* prefix, conv_param_t* p) {
+    char name[64];
+    p->w = weights_get_tensor_for_conv(wl, tensor_name(name, prefix, ".weight"), &p->scale, &p->is_int8);
+    if (!p->w) {
+        YOLO_LOG("ERROR: missing tensor %s\n", name);
+        return -1;
+    }
+    p->b = weights_get_tensor_data(wl, tensor_name(name, prefix, ".bias"));
+    return 0;
+}
+
+/* prefix = "model.N": cv1/cv2/cv3 + m.K.cv1/cv2 */
+static int resolve_c3(weights_loader_t* wl, const char* prefix, int32_t n_bn, c3_param_t* p) {
+    char pre[64], bn[64];
+    int err = 0;
+    err |= resolve_conv(wl, tensor_name(pre, prefix, ".cv1.conv"), &p->cv1);
+    err |= resolve_conv(wl, tensor_name(pre, prefix, ".cv2.conv"), &p->cv2);
+    err |= resolve_conv(wl, tensor_name(pre, prefix, ".cv3.conv"), &p->cv3);
+    p->n_bn = n_bn;
+    for (int32_t k = 0; k < n_bn; k++) {
+        const char idx[2] = { (char)('0' + k), '\0' };
+        conv_param_t c;
+        tensor_name(bn, tensor_name(pre, prefix, ".m."), idx);
+        err |= resolve_conv(wl, tensor_name(pre, bn, ".cv1.conv"), &c);
+        p->bn_cv1_w[k] = c.w; p->bn_cv1_scale[k] = c.scale; p->bn_cv1_is_int8[k] = c.is_int8; p->bn_cv1_b[k] = c.b;
+        err |= resolve_conv(wl, tensor_name(pre, bn, ".cv2.conv"), &c);
+        p->bn_cv2_w[k] = c.w; p->bn_cv2_scale[k] = c.scale; p->bn_cv2_is_int8[k] = c.is_int8; p->bn_cv2_b[k] = c.b;
+    }
+    return err ? -1 : 0;
+}
+
+static int resolve_all(yolo_session_t* s) {
+    weights_loader_t* wl = &s->weights;
+    int err = 0;
+    err |= resolve_conv(wl, "model.0.conv", &s->l0);
+    err |= resolve_conv(wl, "model.1.conv", &s->l1);
+    err |= resolve_c3(wl, "model.2", 1, &s->l2);
+    err |= resolve_conv(wl, "model.3.conv", &s->l3);
+    err |= resolve_c3(wl, "model.4", 2, &s->l4);
+    err |= resolve_conv(wl, "model.5.conv", &s->l5);
+    err |= resolve_c3(wl, "model.6", 3, &s->l6);
+    err |= resolve_conv(wl, "model.7.conv", &s->l7);
+    err |= resolve_c3(wl, "model.8", 1, &s->l8);
+    err |= resolve_conv(wl, "model.9.cv1.conv", &s->l9_cv1);
+    err |= resolve_conv(wl, "model.9.cv2.conv", &s->l9_cv2);
+    err |= resolve_conv(wl, "model.10.conv", &s->l10);
+    err |= resolve_c3(wl, "model.13", 1, &s->l13);
+    err |= resolve_conv(wl, "model.14.conv", &s->l14);
+    err |= resolve_c3(wl, "model.17", 1, &s->l17);
+    err |= resolve_conv(wl, "model.18.conv", &s->l18);
+    err |= resolve_c3(wl, "model.20", 1, &s->l20);
+    err |= resolve_conv(wl, "model.21.conv", &s->l21);
+    err |= resolve_c3(wl, "model.23", 1, &s->l23);
+    err |= resolve_conv(wl, "model.24.m.0", &s->det[0]);
+    err |= resolve_conv(wl, "model.24.m.1", &s->det[1]);
+    err |= resolve_conv(wl, "model.24.m.2", &s->det[2]);
+    return err ? -1 : 0;
+}
+
+/* 모든 피처맵/scratch의 수명 [first, last]와 max_batch 기준 크기. step = 레이어 번호, 24 Detect, 25 decode */
+int32_t yolo_session_plan_buffers(int32_t max_batch, int head_sparse, memory_plan_buf_t* b) {
+    const size_t nb = (size_t)max_batch;
+    /* sparse head는 decode(25)에서 L17/L20/L23을 직접 읽음 */
+    const int32_t head_last = head_sparse ? 25 : 24;
+#define FM(id, c, h, w, t0, t1) \
+    (b[id].name = #id, b[id].size = nb * (size_t)(c) * (size_t)(h) * (size_t)(w) * sizeof(float), \
+     b[id].first = (t0), b[id].last = (t1))
+#define SCRATCH(id, bytes, t) (b[id].name = #id, b[id].size = (bytes), b[id].first = b[id].last = (t))
+    /* batch 1은 입력 이미지를 그대로 사용 */
+    FM(BUF_INPUT, 3, YOLO_INPUT_SIZE, YOLO_INPUT_SIZE, 0, 0);
+    if (nb == 1) b[BUF_INPUT].size = 0;
+    FM(BUF_L0, 16, 320, 320, 0, 1);
+    FM(BUF_L1, 32, 160, 160, 1, 2);
+    FM(BUF_L2, 32, 160, 160, 2, 3);
+    FM(BUF_L3, 64, 80, 80, 3, 4);
+    FM(BUF_L5, 128, 40, 40, 5, 6);
+    FM(BUF_L7, 256, 20, 20, 7, 8);
+    FM(BUF_L8, 256, 20, 20, 8, 9);
+    FM(BUF_L9, 256, 20, 20, 9, 10);
+    /* L12/L16 (Upsample + Concat)은 가상: L13/L17 cv1·cv2가 L10/L14와 L6/L4를 직접 읽음 → L6/L4가 그때까지 산다.
+       L19/L22 Concat 출력은 두 입력 생산 레이어 중 먼저 쓰는 쪽부터 산다 (L14/L10 ~ 소비 C3) */
+    FM(BUF_L4, 64, 80, 80, 4, 17);
+    FM(BUF_L6, 128, 40, 40, 6, 13);
+    FM(BUF_L13, 128, 40, 40, 13, 14);
+    FM(BUF_L17, 64, 80, 80, 17, head_last);
+    FM(BUF_L19, 128, 40, 40, 14, 20);
+    FM(BUF_L20, 128, 40, 40, 20, head_last);
+    FM(BUF_L22, 256, 20, 20, 10, 23);
+    FM(BUF_L23, 256, 20, 20, 23, head_last);
+    FM(BUF_P3, 255, 80, 80, 24, 25);
+    FM(BUF_P4, 255, 40, 40, 24, 25);
+    FM(BUF_P5, 255, 20, 20, 24, 25);
+#ifdef BARE_METAL
+    /* Detect 출력은 DETECT_HEAD 영역 */
+    b[BUF_P3].size = b[BUF_P4].size = b[BUF_P5].size = 0;
+#endif
+    /* sparse head는 p3~p5를 만들지 않음 */
+    if (head_sparse) b[BUF_P3].size = b[BUF_P4].size = b[BUF_P5].size = 0;
+    SCRATCH(BUF_S2, c3_scratch_bytes((int32_t)nb, 16, 16, 160, 160), 2);
+    SCRATCH(BUF_S4, c3_scratch_bytes((int32_t)nb, 32, 32, 80, 80), 4);
+    SCRATCH(BUF_S6, c3_scratch_bytes((int32_t)nb, 64, 64, 40, 40), 6);
+    SCRATCH(BUF_S8, c3_scratch_bytes((int32_t)nb, 128, 128, 20, 20), 8);
+    SCRATCH(BUF_S9, sppf_scratch_bytes((int32_t)nb, 128, 20, 20), 9);
+    SCRATCH(BUF_S13, c3_scratch_bytes((int32_t)nb, 64, 64, 40, 40), 13);
+    SCRATCH(BUF_S17, c3_scratch_bytes((int32_t)nb, 32, 32, 80, 80), 17);
+    SCRATCH(BUF_S20, c3_scratch_bytes((int32_t)nb, 64, 64, 40, 40), 20);
+    SCRATCH(BUF_S23, c3_scratch_bytes((int32_t)nb, 128, 128, 20, 20), 23);
+#undef FM
+#undef SCRATCH
+    return BUF_COUNT;
+}
+
+/* 버퍼 수명표 → 오프셋 (create에서 1회) */
+static int plan_memory(yolo_session_t* s) {
+    memory_plan_buf_t b[BUF_COUNT];
+    yolo_session_plan_buffers(s->max_batch, s->head_sparse, b);
+    size_t lower = 0, total = 0;
+    s->arena_bytes = memory_plan_solve(b, BUF_COUNT, &lower);
+    if (s->arena_bytes == 0) return -1;
+    for (int32_t i = 0; i < BUF_COUNT; i++) {
+        s->buf_off[i] = b[i].offset;
+        total += b[i].size;
+        if (YOLO_DEBUG) YOLO_LOG("  %-10s %8u KB @ %8u [%2d..%2d]\n", b[i].name + 4, (unsigned)(b[i].size / 1024u),
+                                 (unsigned)b[i].offset, (int)b[i].first, (int)b[i].last);
+    }
+    YOLO_LOG("Memory plan: arena %u KB (lower bound %u KB, no reuse %u KB)\n",
+             (unsigned)(s->arena_bytes / 1024u), (unsigned)(lower / 1024u), (unsigned)(total / 1024u));
+    return 0;
+}
+
+yolo_session_t* yolo_session_create(const char* weights_path, int32_t num_threads, int32_t max_batch) {
+    if (s_session_used) return NULL;
+    if (max_batch < 1) max_batch = 1;
+#ifdef BARE_METAL
+    if (max_batch > 1) {
+        YOLO_LOG("ERROR: max_batch %d > 1 not supported (DETECT_HEAD_SIZE)\n", (int)max_batch);
+        return NULL;
+    }
+#endif
+    yolo_session_t* s = &s_session;
+    memset(s, 0, sizeof(*s));
+    s->max_batch = max_batch;
+
+#ifdef BARE_METAL
+    (void)weights_path;
+#ifdef USE_WEIGHTS_W8
+    YOLO_LOG("Loading weights (W8) from DDR 0x%08X...\n", (unsigned int)WEIGHTS_W8_DDR_BASE);
+    if (weights_init_from_memory_w8((uintptr_t)WEIGHTS_W8_DDR_BASE, (size_t)WEIGHTS_W8_DDR_SIZE, &s->weights) != 0) {
+        YOLO_LOG("ERROR: Failed to load weights (W8) from DDR\n");
+        return NULL;
+    }
+#else
+    YOLO_LOG("Loading weights from DDR 0x%08X...\n", (unsigned int)WEIGHTS_DDR_BASE);
+    if (weights_init_from_memory((uintptr_t)WEIGHTS_DDR_BASE, (size_t)WEIGHTS_DDR_SIZE, &s->weights) != 0) {
+        YOLO_LOG("ERROR: Failed to load weights from DDR\n");
+        return NULL;
+    }
+#endif
+#else
+#ifdef USE_WEIGHTS_W8
+    if (!weights_path) weights_path = "assets/weights_w8.bin";
+    if (weights_load_from_file_w8(weights_path, &s->weights) != 0) {
+        fprintf(stderr, "Failed to load weights (W8)\n");
+        return NULL;
+    }
+#else
+    if (!weights_path) weights_path = "assets/weights.bin";
+    if (weights_load_from_file(weights_path, &s->weights) != 0) {
+        fprintf(stderr, "Failed to load weights\n");
+        return NULL;
+    }
+#endif
+#endif
+    YOLO_LOG("Weights: %d tensors\n", s->weights.num_tensors);
+    if (YOLO_DEBUG) {
+        const float* bias24 = weights_get_tensor_data(&s->weights, "model.24.m.0.bias");
+        if (bias24) {
+            uint32_t u0 = *(const uint32_t*)&bias24[0];
+            uint32_t u4 = *(const uint32_t*)&bias24[4];
+            YOLO_LOG("DEBUG bias24 @0x%08X [0]=0x%08X [4]=0x%08X\n",
+                     (unsigned)(uintptr_t)bias24, (unsigned)u0, (unsigned)u4);
+        }
+    }
+    if (resolve_all(s) != 0) {
+        weights_free(&s->weights);
+        return NULL;
+    }
+
+    /* 로드 직후 1회: conv 가중치 재배치 (64B 정렬 패널 / 블록, 가능하면 FP32 복원) */
+    if (weight_pack_prepare(&s->weights, conv2d_weight_pack_flags()) != 0)
+        YOLO_LOG("WARN: weight_pack failed, conv weights are unpacked per call\n");
+    else if (weight_pack_flags() != conv2d_weight_pack_flags())
+        YOLO_LOG("WARN: weight_pack reduced to flags 0x%X (memory)\n", weight_pack_flags());
+    s->head_sparse = detect_get_head_mode() == DETECT_HEAD_SPARSE;
+    YOLO_LOG("Conv: %s (1x1: %s), SiLU: %s, head: %s, packed weights %u KB\n",
+             conv2d_get_algo() == CONV2D_ALGO_WINOGRAD ? "winograd" :
+             conv2d_get_algo() == CONV2D_ALGO_GEMM ? "gemm" : "direct",
+             conv2d_get_algo() == CONV2D_ALGO_DIRECT ? "direct" : CONV2D_1X1_ISA, silu_get_mode() == SILU_FAST ? "fast" : "exact",
+             s->head_sparse ? "sparse" : "dense", (unsigned)(weight_pack_bytes() / 1024u));
+
+    s->dets = (detection_t*)malloc(YOLO_MAX_DETECTIONS * sizeof(detection_t));
+    s->post_scratch = malloc(nms_scratch_bytes(YOLO_MAX_DETECTIONS));
+    /* 피처맵 arena: 계획 크기만큼 풀에서 한 번 (호스트 풀은 정확히 이 크기로 생성) */
+    uint8_t* arena = NULL;
+    if (s->dets && s->post_scratch && plan_memory(s) == 0) {
+        feature_pool_init_bytes(s->arena_bytes + 2u * MEMORY_PLAN_ALIGN);
+        arena = (uint8_t*)feature_pool_alloc(s->arena_bytes + MEMORY_PLAN_ALIGN);
+    }
+    if (!arena) {
+        YOLO_LOG("ERROR: feature map arena (%u KB) allocation failed\n", (unsigned)(s->arena_bytes / 1024u));
+        feature_pool_reset();
+        free(s->dets);
+        free(s->post_scratch);
+        weight_pack_release();
+        weights_free(&s->weights);
+        return NULL;
+    }
+    s->arena = (uint8_t*)(((uintptr_t)arena + MEMORY_PLAN_ALIGN - 1u) & ~(uintptr_t)(MEMORY_PLAN_ALIGN - 1u));
+    thread_pool_init(num_threads);
+    YOLO_LOG("Threads: %d, max batch %d\n\n", (int)thread_pool_size(), (int)max_batch);
+    s_session_used = 1;
+    return s;
+}
+
+void yolo_session_destroy(yolo_session_t* s) {
+    if (!s || s != &s_session || !s_session_used) return;
+    free(s->dets);
+    free(s->post_scratch);
+    feature_pool_reset();
+    thread_pool_shutdown();
+    weight_pack_release();
+    weights_free(&s->weights);
+    memset(s, 0, sizeof(*s));
+    s_session_used = 0;
+}
+
+#define P_CONV(p) (p).w, (p).scale, (p).is_int8
+
+static void c3_run(const c3_param_t* p, const float* x, const conv2d_up_concat_t* x_up,
+                   int32_t n, int32_t c_in, int32_t h, int32_t w,
+                   int32_t c_, int32_t c_out, int32_t shortcut, float* y, int32_t y_ct, float* scratch)
+{
+    c3_nchw_f32(x, n, c_in, h, w, x_up,
+        P_CONV(p->cv1), c_, p->cv1.b,
+        P_CONV(p->cv2), c_, p->cv2.b,
+        P_CONV(p->cv3), c_out, p->cv3.b,
+        p->n_bn, (const void**)p->bn_cv1_w, p->bn_cv1_scale, p->bn_cv1_is_int8, p->bn_cv1_b,
+        (const void**)p->bn_cv2_w, p->bn_cv2_scale, p->bn_cv2_is_int8, p->bn_cv2_b, shortcut, y, y_ct, scratch);
+}
+
+/* 레이어 끝: 시간/첫 값 로그, op별 시간, (BARE_METAL) 첫 값 flush */
+static uint64_t layer_done(int32_t i, uint64_t t_layer, const float* y) {
+    const uint64_t cycles = timer_delta64(t_layer, timer_read64());
+    LAYER_LOG(i, cycles, &y[0]);
+    yolo_timing_print_layer_ops(i);
+#ifdef BARE_METAL
+    Xil_DCacheFlushRange((uintptr_t)y, 16);
+#endif
+    return cycles;
+}
+
+int32_t yolo_session_infer(yolo_session_t* s, const preprocessed_image_t* image,
+                           detection_t* dets_out, int32_t max_dets)
+{
+    int32_t count = 0;
+    if (yolo_session_infer_batch(s, image, 1, dets_out, max_dets, &count) != 0) return -1;
+    return count;
+}
+
+int yolo_session_infer_batch(yolo_session_t* s, const preprocessed_image_t* images, int32_t n,
+                             detection_t* dets_out, int32_t max_dets, int32_t* counts_out)
+{
+    if (!s || !images || n < 1 || n > s->max_batch || !dets_out || max_dets <= 0 || !counts_out) return -1;
+    for (int32_t b = 0; b < n; b++) {
+        if (!images[b].data) return -1;
+    }
+
+#define BUF(id) ((float*)(s->arena + s->buf_off[id]))
+    float* const l0 = BUF(BUF_L0), * const l1 = BUF(BUF_L1), * const l2 = BUF(BUF_L2);
+    float* const l3 = BUF(BUF_L3), * const l5 = BUF(BUF_L5), * const l7 = BUF(BUF_L7);
+    float* const l4 = BUF(BUF_L4), * const l6 = BUF(BUF_L6);
+    float* const l8 = BUF(BUF_L8), * const l9 = BUF(BUF_L9);
+    float* const l13 = BUF(BUF_L13), * const l17 = BUF(BUF_L17);
+    float* const l19 = BUF(BUF_L19), * const l20 = BUF(BUF_L20), * const l22 = BUF(BUF_L22);
+    float* const l23 = BUF(BUF_L23);
+    /* Concat 입력은 출력 버퍼의 채널 구간 뷰 (첫 입력 = 앞쪽, 두 번째 = 뒤쪽). 이미지 stride는 concat 채널 수 */
+    float* const l18 = l19, * const l14 = l19 + 64 * 40 * 40;   /* ct 128 */
+    float* const l21 = l22, * const l10 = l22 + 128 * 20 * 20;  /* ct 256 */
+    /* L12 = [up2x(l10) | l6], L16 = [up2x(l14) | l4]: 가상 concat (업샘플·concat 버퍼 없음) */
+    const conv2d_up_concat_t l12 = { l10, 128, (size_t)256 * 20 * 20, l6, (size_t)128 * 40 * 40 };
+    const conv2d_up_concat_t l16 = { l14, 64, (size_t)128 * 40 * 40, l4, (size_t)64 * 80 * 80 };
+#ifdef BARE_METAL
+    float* const p3 = (float*)DETECT_HEAD_BASE;
+    float* const p4 = p3 + (255 * 80 * 80);
+    float* const p5 = p4 + (255 * 40 * 40);
+#else
+    float* const p3 = BUF(BUF_P3), * const p4 = BUF(BUF_P4), * const p5 = BUF(BUF_P5);
+#endif
+    const float* input = images[0].data;
+
+#ifdef BARE_METAL
+    if (YOLO_DEBUG) {
+        float img0 = images[0].data[0];
+        uint32_t u_img = *(const uint32_t*)(&img0);
+        uint32_t u_w = s->l0.is_int8 ? (uint32_t)((const int8_t*)s->l0.w)[0] : *(const uint32_t*)s->l0.w;
+        YOLO_LOG("DEBUG img0=0x%08X w0=0x%08X\n", (unsigned)u_img, (unsigned)u_w);
+    }
+#endif
+    YOLO_LOG("Running inference...\n");
+    yolo_timing_reset();
+    roofline_reset();
+    uint64_t t_total_start = timer_read64();
+    uint64_t t_stage_start;
+    uint64_t t_layer;
+    uint64_t cycles_backbone = 0, cycles_neck = 0, cycles_head = 0, cycles_decode = 0, cycles_nms = 0;
+    uint64_t layer_cycles[24];  /* L0..L23 per-layer (op only) */
+
+    YOLO_LOG("Backbone: ");
+
+    // ===== Backbone =====
+    t_stage_start = timer_read64();
+    /* batch > 1: 이미지 n장을 NCHW 한 덩어리로 */
+    if (n > 1) {
+        const size_t img_elems = (size_t)3 * YOLO_INPUT_SIZE * YOLO_INPUT_SIZE;
+        float* const batch_in = BUF(BUF_INPUT);
+        for (int32_t b = 0; b < n; b++)
+            memcpy(batch_in + (size_t)b * img_elems, images[b].data, img_elems * sizeof(float));
+        input = batch_in;
+    }
+    yolo_timing_set_layer(0);
+    // Layer 0: Conv 6x6 s2
+    t_layer = timer_read64();
+    conv_block_nchw_f32(input, n, 3, 640, 640, P_CONV(s->l0), 16, 6, 6, 2, 2, 2, 2, s->l0.b, l0, 320, 320);
+    layer_cycles[0] = layer_done(0, t_layer, l0);
+
+    yolo_timing_set_layer(1);
+    // Layer 1: Conv 3x3 s2
+    t_layer = timer_read64();
+    conv_block_nchw_f32(l0, n, 16, 320, 320, P_CONV(s->l1), 32, 3, 3, 2, 2, 1, 1, s->l1.b, l1, 160, 160);
+    layer_cycles[1] = layer_done(1, t_layer, l1);
+
+    yolo_timing_set_layer(2);
+    // Layer 2: C3 (n=1)
+    t_layer = timer_read64();
+    c3_run(&s->l2, l1, NULL, n, 32, 160, 160, 16, 32, 1, l2, 0, BUF(BUF_S2));
+    layer_cycles[2] = layer_done(2, t_layer, l2);
+
+    yolo_timing_set_layer(3);
+    // Layer 3: Conv 3x3 s2
+    t_layer = timer_read64();
+    conv_block_nchw_f32(l2, n, 32, 160, 160, P_CONV(s->l3), 64, 3, 3, 2, 2, 1, 1, s->l3.b, l3, 80, 80);
+    layer_cycles[3] = layer_done(3, t_layer, l3);
+
+    yolo_timing_set_layer(4);
+    // Layer 4: C3 (n=2)
+    t_layer = timer_read64();
+    c3_run(&s->l4, l3, NULL, n, 64, 80, 80, 32, 64, 1, l4, 0, BUF(BUF_S4));
+    layer_cycles[4] = layer_done(4, t_layer, l4);
+
+    yolo_timing_set_layer(5);
+    // Layer 5: Conv 3x3 s2
+    t_layer = timer_read64();
+    conv_block_slice_nchw_f32(l4, 0, n, 64, 80, 80, P_CONV(s->l5), 128, 3, 3, 2, 2, 1, 1, s->l5.b, l5, 0, 40, 40);
+    layer_cycles[5] = layer_done(5, t_layer, l5);
+
+    yolo_timing_set_layer(6);
+    // Layer 6: C3 (n=3)
+    t_layer = timer_read64();
+    c3_run(&s->l6, l5, NULL, n, 128, 40, 40, 64, 128, 1, l6, 0, BUF(BUF_S6));
+    layer_cycles[6] = layer_done(6, t_layer, l6);
+
+    yolo_timing_set_layer(7);
+    // Layer 7: Conv 3x3 s2
+    t_layer = timer_read64();
+    conv_block_slice_nchw_f32(l6, 0, n, 128, 40, 40, P_CONV(s->l7), 256, 3, 3, 2, 2, 1, 1, s->l7.b, l7, 0, 20, 20);
+    layer_cycles[7] = layer_done(7, t_layer, l7);
+
+    yolo_timing_set_layer(8);
+    // Layer 8: C3 (n=1)
+    t_layer = timer_read64();
+    c3_run(&s->l8, l7, NULL, n, 256, 20, 20, 128, 256, 1, l8, 0, BUF(BUF_S8));
+    layer_cycles[8] = layer_done(8, t_layer, l8);
+
+    yolo_timing_set_layer(9);
+    // Layer 9: SPPF
+    t_layer = timer_read64();
+    sppf_nchw_f32(l8, n, 256, 20, 20,
+        P_CONV(s->l9_cv1), 128, s->l9_cv1.b,
+        P_CONV(s->l9_cv2), 256, s->l9_cv2.b,
+        5, l9, BUF(BUF_S9));
+    layer_cycles[9] = layer_done(9, t_layer, l9);
+    cycles_backbone = timer_delta64(t_stage_start, timer_read64());
+
+    // ===== Neck =====
+    YOLO_LOG("\nNeck: ");
+    t_stage_start = timer_read64();
+    yolo_timing_set_layer(10);
+    // Layer 10: Conv 1x1
+    t_layer = timer_read64();
+    conv_block_slice_nchw_f32(l9, 0, n, 256, 20, 20, P_CONV(s->l10), 128, 1, 1, 1, 1, 0, 0, s->l10.b, l10, 256, 20, 20);
+    layer_cycles[10] = layer_done(10, t_layer, l10);
+
+    yolo_timing_set_layer(11);
+    // Layer 11: Upsample — 가상 (L13 cv1·cv2가 l10을 index halving으로 읽음, 첫 값 = l10[0])
+    layer_cycles[11] = layer_done(11, timer_read64(), l10);
+
+    yolo_timing_set_layer(12);
+    // Layer 12: Concat (up2x(l10) + l6) — 가상 (버퍼 없음)
+    layer_cycles[12] = layer_done(12, timer_read64(), l10);
+
+    yolo_timing_set_layer(13);
+    // Layer 13: C3 (n=1)
+    t_layer = timer_read64();
+    c3_run(&s->l13, NULL, &l12, n, 256, 40, 40, 64, 128, 0, l13, 0, BUF(BUF_S13));
+    layer_cycles[13] = layer_done(13, t_layer, l13);
+
+    yolo_timing_set_layer(14);
+    // Layer 14: Conv 1x1
+    t_layer = timer_read64();
+    conv_block_slice_nchw_f32(l13, 0, n, 128, 40, 40, P_CONV(s->l14), 64, 1, 1, 1, 1, 0, 0, s->l14.b, l14, 128, 40, 40);
+    layer_cycles[14] = layer_done(14, t_layer, l14);
+
+    yolo_timing_set_layer(15);
+    // Layer 15: Upsample — 가상 (L17 cv1·cv2가 l14를 index halving으로 읽음, 첫 값 = l14[0])
+    layer_cycles[15] = layer_done(15, timer_read64(), l14);
+
+    yolo_timing_set_layer(16);
+    // Layer 16: Concat (up2x(l14) + l4) — 가상 (버퍼 없음)
+    layer_cycles[16] = layer_done(16, timer_read64(), l14);
+
+    yolo_timing_set_layer(17);
+    // Layer 17: C3 (n=1) -> P3
+    t_layer = timer_read64();
+    c3_run(&s->l17, NULL, &l16, n, 128, 80, 80, 32, 64, 0, l17, 0, BUF(BUF_S17));
+    layer_cycles[17] = layer_done(17, t_layer, l17);
+
+    yolo_timing_set_layer(18);
+    // Layer 18: Conv 3x3 s2
+    t_layer = timer_read64();
+    conv_block_slice_nchw_f32(l17, 0, n, 64, 80, 80, P_CONV(s->l18), 64, 3, 3, 2, 2, 1, 1, s->l18.b, l18, 128, 40, 40);
+    layer_cycles[18] = layer_done(18, t_layer, l18);
+
+    yolo_timing_set_layer(19);
+    // Layer 19: Concat (l18 + l14) — 두 입력이 이미 l19 채널 구간에 기록됨 (복사 없음)
+    layer_cycles[19] = layer_done(19, timer_read64(), l19);
+
+    yolo_timing_set_layer(20);
+    // Layer 20: C3 (n=1) -> P4
+    t_layer = timer_read64();
+    c3_run(&s->l20, l19, NULL, n, 128, 40, 40, 64, 128, 0, l20, 0, BUF(BUF_S20));
+    layer_cycles[20] = layer_done(20, t_layer, l20);
+
+    yolo_timing_set_layer(21);
+    // Layer 21: Conv 3x3 s2
+    t_layer = timer_read64();
+    conv_block_slice_nchw_f32(l20, 0, n, 128, 40, 40, P_CONV(s->l21), 128, 3, 3, 2, 2, 1, 1, s->l21.b, l21, 256, 20, 20);
+    layer_cycles[21] = layer_done(21, t_layer, l21);
+
+    yolo_timing_set_layer(22);
+    // Layer 22: Concat (l21 + l10) — 두 입력이 이미 l22 채널 구간에 기록됨 (복사 없음)
+    layer_cycles[22] = layer_done(22, timer_read64(), l22);
+
+    yolo_timing_set_layer(23);
+    // Layer 23: C3 (n=1) -> P5
+    t_layer = timer_read64();
+    c3_run(&s->l23, l22, NULL, n, 256, 20, 20, 128, 256, 0, l23, 0, BUF(BUF_S23));
+    layer_cycles[23] = layer_done(23, t_layer, l23);
+    cycles_neck = timer_delta64(t_stage_start, timer_read64());
+    (void)layer_cycles;
+
+    // ===== Detect Head =====
+    YOLO_LOG("\nHead: ");
+    yolo_timing_set_layer(24);
+    t_stage_start = timer_read64();
+#undef BUF
+    /* sparse: head는 decode 단계에서 이미지별로 (objectness 3채널 + 통과 anchor만) */
+    if (!s->head_sparse) {
+        detect_nchw_f32(n,
+            l17, 64, 80, 80, l20, 128, 40, 40, l23, 256, 20, 20,
+            P_CONV(s->det[0]), s->det[0].b,
+            P_CONV(s->det[1]), s->det[1].b,
+            P_CONV(s->det[2]), s->det[2].b,
+            p3, p4, p5);
+    }
+    YOLO_LOG(s->head_sparse ? "Detect (sparse, in decode)\n" : "Detect\n");
+    cycles_head = timer_delta64(t_stage_start, timer_read64());
+#ifdef BARE_METAL
+    YOLO_LOG("  det %llu ms", LAYER_MS_INT(cycles_head));
+#else
+    YOLO_LOG("  det %.2f ms", LAYER_MS(cycles_head));
+#endif
+    RATE_LOG(24, cycles_head);
+    yolo_timing_print_layer_ops(24);
+#ifdef BARE_METAL
+    if (!s->head_sparse) {
+        Xil_DCacheFlushRange((uintptr_t)DETECT_HEAD_BASE, (unsigned int)DETECT_HEAD_SIZE);
+        __sync_synchronize();
+    }
+#endif
+
+    // ===== Decode / NMS (이미지별) =====
+    int32_t num_dets_all = 0, num_nms_all = 0;
+    for (int32_t bi = 0; bi < n; bi++) {
+        const float* p3_b = p3 + (size_t)bi * 255 * 80 * 80;
+        const float* p4_b = p4 + (size_t)bi * 255 * 40 * 40;
+        const float* p5_b = p5 + (size_t)bi * 255 * 20 * 20;
+
+        yolo_timing_set_layer(25);
+        t_stage_start = timer_read64();
+        detection_t* dets = s->dets;
+        int32_t num_dets;
+        if (s->head_sparse) {
+            num_dets = detect_decode_sparse_nchw_f32(
+                l17 + (size_t)bi * 64 * 80 * 80, 64, 80, 80,
+                l20 + (size_t)bi * 128 * 40 * 40, 128, 40, 40,
+                l23 + (size_t)bi * 256 * 20 * 20, 256, 20, 20,
+                P_CONV(s->det[0]), s->det[0].b,
+                P_CONV(s->det[1]), s->det[1].b,
+                P_CONV(s->det[2]), s->det[2].b,
+                YOLO_NUM_CLASSES, CONF_THRESHOLD, YOLO_INPUT_SIZE, STRIDES, ANCHORS,
+                dets, YOLO_MAX_DETECTIONS);
+            if (num_dets < 0) return -1;
+        } else {
+            num_dets = decode_nchw_f32(
+                p3_b, 80, 80, p4_b, 40, 40, p5_b, 20, 20,
+                YOLO_NUM_CLASSES, CONF_THRESHOLD, YOLO_INPUT_SIZE, STRIDES, ANCHORS,
+                dets, YOLO_MAX_DETECTIONS);
+        }
+        cycles_decode += timer_delta64(t_stage_start, timer_read64());
+        num_dets_all += num_dets;
+        if (YOLO_DEBUG && bi == 0 && !s->head_sparse) {
+            union { float f; uint32_t u; } u0 = { .f = p3_b[0] }, u1 = { .f = p3_b[1] }, u4 = { .f = p3_b[4 * 80 * 80] };
+            YOLO_LOG("DEBUG p3[0]=0x%08X p3[1]=0x%08X p3[obj0]=0x%08X\n", (unsigned)u0.u, (unsigned)u1.u, (unsigned)u4.u);
+        }
+
+        // Sort by confidence (안정 병합 정렬) + NMS (클래스 bucket, 결과를 dets_out에 바로)
+        yolo_timing_set_layer(26);
+        t_stage_start = timer_read64();
+        nms_sort_by_conf(dets, num_dets, s->post_scratch);
+        int32_t num_nms = nms_sorted(dets, num_dets, IOU_THRESHOLD,
+                                     dets_out + (size_t)bi * max_dets,
+                                     max_dets < YOLO_MAX_DETECTIONS ? max_dets : YOLO_MAX_DETECTIONS,
+                                     s->post_scratch, nms_scratch_bytes(YOLO_MAX_DETECTIONS));
+        cycles_nms += timer_delta64(t_stage_start, timer_read64());
+        if (num_nms < 0) num_nms = 0;
+        counts_out[bi] = num_nms;
+        num_nms_all += num_nms;
+    }
+    prof_layer(-1);  /* 마지막 레이어 스코프 닫기 */
+    YOLO_LOG("Decoded: %d detections\n", num_dets_all);
+#ifdef BARE_METAL
+    YOLO_LOG("  dec %llu ms", LAYER_MS_INT(cycles_decode));
+#else
+    YOLO_LOG("  dec %.2f ms", LAYER_MS(cycles_decode));
+#endif
+    RATE_LOG(25, cycles_decode);
+    yolo_timing_print_layer_ops(25);
+#ifdef BARE_METAL
+    YOLO_LOG("  nms %llu ms\n", LAYER_MS_INT(cycles_nms));
+#else
+    YOLO_LOG("  nms %.2f ms\n", LAYER_MS(cycles_nms));
+#endif
+    yolo_timing_print_layer_ops(26);
+    {
+        uint64_t total = timer_delta64(t_total_start, timer_read64());
+#ifdef BARE_METAL
+        {
+            YOLO_LOG("[mcycle] backbone=%llu neck=%llu head=%llu decode=%llu nms=%llu total=%llu\n",
+                     (unsigned long long)cycles_backbone, (unsigned long long)cycles_neck,
+                     (unsigned long long)cycles_head, (unsigned long long)cycles_decode,
+                     (unsigned long long)cycles_nms, (unsigned long long)total);
+            YOLO_LOG("[time @ %dMHz] backbone=%llu neck=%llu head=%llu decode=%llu nms=%llu total=%llu ms\n",
+                     (int)CPU_MHZ, LAYER_MS_INT(cycles_backbone), LAYER_MS_INT(cycles_neck),
+                     LAYER_MS_INT(cycles_head), LAYER_MS_INT(cycles_decode), LAYER_MS_INT(cycles_nms),
+                     LAYER_MS_INT(total));
+        }
+#else
+        YOLO_LOG("[time] backbone=%.2f ms neck=%.2f ms head=%.2f ms decode=%.2f ms nms=%.2f ms total=%.2f ms\n",
+                 cycles_backbone / 1000.0, cycles_neck / 1000.0, cycles_head / 1000.0,
+                 cycles_decode / 1000.0, cycles_nms / 1000.0, total / 1000.0);
+        if (n > 1) YOLO_LOG("[time] batch=%d per_image=%.2f ms\n", (int)n, total / 1000.0 / n);
+#endif
+    }
+    if (YOLO_VERBOSE) {
+        uint64_t ticks[ROOFLINE_LAYERS];
+        for (int i = 0; i < 24; i++) ticks[i] = layer_cycles[i];
+        ticks[24] = cycles_head;
+        ticks[25] = cycles_decode;
+        ticks[26] = cycles_nms;
+        roofline_print_summary(ticks);
+    }
+    YOLO_LOG("After NMS: %d detections\n", num_nms_all);
+    return 0;
+}
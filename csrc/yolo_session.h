@@ -0,0 +1,61 @@
+/**
+ * YOLOv5n 추론 세션: 가중치 로드 / 텐서 조회 / 가중치 재배치 / 풀 생성은 create에서 1회,
+ * infer는 이미지마다 네트워크만 실행. main.c는 이 API 위의 얇은 CLI.
+ *
+ * feature_pool / weight_pack / thread_pool이 전역이므로 동시에 세션 1개만 생성 가능.
+ * batch N: 모든 레이어를 n장 한 번에 실행 → 레이어 가중치를 이미지 N장이 공유(캐시에서 한 번 읽고 N장에 사용).
+ */
+#ifndef YOLO_SESSION_H
+#define YOLO_SESSION_H
+
+#include <stdint.h>
+#include "utils/image_loader.h"
+#include "blocks/decode.h"
+#include "utils/memory_plan.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define YOLO_INPUT_SIZE     640
+#define YOLO_NUM_CLASSES    80
+#define YOLO_MAX_DETECTIONS 300
+
+typedef struct yolo_session yolo_session_t;
+
+/**
+ * 세션 생성.
+ * weights_path: 호스트 weights.bin / weights_w8.bin (USE_WEIGHTS_W8) 경로. BARE_METAL은 무시(DDR 제로카피).
+ * num_threads: thread_pool_init 인자 (0 = CPU 수).
+ * max_batch: infer_batch 최대 장수 (호스트 피처맵 풀을 이 배수로 잡음). BARE_METAL은 1만 (DETECT_HEAD 영역 1장분).
+ * 실패 시 NULL
+ */
+yolo_session_t* yolo_session_create(const char* weights_path, int32_t num_threads, int32_t max_batch);
+
+/**
+ * 1장 추론. image: (3, 640, 640) NCHW. dets_out[max_dets]에 NMS 후 결과(정규화 좌표, conf 내림차순).
+ * 반환: 검출 개수, -1 실패
+ */
+int32_t yolo_session_infer(yolo_session_t* s, const preprocessed_image_t* image,
+                           detection_t* dets_out, int32_t max_dets);
+
+/**
+ * n장 추론 (n <= max_batch). 이미지 i의 결과는 dets_out[i * max_dets ..], 개수는 counts_out[i].
+ * 반환: 0 성공, -1 실패
+ */
+int yolo_session_infer_batch(yolo_session_t* s, const preprocessed_image_t* images, int32_t n,
+                             detection_t* dets_out, int32_t max_dets, int32_t* counts_out);
+
+void yolo_session_destroy(yolo_session_t* s);
+
+/**
+ * 세션 arena 버퍼 수명표 (create가 memory_plan_solve에 넘기는 것과 같음, 오프셋 미배치).
+ * step = 레이어 번호, 24 Detect, 25 decode. b는 MEMORY_PLAN_MAX_BUFS개 이상. 반환: 버퍼 개수
+ */
+int32_t yolo_session_plan_buffers(int32_t max_batch, int head_sparse, memory_plan_buf_t* b);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* YOLO_SESSION_H */
@@ -8,11 +8,11 @@ if not exist "%GCC%" (
 
 echo Building main.exe with %GCC% ...
 call "%GCC%" -o main.exe ^
-  csrc/main.c ^
+  csrc/main.c csrc/yolo_session.c ^
   csrc/blocks/conv.c csrc/blocks/c3.c csrc/blocks/decode.c csrc/blocks/detect.c csrc/blocks/nms.c csrc/blocks/sppf.c ^
-  csrc/operations/bottleneck.c csrc/operations/concat.c csrc/operations/conv2d.c csrc/operations/maxpool2d.c csrc/operations/silu.c csrc/operations/upsample.c ^
-  csrc/utils/feature_pool.c csrc/utils/image_loader.c csrc/utils/weights_loader.c csrc/utils/timing.c csrc/utils/uart_dump.c ^
-  -I. -Icsrc -std=c99 -O2 -lm ^
+  csrc/operations/bottleneck.c csrc/operations/concat.c csrc/operations/conv2d.c csrc/operations/conv2d_tune.c csrc/operations/conv2d_stem.c csrc/operations/conv2d_1x1.c csrc/operations/conv2d_gemm.c csrc/operations/conv2d_winograd.c csrc/operations/weight_pack.c csrc/operations/maxpool2d.c csrc/operations/silu.c csrc/operations/upsample.c ^
+  csrc/utils/feature_pool.c csrc/utils/memory_plan.c csrc/utils/thread_pool.c csrc/utils/image_loader.c csrc/utils/weights_loader.c csrc/utils/timing.c csrc/utils/profiler.c csrc/utils/roofline.c csrc/utils/uart_dump.c ^
+  -I. -Icsrc -std=c99 -O2 -lm -pthread ^
   1>gcc_out.txt 2>gcc_err.txt
 
 set ERR=%ERRORLEVEL%
@@ -8,7 +8,7 @@ OUT=data/output
 mkdir -p "$OUT"
 
 echo "=== 1) FP32 (수정 전) 빌드 및 실행 ==="
-gcc -o main csrc/main.c csrc/blocks/*.c csrc/operations/*.c csrc/utils/*.c -I. -Icsrc -lm -std=c99 -O2 2>&1
+gcc -o main csrc/main.c csrc/yolo_session.c csrc/blocks/*.c csrc/operations/*.c csrc/utils/*.c -I. -Icsrc -lm -std=c99 -O2 -pthread 2>&1
 ./main 2>&1 | tee "$OUT/ref_fp32_log.txt"
 cp -f "$OUT/detections.bin" "$OUT/ref_fp32_detections.bin"
 cp -f "$OUT/detections.txt" "$OUT/ref_fp32_detections.txt"
@@ -16,7 +16,7 @@ echo "  저장: $OUT/ref_fp32_detections.bin, ref_fp32_log.txt"
 
 echo ""
 echo "=== 2) W8A32 (수정 후) 빌드 및 실행 ==="
-gcc -o main csrc/main.c csrc/blocks/*.c csrc/operations/*.c csrc/utils/*.c -I. -Icsrc -lm -std=c99 -O2 -DUSE_WEIGHTS_W8 2>&1
+gcc -o main csrc/main.c csrc/yolo_session.c csrc/blocks/*.c csrc/operations/*.c csrc/utils/*.c -I. -Icsrc -lm -std=c99 -O2 -pthread -DUSE_WEIGHTS_W8 2>&1
 ./main 2>&1 | tee "$OUT/w8_log.txt"
 echo "  저장: $OUT/detections.bin (W8), $OUT/w8_log.txt"
 
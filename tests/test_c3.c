@@ -5,6 +5,12 @@
 #include "test_vectors_c3.h"
 #include "../csrc/utils/weights_loader.h"
 #include "../csrc/blocks/c3.h"
+#include "../csrc/operations/conv2d.h"
+#include "../csrc/operations/weight_pack.h"
+#include "../csrc/utils/feature_pool.h"
+
+/* Winograd F(2x2,3x3) 허용 오차: golden 대비 및 direct 대비 */
+#define WINOGRAD_TOL 1e-4f
 
 static float max_abs_diff(const float* a, const float* b, int n) {
     float m = 0.0f;
@@ -54,6 +60,8 @@ int main(void) {
     const int c_out = TV_C3_Y_C;
     
     static float y_out[1 * 32 * 160 * 160];
+    static float y_wino[1 * 32 * 160 * 160];
+    feature_pool_init();
     
     // C3 블록 실행 (Fused). FP32 가중치이므로 scale=0, is_int8=0
     const void* bn_cv1_w_arr[1] = {bn_cv1_w};
@@ -65,8 +73,9 @@ int main(void) {
     const float* bn_cv1_b_arr[1] = {bn_cv1_b};
     const float* bn_cv2_b_arr[1] = {bn_cv2_b};
     
+    conv2d_set_algo(CONV2D_ALGO_DIRECT);
     c3_nchw_f32(
-        tv_c3_x, n, c_in, h, w,
+        tv_c3_x, n, c_in, h, w, NULL,
         (const void*)cv1_w, 0.f, 0, 16, cv1_b,
         (const void*)cv2_w, 0.f, 0, 16, cv2_b,
         (const void*)cv3_w, 0.f, 0, 32, cv3_b,
@@ -74,19 +83,43 @@ int main(void) {
         bn_cv1_w_arr, bn_cv1_scale, bn_cv1_is_int8, bn_cv1_b_arr,
         bn_cv2_w_arr, bn_cv2_scale, bn_cv2_is_int8, bn_cv2_b_arr,
         1,
-        y_out);
+        y_out, 0, NULL);
     
+    // 같은 입력으로 Winograd 경로 (bottleneck cv2 3x3 s1, 필터 변환은 로드 직후 1회)
+    if (weight_pack_prepare(&weights, WEIGHT_PACK_WINOGRAD) != 0) {
+        fprintf(stderr, "weight_pack_prepare failed\n");
+        weights_free(&weights);
+        return 1;
+    }
+    conv2d_set_algo(CONV2D_ALGO_WINOGRAD);
+    c3_nchw_f32(
+        tv_c3_x, n, c_in, h, w, NULL,
+        (const void*)cv1_w, 0.f, 0, 16, cv1_b,
+        (const void*)cv2_w, 0.f, 0, 16, cv2_b,
+        (const void*)cv3_w, 0.f, 0, 32, cv3_b,
+        1,
+        bn_cv1_w_arr, bn_cv1_scale, bn_cv1_is_int8, bn_cv1_b_arr,
+        bn_cv2_w_arr, bn_cv2_scale, bn_cv2_is_int8, bn_cv2_b_arr,
+        1,
+        y_wino, 0, NULL);
+
     const int elems = n * c_out * h * w;
     float diff = max_abs_diff(y_out, tv_c3_y, elems);
+    float diff_wino = max_abs_diff(y_wino, tv_c3_y, elems);
+    float diff_wino_direct = max_abs_diff(y_wino, y_out, elems);
     
     printf("Layer 2 (C3, n=1)\n");
     printf("  Input:  %d x %d x %d x %d\n", n, c_in, h, w);
     printf("  Output: %d x %d x %d x %d\n", n, c_out, h, w);
-    printf("  Max diff: %g\n\n", diff);
+    printf("  Max diff (direct):            %g\n", diff);
+    printf("  Max diff (winograd):          %g\n", diff_wino);
+    printf("  Max diff (winograd - direct): %g (tol %g)\n\n", diff_wino_direct, WINOGRAD_TOL);
     
+    weight_pack_release();
+    feature_pool_reset();
     weights_free(&weights);
     
-    if (diff < 1e-4f) {
+    if (diff < 1e-4f && diff_wino < WINOGRAD_TOL && diff_wino_direct < WINOGRAD_TOL) {
         printf("Result: OK\n");
         return 0;
     }
@@ -47,10 +47,10 @@ int main(void) {
 
     static float y_out[1 * 16 * 320 * 320];
 
-    // Conv 블록 실행 (Fused: Conv + Bias + SiLU)
+    // Conv 블록 실행 (Fused: Conv + Bias + SiLU). FP32 가중치이므로 scale=0, is_int8=0
     conv_block_nchw_f32(
         tv_x, n, c_in, h_in, w_in,
-        conv_weight, c_out, k, k,
+        conv_weight, 0.f, 0, c_out, k, k,
         stride, stride,
         pad, pad,
         conv_bias,
@@ -0,0 +1,116 @@
+/* 1x1 W8 conv 테스트: conv2d_nchw_f32_w8 (1x1 fast path, SIMD 빌드면 SIMD 커널)
+ * vs FP32 direct reference (가중치를 w*scale로 복원), 가상 업샘플 concat 입력(conv2d_up_concat_1x1_nchw_f32)
+ * vs 실제 업샘플 + concat 후 conv. 가중치 파일 불필요. */
+#include <stdio.h>
+#include <math.h>
+
+#include "../csrc/operations/conv2d.h"
+#include "../csrc/operations/conv2d_1x1.h"
+#include "test_util.h"
+
+#define MAX_CIN  256
+#define MAX_COUT 255
+#define MAX_P    (20 * 20)
+
+static float x_buf[MAX_CIN * MAX_P];
+static int8_t w8_buf[MAX_COUT * MAX_CIN];
+static float w_f32[MAX_COUT * MAX_CIN];
+static float bias_buf[MAX_COUT];
+static float y_ref[MAX_COUT * MAX_P];
+static float y_out[MAX_COUT * MAX_P];
+
+/* 가상 concat: [up2x(lo) c_up | hi c_x], batch 2, 두 입력 모두 더 큰 버퍼의 채널 구간 (이미지 간격 > 밀집) */
+#define UP_N   2
+#define UP_CUP 24
+#define UP_CX  40
+#define UP_H   10
+#define UP_W   14   /* P = 140: strip·벡터 나머지 모두 통과 */
+#define UP_CA  12
+#define UP_CB  8
+#define UP_LO_IMG ((UP_CUP + 8) * (UP_H / 2) * (UP_W / 2))
+#define UP_HI_IMG ((UP_CX + 4) * UP_H * UP_W)
+static float lo_buf[UP_N * UP_LO_IMG];
+static float hi_buf[UP_N * UP_HI_IMG];
+static float cat_buf[UP_N * (UP_CUP + UP_CX) * UP_H * UP_W];
+static int8_t wa_buf[UP_CA * (UP_CUP + UP_CX)];
+static int8_t wb_buf[UP_CB * (UP_CUP + UP_CX)];
+
+/* c_out 255: oc 블록 끝 처리, 7x9 / 20x20: 픽셀 벡터 나머지 처리 */
+static const int cases[][4] = {   /* c_in, c_out, h, w */
+    {  32,  16, 20, 20 },
+    { 256, 255, 20, 20 },
+    {  64,  64,  7,  9 },
+    {   3,   5,  1,  3 },
+};
+
+int main(void) {
+    test_seed(12345u);
+    printf("=== Conv 1x1 W8 Test (%s) ===\n\n", CONV2D_1X1_ISA);
+
+    const float scale = 0.0123f;
+    float worst = 0.0f;
+    conv2d_set_algo(CONV2D_ALGO_GEMM);   /* DIRECT는 reference라 1x1 SIMD를 쓰지 않음 */
+
+    for (unsigned t = 0; t < sizeof(cases) / sizeof(cases[0]); t++) {
+        const int c_in = cases[t][0], c_out = cases[t][1], h = cases[t][2], w = cases[t][3];
+        for (int i = 0; i < c_in * h * w; i++) x_buf[i] = frand() * 4.0f;
+        for (int i = 0; i < c_out * c_in; i++) {
+            w8_buf[i] = (int8_t)(frand() * 127.0f);
+            w_f32[i] = (float)w8_buf[i] * scale;
+        }
+        for (int i = 0; i < c_out; i++) bias_buf[i] = frand();
+
+        conv2d_direct_nchw_f32(x_buf, 1, c_in, h, w, w_f32, c_out, 1, 1, bias_buf,
+                               1, 1, 0, 0, 1, y_ref, h, w);
+        conv2d_nchw_f32_w8(x_buf, 1, c_in, h, w, w8_buf, scale, c_out, 1, 1, bias_buf,
+                           1, 1, 0, 0, 1, y_out, h, w);
+
+        float diff = max_abs_diff(y_out, y_ref, c_out * h * w);
+        printf("  %3d -> %3d  %2dx%-2d  Max diff: %g\n", c_in, c_out, h, w, diff);
+        if (diff > worst) worst = diff;
+    }
+
+    /* 가상 업샘플 concat 입력: cv1·cv2 쌍 (연결 패널 없음 → 각각), SiLU epilogue */
+    {
+        const int c_in = UP_CUP + UP_CX, P = UP_H * UP_W, hw_lo = (UP_H / 2) * (UP_W / 2);
+        for (int i = 0; i < UP_N * UP_LO_IMG; i++) lo_buf[i] = frand() * 4.0f;
+        for (int i = 0; i < UP_N * UP_HI_IMG; i++) hi_buf[i] = frand() * 4.0f;
+        for (int i = 0; i < UP_CA * c_in; i++) wa_buf[i] = (int8_t)(frand() * 127.0f);
+        for (int i = 0; i < UP_CB * c_in; i++) wb_buf[i] = (int8_t)(frand() * 127.0f);
+        for (int i = 0; i < UP_CA + UP_CB; i++) bias_buf[i] = frand();
+        for (int b = 0; b < UP_N; b++) {
+            float* cat = cat_buf + (size_t)b * c_in * P;
+            for (int c = 0; c < UP_CUP; c++)
+                for (int p = 0; p < P; p++)
+                    cat[c * P + p] = lo_buf[b * UP_LO_IMG + c * hw_lo + (p / UP_W / 2) * (UP_W / 2) + (p % UP_W) / 2];
+            for (int i = 0; i < UP_CX * P; i++) cat[UP_CUP * P + i] = hi_buf[b * UP_HI_IMG + i];
+        }
+        const conv2d_epilogue_t ep = { 1, NULL, 0 };
+        const conv2d_up_concat_t v = { lo_buf, UP_CUP, UP_LO_IMG, hi_buf, UP_HI_IMG };
+        conv2d_up_concat_1x1_nchw_f32(&v, UP_N, c_in, UP_H, UP_W,
+                                      wa_buf, scale, 1, UP_CA, bias_buf,
+                                      wb_buf, scale, 1, UP_CB, bias_buf + UP_CA, &ep, y_out);
+        float diff = 0.0f;
+        for (int b = 0; b < UP_N; b++) {
+            const float* cat = cat_buf + (size_t)b * c_in * P;
+            const float* yb = y_out + (size_t)b * (UP_CA + UP_CB) * P;
+            conv2d_fused_nchw_f32(cat, 1, c_in, UP_H, UP_W, wa_buf, scale, 1, UP_CA, 1, 1, bias_buf,
+                                  1, 1, 0, 0, &ep, y_ref, UP_H, UP_W);
+            conv2d_fused_nchw_f32(cat, 1, c_in, UP_H, UP_W, wb_buf, scale, 1, UP_CB, 1, 1, bias_buf + UP_CA,
+                                  1, 1, 0, 0, &ep, y_ref + UP_CA * P, UP_H, UP_W);
+            const float d = max_abs_diff(yb, y_ref, (UP_CA + UP_CB) * P);
+            if (d > diff) diff = d;
+        }
+        printf("  up2x|concat %d+%d -> %d+%d  %dx%d batch %d  Max diff: %g\n",
+               UP_CUP, UP_CX, UP_CA, UP_CB, UP_H, UP_W, UP_N, diff);
+        if (diff > worst) worst = diff;
+    }
+    printf("\n");
+
+    if (worst < 1e-4f) {
+        printf("Result: OK\n");
+        return 0;
+    }
+    printf("Result: NG\n");
+    return 1;
+}
@@ -0,0 +1,139 @@
+/* conv2d 블로킹 plan 테스트: plan 해석·등록·제약 검사 (형식 오류 시 plan 불변), 파일 저장/로드 왕복, 그리고 direct 커널이
+ * 어떤 타일/oc 블록에서도 기본 블로킹과 bit 단위로 같은지 (OIHW FP32·INT8, weight_pack DIRECT FP32·INT8).
+ * 가중치 파일 불필요. */
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "../csrc/operations/conv2d.h"
+#include "../csrc/operations/conv2d_tune.h"
+#include "../csrc/operations/weight_pack.h"
+#include "test_util.h"
+
+#define C_IN  5
+#define C_OUT 40   /* OC_BLOCK(32) 배수 아님: 끝 블록 + 배치 블록 안 sub-block */
+#define H     13
+#define W     11
+
+static float x_buf[C_IN * H * W];
+static float wf_buf[C_OUT * C_IN * 9];
+static int8_t wi_buf[C_OUT * C_IN * 9];
+static int8_t wi1_buf[C_OUT * C_IN];   /* 1x1 (pack 조회 key가 달라야 함) */
+static float bias_buf[C_OUT];
+static float y_ref[C_OUT * H * W];
+static float y_out[C_OUT * H * W];
+
+/* k×k stride s conv 하나 (pad k/2), kind 0: OIHW FP32, 1: OIHW INT8, 2: 현재 weight_pack 경유 INT8 */
+static void run(int kind, int32_t k, int32_t s, float* y) {
+    const int32_t p = k / 2, ho = (H + 2 * p - k) / s + 1, wo = (W + 2 * p - k) / s + 1;
+    const int8_t* wi = k == 1 ? wi1_buf : wi_buf;
+    if (kind == 0)
+        conv2d_direct_nchw_f32(x_buf, 1, C_IN, H, W, wf_buf, C_OUT, k, k, bias_buf, s, s, p, p, 1, y, ho, wo);
+    else if (kind == 1)
+        conv2d_direct_nchw_f32_w8(x_buf, 1, C_IN, H, W, wi, 0.01f, C_OUT, k, k, bias_buf, s, s, p, p, 1, y, ho, wo);
+    else
+        conv2d_nchw_f32_w8(x_buf, 1, C_IN, H, W, wi, 0.01f, C_OUT, k, k, bias_buf, s, s, p, p, 1, y, ho, wo);
+}
+
+int main(void) {
+    test_seed(777u);
+    printf("=== Conv2d Tuning Plan Test ===\n\n");
+    int ok = 1;
+
+    /* 1) 해석·제약 */
+    conv2d_tune_clear();
+    static const char plan[] =
+        "# comment\n"
+        "\n"
+        "16 32 3 3 2 2 160 160 4 16 16\r\n"
+        "  3 16 6 6 2 2 320 320 8 8 32   # trailing\n"
+        "16 32 3 3 2 2 160 160 2 8 8\n";   /* 같은 shape 갱신 */
+    const conv2d_shape_t s1 = { 16, 32, 3, 3, 2, 2, 160, 160 };
+    const conv2d_shape_t s_none = { 16, 32, 3, 3, 1, 1, 160, 160 };
+    const conv2d_blocking_t bad_oc = { 8, 8, 12 }, bad_pix = { 64, 64, 8 };
+    const int parsed = conv2d_tune_parse(plan, sizeof(plan) - 1) == 2 && conv2d_tune_count() == 2;
+    const conv2d_blocking_t g1 = conv2d_tune_get(&s1), gd = conv2d_tune_get(&s_none);
+    const int lookup = g1.tile_h == 2 && g1.tile_w == 8 && g1.oc_block == 8 &&
+                       gd.tile_h == CONV2D_TILE_H && gd.tile_w == CONV2D_TILE_W && gd.oc_block == CONV2D_OC_BLOCK;
+    const int reject = conv2d_tune_set(&s1, &bad_oc) != 0 && conv2d_tune_set(&s1, &bad_pix) != 0 &&
+                       conv2d_tune_parse("1 2 3\n", 6) < 0 && conv2d_tune_parse("1 2 3 3 1 1 8 8 4 4 x\n", 22) < 0;
+    printf("  parse / lookup / reject: %s\n", parsed && lookup && reject ? "OK" : "NG");
+    ok &= parsed && lookup && reject;
+
+    /* 형식 오류가 뒤에 있으면 앞 줄(추가·갱신)도 반영 안 됨 */
+    static const char bad_tail[] =
+        "16 32 3 3 2 2 160 160 16 16 16\n"
+        "32 64 3 3 2 2 80 80 4 4 4\n"
+        "32 64 1 1 1 1 80 80 4 4\n";
+    const int bad_rc = conv2d_tune_parse(bad_tail, sizeof(bad_tail) - 1);
+    const conv2d_blocking_t g_rb = conv2d_tune_get(&s1);
+    const int rollback = bad_rc < 0 && conv2d_tune_count() == 2 &&
+                         g_rb.tile_h == 2 && g_rb.tile_w == 8 && g_rb.oc_block == 8;
+    printf("  parse error rollback: %s\n", rollback ? "OK" : "NG");
+    ok &= rollback;
+
+    /* 2) 파일 왕복 */
+    const char* path = "tests/_tune_tmp.txt";
+    int file_ok = conv2d_tune_save(path) == 0;
+    conv2d_tune_clear();
+    file_ok = file_ok && conv2d_tune_load(path) == 2;
+    const conv2d_blocking_t g2 = conv2d_tune_get(&s1);
+    file_ok = file_ok && g2.tile_h == 2 && g2.tile_w == 8 && g2.oc_block == 8;
+    remove(path);
+    printf("  save / load: %s\n", file_ok ? "OK" : "NG");
+    ok &= file_ok;
+
+    /* 3) 블로킹 무관 bit-identical */
+    for (int i = 0; i < C_IN * H * W; i++) x_buf[i] = frand() * 2.0f;
+    for (int i = 0; i < C_OUT * C_IN * 9; i++) {
+        wf_buf[i] = frand() * 0.3f;
+        wi_buf[i] = (int8_t)(frand() * 127.0f);
+    }
+    for (int i = 0; i < C_OUT * C_IN; i++) wi1_buf[i] = (int8_t)(frand() * 127.0f);
+    for (int i = 0; i < C_OUT; i++) bias_buf[i] = frand();
+    tensor_info_t t[2] = {
+        { "model.0.conv.weight", NULL, wi_buf, 0.01f, WEIGHTS_DTYPE_INT8, 4, { C_OUT, C_IN, 3, 3 }, 0, 0 },
+        { "model.1.conv.weight", NULL, wi1_buf, 0.01f, WEIGHTS_DTYPE_INT8, 4, { C_OUT, C_IN, 1, 1 }, 0, 0 },
+    };
+    weights_loader_t loader;
+    test_loader_init(&loader, t, 2);
+    static const conv2d_blocking_t blks[] = { { 1, 1, 32 }, { 4, 16, 8 }, { 16, 16, 16 }, { 3, 5, 8 }, { 13, 11, 4 } };
+    static const char* const kinds[] = { "OIHW f32", "OIHW w8", "pack f32", "pack i8" };
+    conv2d_set_algo(CONV2D_ALGO_DIRECT);
+    for (int kind = 0; kind < 4; kind++) {
+        int same = 1;
+        weight_pack_release();
+        if (kind == 2 && weight_pack_prepare(&loader, WEIGHT_PACK_DIRECT | WEIGHT_PACK_DEQUANT) != 0) same = 0;
+        if (kind == 3 && weight_pack_prepare(&loader, WEIGHT_PACK_DIRECT) != 0) same = 0;
+        for (int32_t ks = 1; ks <= 3; ks += 2) {
+            for (int32_t st = 1; st <= 2; st++) {
+                const int32_t p = ks / 2, ho = (H + 2 * p - ks) / st + 1, wo = (W + 2 * p - ks) / st + 1;
+                const conv2d_shape_t sh = { C_IN, C_OUT, (int16_t)ks, (int16_t)ks, (int16_t)st, (int16_t)st,
+                                            (int16_t)ho, (int16_t)wo };
+                const size_t bytes = (size_t)C_OUT * ho * wo * sizeof(float);
+                conv2d_tune_clear();
+                run(kind < 2 ? kind : 2, ks, st, y_ref);
+                for (size_t b = 0; b < sizeof(blks) / sizeof(blks[0]); b++) {
+                    if (conv2d_tune_set(&sh, &blks[b]) != 0) {
+                        same = 0;
+                        continue;
+                    }
+                    memset(y_out, 0, sizeof(y_out));
+                    run(kind < 2 ? kind : 2, ks, st, y_out);
+                    if (memcmp(y_ref, y_out, bytes) != 0) {
+                        printf("    %s k%d s%d blocking %dx%dx%d differs\n", kinds[kind], (int)ks, (int)st,
+                               (int)blks[b].tile_h, (int)blks[b].tile_w, (int)blks[b].oc_block);
+                        same = 0;
+                    }
+                }
+            }
+        }
+        printf("  %-8s blocking-invariant: %s\n", kinds[kind], same ? "OK" : "NG");
+        ok &= same;
+    }
+    weight_pack_release();
+    conv2d_tune_clear();
+
+    printf("\nResult: %s\n", ok ? "OK" : "NG");
+    return ok ? 0 : 1;
+}
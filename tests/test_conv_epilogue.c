@@ -0,0 +1,137 @@
+/* conv epilogue 테스트: 알고리즘별(DIRECT/GEMM/WINOGRAD, 1x1 SIMD) conv + SiLU + residual 한 패스 결과가
+ * conv → silu_nchw_f32 → 덧셈 3패스와 bit 단위로 같은지, residual == y 제자리도 되는지 확인.
+ * 입출력이 더 큰 채널 텐서의 구간인 batch 호출(conv2d_fused_slice_nchw_f32)도 같은 결과이고 구간 밖을 건드리지 않는지.
+ * SiLU EXACT / FAST 두 모드 모두. 가중치 파일 불필요. */
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "../csrc/operations/conv2d.h"
+#include "../csrc/operations/silu.h"
+#include "../csrc/operations/weight_pack.h"
+#include "test_util.h"
+
+#define C_IN  40   /* 3x3 K = 360 > GEMM KC(256): K 블록 부분합 경로 */
+#define C_OUT 36
+#define H     13
+#define W     11
+#define N     2
+#define XS_C  (C_IN + 3)    /* 구간 입력: XS_C 채널 텐서의 [1, 1 + C_IN) */
+#define YS_C  (C_OUT + 5)   /* 구간 출력: YS_C 채널 텐서의 [2, 2 + C_OUT) */
+#define SENTINEL 12345.0f
+
+static float x_buf[N * C_IN * H * W];
+static float res_buf[N * C_OUT * H * W];
+static int8_t w3_buf[C_OUT * C_IN * 9];
+static int8_t w1_buf[C_OUT * C_IN];
+static float bias_buf[C_OUT];
+static float y_ref[N * C_OUT * H * W];
+static float y_out[N * C_OUT * H * W];
+static float xs_buf[N * XS_C * H * W];
+static float ys_buf[N * YS_C * H * W];
+
+/* 채널 구간 배치: y_ref와 같은 값이고 구간 밖은 SENTINEL 그대로인지 */
+static int slice_matches(const float* ref) {
+    const int hw = H * W;
+    for (int b = 0; b < N; b++) {
+        for (int c = 0; c < YS_C; c++) {
+            const float* ys = ys_buf + ((size_t)b * YS_C + c) * hw;
+            const int in = c >= 2 && c < 2 + C_OUT;
+            if (in && memcmp(ys, ref + ((size_t)b * C_OUT + (c - 2)) * hw, (size_t)hw * sizeof(float)) != 0)
+                return 0;
+            for (int p = 0; !in && p < hw; p++)
+                if (ys[p] != SENTINEL) return 0;
+        }
+    }
+    return 1;
+}
+
+int main(void) {
+    test_seed(4242u);
+    printf("=== Conv Epilogue Test ===\n\n");
+
+    const float scale = 0.0091f;
+    const int total = N * C_OUT * H * W;
+    for (int i = 0; i < N * C_IN * H * W; i++) x_buf[i] = frand() * 3.0f;
+    for (int i = 0; i < total; i++) res_buf[i] = frand() * 2.0f;
+    for (int i = 0; i < C_OUT * C_IN * 9; i++) w3_buf[i] = (int8_t)(frand() * 127.0f);
+    for (int i = 0; i < C_OUT * C_IN; i++) w1_buf[i] = (int8_t)(frand() * 127.0f);
+    for (int i = 0; i < C_OUT; i++) bias_buf[i] = frand();
+    for (int i = 0; i < N * XS_C * H * W; i++) xs_buf[i] = SENTINEL;
+    for (int b = 0; b < N; b++)
+        memcpy(xs_buf + ((size_t)b * XS_C + 1) * H * W, x_buf + (size_t)b * C_IN * H * W,
+               (size_t)C_IN * H * W * sizeof(float));
+
+    tensor_info_t t[2] = {
+        { "model.0.conv.weight", NULL, w3_buf, scale, WEIGHTS_DTYPE_INT8, 4, { C_OUT, C_IN, 3, 3 }, 0, 0 },
+        { "model.1.conv.weight", NULL, w1_buf, scale, WEIGHTS_DTYPE_INT8, 4, { C_OUT, C_IN, 1, 1 }, 0, 0 },
+    };
+    weights_loader_t loader;
+    test_loader_init(&loader, t, 2);
+
+    static const struct { const char* name; conv2d_algo_t algo; } cases[] = {
+        { "DIRECT",   CONV2D_ALGO_DIRECT },
+        { "GEMM",     CONV2D_ALGO_GEMM },
+        { "WINOGRAD", CONV2D_ALGO_WINOGRAD },
+    };
+
+    int ok = 1;
+    for (int mode = SILU_EXACT; mode <= SILU_FAST; mode++) {
+    silu_set_mode((silu_mode_t)mode);
+    printf("  [SiLU %s]\n", mode == SILU_FAST ? "fast" : "exact");
+    for (unsigned c = 0; c < sizeof(cases) / sizeof(cases[0]); c++) {
+        conv2d_set_algo(cases[c].algo);
+        weight_pack_release();
+        if (weight_pack_prepare(&loader, conv2d_weight_pack_flags()) != 0) {
+            printf("  %s: weight_pack_prepare failed\n", cases[c].name);
+            return 1;
+        }
+        for (int k = 0; k < 2; k++) {
+            const int32_t ks = k == 0 ? 3 : 1, pad = k == 0 ? 1 : 0;
+            const int8_t* w = k == 0 ? w3_buf : w1_buf;
+
+            /* 3패스 reference: conv → SiLU → residual */
+            conv2d_nchw_f32_w8(x_buf, N, C_IN, H, W, w, scale, C_OUT, ks, ks, bias_buf,
+                               1, 1, pad, pad, 1, y_ref, H, W);
+            silu_nchw_f32(y_ref, N, C_OUT, H, W, y_ref);
+            for (int i = 0; i < total; i++) y_ref[i] = res_buf[i] + y_ref[i];
+
+            /* fused, residual == y (bottleneck 제자리 실행과 같은 조건) */
+            memcpy(y_out, res_buf, sizeof(y_out));
+            const conv2d_epilogue_t ep = { 1, y_out, 0 };
+            conv2d_fused_nchw_f32(x_buf, N, C_IN, H, W, w, scale, 1, C_OUT, ks, ks, bias_buf,
+                                  1, 1, pad, pad, &ep, y_out, H, W);
+            const int same = memcmp(y_out, y_ref, sizeof(y_out)) == 0;
+            printf("  %-8s %dx%d  SiLU+residual (in-place): %s\n", cases[c].name, ks, ks,
+                   same ? "bit-identical" : "MISMATCH");
+            ok &= same;
+
+            /* 같은 연산을 채널 구간 입출력으로 batch 한 번 (C3 concat 구간과 같은 조건, residual == y 제자리) */
+            for (int i = 0; i < N * YS_C * H * W; i++) ys_buf[i] = SENTINEL;
+            for (int b = 0; b < N; b++)
+                memcpy(ys_buf + ((size_t)b * YS_C + 2) * H * W, res_buf + (size_t)b * C_OUT * H * W,
+                       (size_t)C_OUT * H * W * sizeof(float));
+            const conv2d_epilogue_t ep_s = { 1, ys_buf + 2 * H * W, 0 };
+            conv2d_fused_slice_nchw_f32(xs_buf + H * W, XS_C, N, C_IN, H, W, w, scale, 1, C_OUT, ks, ks,
+                                        bias_buf, 1, 1, pad, pad, &ep_s, ys_buf + 2 * H * W, YS_C, H, W);
+            const int slice_same = slice_matches(y_ref);
+            printf("  %-8s %dx%d  channel-slice batch:      %s\n", cases[c].name, ks, ks,
+                   slice_same ? "bit-identical" : "MISMATCH");
+            ok &= slice_same;
+
+            /* SiLU만 */
+            conv2d_nchw_f32_w8(x_buf, N, C_IN, H, W, w, scale, C_OUT, ks, ks, bias_buf,
+                               1, 1, pad, pad, 1, y_ref, H, W);
+            silu_nchw_f32(y_ref, N, C_OUT, H, W, y_ref);
+            const conv2d_epilogue_t ep_silu = { 1, NULL, 0 };
+            conv2d_fused_nchw_f32(x_buf, N, C_IN, H, W, w, scale, 1, C_OUT, ks, ks, bias_buf,
+                                  1, 1, pad, pad, &ep_silu, y_out, H, W);
+            ok &= memcmp(y_out, y_ref, sizeof(y_out)) == 0;
+        }
+    }
+    }
+    weight_pack_release();
+
+    printf("\nResult: %s\n", ok ? "OK" : "NG");
+    return ok ? 0 : 1;
+}
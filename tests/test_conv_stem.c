@@ -0,0 +1,143 @@
+/* stem 커널 테스트: 6x6/s2 전용 커널(space-to-depth) == direct reference (누적 순서만 달라 허용 오차),
+ * 홀수 크기·strip 경계·oc 끝 블록·pad 0/2·batch 2, FP32/INT8 가중치, weight_pack stem 패널 + dispatch 경유
+ * = 직접 호출 (bit 단위, DIRECT는 reference라 direct 커널, 패널 없으면 GEMM),
+ * conv + SiLU + residual 한 패스 = 3패스 (bit 단위, residual == y 제자리). 가중치 파일 불필요. */
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <math.h>
+
+#include "../csrc/operations/conv2d.h"
+#include "../csrc/operations/conv2d_stem.h"
+#include "../csrc/operations/silu.h"
+#include "../csrc/operations/weight_pack.h"
+#include "test_util.h"
+
+#define N      2
+#define C_MAX  4
+#define OC_MAX 18
+#define H_MAX  41
+#define W_MAX  (4 * CONV2D_STEM_TW + 19)   /* 출력 열 = strip 2개 + 나머지 */
+#define STEM_TOL 1e-4f
+
+static float x_buf[N * C_MAX * H_MAX * W_MAX];
+static float wf_buf[OC_MAX * C_MAX * 36];
+static int8_t wi_buf[OC_MAX * C_MAX * 36];
+static float bias_buf[OC_MAX];
+static float stem_w[(OC_MAX + 3) / 4 * 4 * C_MAX * 36];   /* conv2d_stem_pack_weights 패널 */
+static float res_buf[N * OC_MAX * H_MAX * W_MAX];
+static float y_ref[N * OC_MAX * H_MAX * W_MAX];
+static float y_out[N * OC_MAX * H_MAX * W_MAX];
+
+int main(void) {
+    test_seed(2024u);
+    printf("=== Conv Stem Kernel Test ===\n\n");
+    int ok = 1;
+    const float scale = 0.0123f;
+
+    for (int i = 0; i < N * C_MAX * H_MAX * W_MAX; i++) x_buf[i] = frand() * 2.0f;
+    for (int i = 0; i < OC_MAX * C_MAX * 36; i++) {
+        wf_buf[i] = frand() * 0.5f;
+        wi_buf[i] = (int8_t)(frand() * 127.0f);
+    }
+    for (int i = 0; i < OC_MAX; i++) bias_buf[i] = frand();
+    for (int i = 0; i < N * OC_MAX * H_MAX * W_MAX; i++) res_buf[i] = frand();
+
+    /* 1) 지원 shape */
+    const int sup = conv2d_stem_supported(3, 16, 6, 6, 2, 2, 2, 2) && conv2d_stem_supported(1, 18, 6, 6, 2, 2, 0, 0) &&
+                    !conv2d_stem_supported(3, 16, 3, 3, 2, 2, 1, 1) && !conv2d_stem_supported(3, 16, 6, 6, 1, 1, 2, 2) &&
+                    !conv2d_stem_supported(3, 16, 6, 6, 2, 2, 2, 1) &&
+                    !conv2d_stem_supported(CONV2D_STEM_MAX_C + 1, 16, 6, 6, 2, 2, 2, 2);
+    printf("  supported shapes: %s\n", sup ? "OK" : "NG");
+    ok &= sup;
+
+    /* 2) stem == direct (c_in, c_out, h_in, w_in, pad) */
+    static const struct { int32_t c, oc, h, w, pad; } cases[] = {
+        { 3, 16, 40, 2 * CONV2D_STEM_TW * 2, 2 },   /* YOLOv5 L0 비율, strip 정확히 2개 */
+        { 3, 16, H_MAX, W_MAX, 2 },                /* 홀수 크기, 마지막 strip 부분 */
+        { 1, 18, 17, 23, 0 },                      /* oc 끝 블록 2채널, pad 0 */
+        { C_MAX, 5, 9, 13, 4 },                    /* 출력보다 큰 pad 비율 */
+    };
+    for (unsigned c = 0; c < sizeof(cases) / sizeof(cases[0]); c++) {
+        const int32_t ci = cases[c].c, oc = cases[c].oc, hi = cases[c].h, wi = cases[c].w, p = cases[c].pad;
+        const int32_t ho = (hi + 2 * p - 6) / 2 + 1, wo = (wi + 2 * p - 6) / 2 + 1;
+        const int count = N * oc * ho * wo;
+        for (int q = 0; q < 2; q++) {
+            if (q)
+                conv2d_direct_nchw_f32_w8(x_buf, N, ci, hi, wi, wi_buf, scale, oc, 6, 6, bias_buf, 2, 2, p, p, 1,
+                                          y_ref, ho, wo);
+            else
+                conv2d_direct_nchw_f32(x_buf, N, ci, hi, wi, wf_buf, oc, 6, 6, bias_buf, 2, 2, p, p, 1, y_ref, ho, wo);
+            memset(y_out, 0, sizeof(y_out));
+            conv2d_stem_pack_weights(q ? (const void*)wi_buf : (const void*)wf_buf, scale, q, oc, ci, stem_w);
+            conv2d_stem_nchw_f32(x_buf, N, ci, hi, wi, stem_w, oc, bias_buf, p, p, NULL, y_out, ho, wo);
+            const float d = max_rel_diff(y_ref, y_out, count);
+            const int pass = d < STEM_TOL;
+            printf("  c%d->%d %dx%d p%d %s: max rel diff %.3g %s\n", (int)ci, (int)oc, (int)hi, (int)wi, (int)p,
+                   q ? "w8 " : "f32", d, pass ? "OK" : "NG");
+            ok &= pass;
+        }
+    }
+
+    /* 3) dispatch 경유 (weight_pack 적용): GEMM/WINOGRAD == stem 직접 호출, DIRECT(reference) == direct 커널,
+     *    bit 단위. stem 패널이 없으면 GEMM 경로 (허용 오차) */
+    {
+        const int32_t ho = (H_MAX + 4 - 6) / 2 + 1, wo = (W_MAX + 4 - 6) / 2 + 1;
+        const size_t bytes = (size_t)N * 16 * ho * wo * sizeof(float);
+        tensor_info_t t[1] = {
+            { "model.0.conv.weight", NULL, wi_buf, scale, WEIGHTS_DTYPE_INT8, 4, { 16, 3, 6, 6 }, 0, 0 },
+        };
+        weights_loader_t loader;
+        test_loader_init(&loader, t, 1);
+        conv2d_stem_pack_weights(wi_buf, scale, 1, 16, 3, stem_w);
+        int same = 1;
+        for (int algo = CONV2D_ALGO_DIRECT; algo <= CONV2D_ALGO_WINOGRAD; algo++) {
+            if (algo == CONV2D_ALGO_DIRECT)
+                conv2d_direct_nchw_f32_w8(x_buf, N, 3, H_MAX, W_MAX, wi_buf, scale, 16, 6, 6, bias_buf, 2, 2, 2, 2, 1,
+                                          y_ref, ho, wo);
+            else
+                conv2d_stem_nchw_f32(x_buf, N, 3, H_MAX, W_MAX, stem_w, 16, bias_buf, 2, 2, NULL, y_ref, ho, wo);
+            conv2d_set_algo((conv2d_algo_t)algo);
+            if (weight_pack_prepare(&loader, conv2d_weight_pack_flags()) != 0) same = 0;
+            const weight_pack_t* pk = weight_pack_find(wi_buf);
+            if ((pk && pk->stem) != (algo != CONV2D_ALGO_DIRECT)) same = 0;   /* stem 패널은 PANEL(GEMM/WINOGRAD)만 */
+            memset(y_out, 0, sizeof(y_out));
+            conv2d_nchw_f32_w8(x_buf, N, 3, H_MAX, W_MAX, wi_buf, scale, 16, 6, 6, bias_buf, 2, 2, 2, 2, 1,
+                               y_out, ho, wo);
+            same &= memcmp(y_ref, y_out, bytes) == 0;
+        }
+        printf("  dispatch (direct -> direct, gemm/winograd -> stem): %s\n", same ? "OK" : "NG");
+        ok &= same;
+
+        conv2d_set_algo(CONV2D_ALGO_GEMM);
+        weight_pack_release();
+        conv2d_nchw_f32_w8(x_buf, N, 3, H_MAX, W_MAX, wi_buf, scale, 16, 6, 6, bias_buf, 2, 2, 2, 2, 1,
+                           y_out, ho, wo);
+        const float d_unpacked = max_rel_diff(y_ref, y_out, N * 16 * ho * wo);
+        printf("  unpacked gemm fallback: max rel diff %.3g %s\n", d_unpacked, d_unpacked < STEM_TOL ? "OK" : "NG");
+        ok &= d_unpacked < STEM_TOL;
+        (void)weight_pack_prepare(&loader, conv2d_weight_pack_flags());
+
+        /* 4) epilogue: conv → SiLU → residual 3패스 == 한 패스 (residual == y) */
+        /* GEMM + stem 패널 (위에서 prepare) → stem 경로 */
+        for (int mode = SILU_EXACT; mode <= SILU_FAST; mode++) {
+            silu_set_mode((silu_mode_t)mode);
+            const int count = N * 16 * ho * wo;
+            conv2d_stem_nchw_f32(x_buf, N, 3, H_MAX, W_MAX, stem_w, 16, bias_buf, 2, 2, NULL, y_ref, ho, wo);
+            silu_nchw_f32(y_ref, N, 16, ho, wo, y_ref);
+            for (int i = 0; i < count; i++) y_ref[i] = res_buf[i] + y_ref[i];
+            memcpy(y_out, res_buf, (size_t)count * sizeof(float));
+            const conv2d_epilogue_t ep = { 1, y_out, 0 };
+            conv2d_fused_nchw_f32(x_buf, N, 3, H_MAX, W_MAX, wi_buf, scale, 1, 16, 6, 6, bias_buf, 2, 2, 2, 2, &ep,
+                                  y_out, ho, wo);
+            const int fused = memcmp(y_ref, y_out, (size_t)count * sizeof(float)) == 0;
+            printf("  fused SiLU %s + residual: %s\n", mode == SILU_FAST ? "fast " : "exact", fused ? "OK" : "NG");
+            ok &= fused;
+        }
+        silu_set_mode(SILU_EXACT);
+        weight_pack_release();
+    }
+
+    printf("\nResult: %s\n", ok ? "OK" : "NG");
+    return ok ? 0 : 1;
+}
@@ -1,11 +1,103 @@
-/* Decode 블록 테스트 (255ch → bbox). */
+/* Decode 블록 테스트 (255ch → bbox). 조기 탈락(logit 컷) 경로가 전체 sigmoid 계산과
+ * 같은 검출 목록을 내는지 무작위 logit으로도 확인. */
 #include <stdio.h>
+#include <string.h>
 #include <math.h>
 
 #include "test_vectors_decode.h"
 #include "../csrc/blocks/decode.h"
+#include "test_util.h"
+
+/* 조기 탈락 전 decode (모든 anchor × 80클래스 sigmoid) — bit-identical 비교 기준 */
+static float ref_sigmoid(float x) { return 1.0f / (1.0f + expf(-x)); }
+
+static int32_t ref_decode(const float* const feats[3], const int32_t gh_[3], const int32_t gw_[3],
+                          int32_t num_classes, float conf_threshold, int32_t input_size,
+                          const float strides[3], const float anchors[3][6],
+                          detection_t* dets, int32_t max_dets) {
+    int32_t count = 0;
+    const int32_t no = 5 + num_classes;
+    for (int s = 0; s < 3; s++) {
+        const float* feat = feats[s];
+        const int32_t gsize = gh_[s] * gw_[s];
+        for (int32_t y = 0; y < gh_[s]; y++) {
+            for (int32_t x = 0; x < gw_[s]; x++) {
+                for (int a = 0; a < 3; a++) {
+                    const int32_t base = (a * no) * gsize + y * gw_[s] + x;
+                    float obj_conf = ref_sigmoid(feat[base + 4 * gsize]);
+                    float max_cls = 0.0f;
+                    int32_t max_cls_id = 0;
+                    for (int c = 0; c < num_classes; c++) {
+                        float v = ref_sigmoid(feat[base + (5 + c) * gsize]);
+                        if (v > max_cls) { max_cls = v; max_cls_id = c; }
+                    }
+                    float conf = obj_conf * max_cls;
+                    if (conf < conf_threshold) continue;
+                    if (count >= max_dets) return count;
+                    float tx = ref_sigmoid(feat[base]), ty = ref_sigmoid(feat[base + gsize]);
+                    float tw = ref_sigmoid(feat[base + 2 * gsize]), th = ref_sigmoid(feat[base + 3 * gsize]);
+                    float cx = (tx * 2.0f + ((float)x - 0.5f)) * strides[s];
+                    float cy = (ty * 2.0f + ((float)y - 0.5f)) * strides[s];
+                    float ww = (tw * 2.0f) * (tw * 2.0f) * anchors[s][a * 2 + 0];
+                    float hh = (th * 2.0f) * (th * 2.0f) * anchors[s][a * 2 + 1];
+                    dets[count].x = cx / (float)input_size;
+                    dets[count].y = cy / (float)input_size;
+                    dets[count].w = ww / (float)input_size;
+                    dets[count].h = hh / (float)input_size;
+                    dets[count].conf = conf;
+                    dets[count].cls_id = max_cls_id;
+                    count++;
+                }
+            }
+        }
+    }
+    return count;
+}
+
+#define RND_NC 80
+#define RND_CH (3 * (5 + RND_NC))
+static float rnd_p3[RND_CH * 20 * 20];
+static float rnd_p4[RND_CH * 10 * 10];
+static float rnd_p5[RND_CH * 5 * 5];
+static detection_t rnd_ref[2000];
+static detection_t rnd_out[2000];
+
+/* 무작위 logit (임계값 근처 obj/클래스 logit 포함) 여러 임계값에서 검출 목록 memcmp */
+static int check_prefilter(const float strides[3], const float anchors[3][6]) {
+    static const float thrs[] = { 0.001f, 0.25f, 0.5f, 0.9f, 0.995f };
+    float* const feats[3] = { rnd_p3, rnd_p4, rnd_p5 };
+    const int32_t gh_[3] = { 20, 10, 5 }, gw_[3] = { 20, 10, 5 };
+    const size_t sizes[3] = { sizeof(rnd_p3), sizeof(rnd_p4), sizeof(rnd_p5) };
+    int ok = 1;
+    for (unsigned t = 0; t < sizeof(thrs) / sizeof(thrs[0]); t++) {
+        const float thr = thrs[t];
+        const float lthr = logf(thr / (1.0f - thr));
+        for (int s = 0; s < 3; s++) {
+            const int32_t n = (int32_t)(sizes[s] / sizeof(float));
+            for (int32_t i = 0; i < n; i++) feats[s][i] = frand01() * 16.0f - 10.0f;
+            /* 일부 obj logit을 logit(thr) ± 수 ulp에 (컷 경계) */
+            const int32_t gsize = gh_[s] * gw_[s];
+            for (int a = 0; a < 3; a++) {
+                for (int32_t k = 0; k < gsize; k += 3) {
+                    float* o = &feats[s][(a * (5 + RND_NC) + 4) * gsize + k];
+                    *o = lthr + (frand01() - 0.5f) * 1e-5f * (1.0f + fabsf(lthr));
+                    feats[s][(a * (5 + RND_NC) + 5 + k % RND_NC) * gsize + k] = 12.0f;
+                }
+            }
+        }
+        const int32_t n_ref = ref_decode((const float* const*)feats, gh_, gw_, RND_NC, thr, 640,
+                                         strides, anchors, rnd_ref, 2000);
+        const int32_t n_out = decode_nchw_f32(rnd_p3, 20, 20, rnd_p4, 10, 10, rnd_p5, 5, 5, RND_NC, thr, 640,
+                                              strides, anchors, rnd_out, 2000);
+        const int same = n_ref == n_out && memcmp(rnd_ref, rnd_out, (size_t)n_ref * sizeof(detection_t)) == 0;
+        printf("  prefilter thr=%.3f: %d dets, %s\n", thr, (int)n_out, same ? "identical" : "MISMATCH");
+        ok &= same;
+    }
+    return ok;
+}
 
 int main(void) {
+    test_seed(777u);
     printf("=== Decode Block Test (Anchor-based) ===\n\n");
     
     // 앵커 및 stride 설정
@@ -80,6 +172,10 @@ int main(void) {
         }
     }
     
+    // 3. 조기 탈락 경로 == 전체 계산
+    ok &= check_prefilter(strides, anchors);
+    printf("\n");
+
     if (ok) {
         printf("Result: OK (decode completed successfully)\n");
         return 0;
@@ -48,7 +48,7 @@ int main(void) {
     static float p5_out[255 * 20 * 20];
     
     // Detect Head 실행 (FP32 가중치: scale=0, is_int8=0)
-    detect_nchw_f32(
+    detect_nchw_f32(1,
         tv_detect_p3, TV_DETECT_P3_C, TV_DETECT_P3_H, TV_DETECT_P3_W,
         tv_detect_p4, TV_DETECT_P4_C, TV_DETECT_P4_H, TV_DETECT_P4_W,
         tv_detect_p5, TV_DETECT_P5_C, TV_DETECT_P5_H, TV_DETECT_P5_W,
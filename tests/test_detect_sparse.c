@@ -0,0 +1,105 @@
+/* Sparse Detect head 테스트: detect_decode_sparse_nchw_f32가 dense head(detect_nchw_f32) + decode_nchw_f32와
+ * 같은 검출 목록을 내는지 무작위 입력·INT8/FP32 가중치, 여러 임계값으로 확인.
+ * W8 + 1x1 SIMD 빌드는 bit-identical, 그 외(스칼라 빌드, FP32 가중치의 dense GEMM 경로)는 누적 순서가 달라
+ * 개수·클래스 동일 + conf/box 1e-5 이내. 가중치 파일 불필요. */
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <math.h>
+
+#include "../csrc/blocks/detect.h"
+#include "../csrc/blocks/decode.h"
+#include "../csrc/operations/conv2d_1x1.h"
+#include "test_util.h"
+
+#define NC   80
+#define NO   (3 * (5 + NC))
+#define MAXD 2000
+
+static const int32_t C[3] = { 16, 32, 64 };
+static const int32_t G[3] = { 16, 8, 4 };   /* 격자 한 변 */
+
+static float x3[16 * 16 * 16], x4[32 * 8 * 8], x5[64 * 4 * 4];
+static float o3[NO * 16 * 16], o4[NO * 8 * 8], o5[NO * 4 * 4];
+static int8_t w8[3][NO * 64];
+static float wf[3][NO * 64];
+static float bias[3][NO];
+static detection_t d_ref[MAXD], d_out[MAXD];
+
+static int same_dets(const detection_t* a, const detection_t* b, int32_t n, int exact) {
+    if (exact) return memcmp(a, b, (size_t)n * sizeof(detection_t)) == 0;
+    for (int32_t i = 0; i < n; i++) {
+        if (a[i].cls_id != b[i].cls_id || fabsf(a[i].conf - b[i].conf) > 1e-5f ||
+            fabsf(a[i].x - b[i].x) > 1e-5f || fabsf(a[i].y - b[i].y) > 1e-5f ||
+            fabsf(a[i].w - b[i].w) > 1e-5f || fabsf(a[i].h - b[i].h) > 1e-5f)
+            return 0;
+    }
+    return 1;
+}
+
+int main(void) {
+    test_seed(2024u);
+    printf("=== Sparse Detect Head Test (%s) ===\n\n", CONV2D_1X1_ISA);
+    static const float strides[3] = { 8.0f, 16.0f, 32.0f };
+    static const float anchors[3][6] = {
+        { 10.0f, 13.0f, 16.0f, 30.0f, 33.0f, 23.0f },
+        { 30.0f, 61.0f, 62.0f, 45.0f, 59.0f, 119.0f },
+        { 116.0f, 90.0f, 156.0f, 198.0f, 373.0f, 326.0f }
+    };
+    float* const xs[3] = { x3, x4, x5 };
+    const float scale = 0.02f;
+
+    for (int s = 0; s < 3; s++) {
+        for (int32_t i = 0; i < C[s] * G[s] * G[s]; i++) xs[s][i] = frand() * 2.0f;
+        for (int32_t i = 0; i < NO * C[s]; i++) {
+            w8[s][i] = (int8_t)(frand() * 127.0f);
+            wf[s][i] = (float)w8[s][i] * scale;
+        }
+        /* obj bias를 anchor마다 다르게 → 통과 비율이 스케일·anchor별로 다름 */
+        for (int32_t oc = 0; oc < NO; oc++) bias[s][oc] = frand() + ((oc % 85) == 4 ? (float)(oc / 85) - 1.0f : 0.0f);
+    }
+
+    static const float thrs[] = { 0.05f, 0.25f, 0.5f };
+    int ok = 1;
+    for (int fp = 0; fp < 2; fp++) {
+        const void* w[3] = { fp ? (const void*)wf[0] : w8[0], fp ? (const void*)wf[1] : w8[1],
+                             fp ? (const void*)wf[2] : w8[2] };
+        const float sc = fp ? 1.0f : scale;
+        const int is_int8 = !fp;
+        for (unsigned t = 0; t < sizeof(thrs) / sizeof(thrs[0]); t++) {
+            detect_nchw_f32(1, x3, C[0], G[0], G[0], x4, C[1], G[1], G[1], x5, C[2], G[2], G[2],
+                            w[0], sc, is_int8, bias[0], w[1], sc, is_int8, bias[1], w[2], sc, is_int8, bias[2],
+                            o3, o4, o5);
+            const int32_t n_ref = decode_nchw_f32(o3, G[0], G[0], o4, G[1], G[1], o5, G[2], G[2], NC, thrs[t], 640,
+                                                  strides, anchors, d_ref, MAXD);
+            const int32_t n_out = detect_decode_sparse_nchw_f32(
+                x3, C[0], G[0], G[0], x4, C[1], G[1], G[1], x5, C[2], G[2], G[2],
+                w[0], sc, is_int8, bias[0], w[1], sc, is_int8, bias[1], w[2], sc, is_int8, bias[2],
+                NC, thrs[t], 640, strides, anchors, d_out, MAXD);
+            const int same = n_ref == n_out && same_dets(d_ref, d_out, n_ref, !fp && CONV2D_1X1_SIMD);
+            printf("  %s thr=%.2f: dense %d / sparse %d dets, %s\n", fp ? "FP32" : "W8  ", thrs[t],
+                   (int)n_ref, (int)n_out, same ? "same" : "MISMATCH");
+            ok &= same;
+        }
+    }
+
+    /* max_detections 절단 위치도 같음 */
+    detect_nchw_f32(1, x3, C[0], G[0], G[0], x4, C[1], G[1], G[1], x5, C[2], G[2], G[2],
+                    w8[0], scale, 1, bias[0], w8[1], scale, 1, bias[1], w8[2], scale, 1, bias[2], o3, o4, o5);
+    const int32_t n_ref = decode_nchw_f32(o3, G[0], G[0], o4, G[1], G[1], o5, G[2], G[2], NC, 0.05f, 640,
+                                          strides, anchors, d_ref, 7);
+    const int32_t n_out = detect_decode_sparse_nchw_f32(
+        x3, C[0], G[0], G[0], x4, C[1], G[1], G[1], x5, C[2], G[2], G[2],
+        w8[0], scale, 1, bias[0], w8[1], scale, 1, bias[1], w8[2], scale, 1, bias[2],
+        NC, 0.05f, 640, strides, anchors, d_out, 7);
+    ok &= n_ref == 7 && n_out == 7 && same_dets(d_ref, d_out, 7, CONV2D_1X1_SIMD);
+    printf("  max_detections=7: %s\n", (n_out == 7 && same_dets(d_ref, d_out, 7, CONV2D_1X1_SIMD)) ? "same" : "MISMATCH");
+
+    /* 한도 초과는 -1 */
+    ok &= detect_decode_sparse_nchw_f32(x3, DETECT_SPARSE_MAX_C + 1, G[0], G[0], x4, C[1], G[1], G[1],
+                                        x5, C[2], G[2], G[2], w8[0], scale, 1, bias[0], w8[1], scale, 1, bias[1],
+                                        w8[2], scale, 1, bias[2], NC, 0.25f, 640, strides, anchors, d_out, MAXD) == -1;
+
+    printf("\nResult: %s\n", ok ? "OK" : "NG");
+    return ok ? 0 : 1;
+}
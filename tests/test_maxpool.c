@@ -0,0 +1,81 @@
+/* maxpool 테스트: 분리형 sliding window 경로(stride 1, same 크기)가 k×k 직접 계산과 같은지,
+ * 그 외 stride/pad는 직접 경로, SPPF 3단 한 패스 = maxpool 3회 (concat 배치, batch 2). 파일 불필요. */
+#include <stdio.h>
+#include <stdint.h>
+
+#include "../csrc/operations/maxpool2d.h"
+#include "test_util.h"
+
+#define MAX_ELEMS (2 * 4 * 8 * 23 * 21)
+
+static float x_buf[MAX_ELEMS];
+static float y_out[MAX_ELEMS];
+static float y_ref[MAX_ELEMS];
+
+/* 기준: 창 안의 유효 입력만 보는 k×k 최댓값 */
+static void ref_pool(const float* x, int32_t planes, int32_t h, int32_t w, int32_t k, int32_t stride,
+                     int32_t pad, float* y, int32_t oh_n, int32_t ow_n) {
+    for (int32_t p = 0; p < planes; p++)
+        for (int32_t oh = 0; oh < oh_n; oh++)
+            for (int32_t ow = 0; ow < ow_n; ow++) {
+                float m = -3.402823466e+38f;
+                for (int32_t kh = 0; kh < k; kh++)
+                    for (int32_t kw = 0; kw < k; kw++) {
+                        const int32_t ih = oh * stride - pad + kh, iw = ow * stride - pad + kw;
+                        if (ih < 0 || ih >= h || iw < 0 || iw >= w) continue;
+                        if (x[(p * h + ih) * w + iw] > m) m = x[(p * h + ih) * w + iw];
+                    }
+                y[(p * oh_n + oh) * ow_n + ow] = m;
+            }
+}
+
+static int same(const float* a, const float* b, int32_t count) {
+    for (int32_t i = 0; i < count; i++)
+        if (a[i] != b[i]) return 0;
+    return 1;
+}
+
+int main(void) {
+    test_seed(777u);
+    printf("=== MaxPool Test ===\n\n");
+    int ok = 1;
+    for (int i = 0; i < MAX_ELEMS; i++) x_buf[i] = frand();
+
+    static const struct { int32_t h, w, k, stride, pad; } cases[] = {
+        { 20, 20, 5, 1, 2 },   /* SPPF */
+        { 13, 7, 3, 1, 1 },
+        { 9, 11, 5, 1, 2 },
+        { 3, 4, 7, 1, 3 },     /* 창 > 입력 */
+        { 1, 1, 5, 1, 2 },
+        { 23, 21, 9, 1, 4 },
+        { 12, 10, 2, 2, 0 },   /* 직접 경로 */
+        { 11, 9, 3, 2, 1 },
+    };
+    for (unsigned c = 0; c < sizeof(cases) / sizeof(cases[0]); c++) {
+        const int32_t h = cases[c].h, w = cases[c].w, k = cases[c].k, s = cases[c].stride, pad = cases[c].pad;
+        const int32_t oh = (h + 2 * pad - k) / s + 1, ow = (w + 2 * pad - k) / s + 1;
+        ref_pool(x_buf, 2 * 8, h, w, k, s, pad, y_ref, oh, ow);
+        maxpool2d_nchw_f32(x_buf, 2, 8, h, w, k, s, pad, y_out, oh, ow);
+        const int eq = same(y_out, y_ref, 2 * 8 * oh * ow);
+        printf("  %2dx%-2d k%d s%d p%d: %s\n", (int)h, (int)w, (int)k, (int)s, (int)pad, eq ? "match" : "MISMATCH");
+        ok &= eq;
+    }
+
+    /* SPPF: concat [x1 | y1 | y2 | y3] x 2장, 3단 한 패스 = 3회 호출 */
+    {
+        const int32_t n = 2, c = 8, h = 20, w = 20, k = 5;
+        const size_t plane = (size_t)c * h * w, img = 4 * plane;
+        for (int32_t b = 0; b < n; b++)
+            for (size_t i = 0; i < plane; i++) y_out[b * img + i] = y_ref[b * img + i] = frand();
+        for (int32_t b = 0; b < n; b++)
+            for (int32_t s = 0; s < 3; s++)
+                ref_pool(y_ref + b * img + s * plane, c, h, w, k, 1, k / 2, y_ref + b * img + (s + 1) * plane, h, w);
+        maxpool2d_sppf_nchw_f32(y_out, n, c, h, w, k, y_out + plane, y_out + 2 * plane, y_out + 3 * plane, img);
+        const int eq = same(y_out, y_ref, (int32_t)(n * img));
+        printf("  SPPF cascade (batch 2): %s\n", eq ? "match" : "MISMATCH");
+        ok &= eq;
+    }
+
+    printf("\nResult: %s\n", ok ? "OK" : "NG");
+    return ok ? 0 : 1;
+}
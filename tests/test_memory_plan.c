@@ -0,0 +1,85 @@
+/* 정적 메모리 플래너 테스트: 수명이 겹치는 버퍼끼리 주소가 겹치지 않는지, 정렬,
+ * 하한 이상인지, 단순 체인에서 최적(2버퍼)인지, 세션 수명표에서 Detect 입력이 읽는 step까지 사는지 확인. 파일 불필요. */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../csrc/utils/memory_plan.h"
+#include "../csrc/yolo_session.h"
+
+static int check_plan(const memory_plan_buf_t* b, int32_t count, size_t peak, size_t lower) {
+    int ok = peak >= lower;
+    for (int32_t i = 0; i < count; i++) {
+        ok &= b[i].offset % MEMORY_PLAN_ALIGN == 0;
+        ok &= b[i].offset + b[i].size <= peak;
+        for (int32_t j = i + 1; j < count; j++) {
+            if (b[i].size == 0 || b[j].size == 0) continue;
+            const int live = b[i].first <= b[j].last && b[j].first <= b[i].last;
+            const int mem = b[i].offset < b[j].offset + b[j].size && b[j].offset < b[i].offset + b[i].size;
+            if (live && mem) {
+                printf("  conflict %d/%d\n", (int)i, (int)j);
+                ok = 0;
+            }
+        }
+    }
+    return ok;
+}
+
+int main(void) {
+    printf("=== Memory Plan Test ===\n\n");
+    int ok = 1;
+
+    /* 체인 a→b→c→d (같은 크기): 두 칸 번갈아 사용 */
+    memory_plan_buf_t chain[4];
+    for (int i = 0; i < 4; i++) {
+        chain[i].name = "chain";
+        chain[i].size = 1000;
+        chain[i].first = i;
+        chain[i].last = i + 1;
+    }
+    size_t lower = 0;
+    size_t peak = memory_plan_solve(chain, 4, &lower);
+    ok &= check_plan(chain, 4, peak, lower) && peak == 2 * 1024 && lower == 2 * 1024;
+    printf("  chain: peak %u, lower bound %u\n", (unsigned)peak, (unsigned)lower);
+
+    /* 무작위 수명/크기 (skip 연결처럼 긴 수명 섞음) */
+    srand(1234);
+    for (int trial = 0; trial < 200 && ok; trial++) {
+        memory_plan_buf_t b[MEMORY_PLAN_MAX_BUFS];
+        const int32_t count = 1 + rand() % MEMORY_PLAN_MAX_BUFS;
+        for (int32_t i = 0; i < count; i++) {
+            b[i].name = "rand";
+            b[i].size = (rand() % 8 == 0) ? 0 : (size_t)(1 + rand() % 100000);
+            b[i].first = rand() % 30;
+            b[i].last = b[i].first + ((rand() % 4 == 0) ? rand() % 15 : rand() % 2);
+        }
+        peak = memory_plan_solve(b, count, &lower);
+        ok &= check_plan(b, count, peak, lower);
+    }
+    printf("  random: %s\n", ok ? "no overlap" : "FAIL");
+
+    /* 세션 수명표: Detect 입력 L17/L20/L23은 head를 읽는 마지막 step까지 (dense 24, sparse는 decode 25) */
+    for (int sparse = 0; sparse <= 1; sparse++) {
+        for (int32_t nb = 1; nb <= 2; nb++) {
+            memory_plan_buf_t b[MEMORY_PLAN_MAX_BUFS];
+            const int32_t count = yolo_session_plan_buffers(nb, sparse, b);
+            int live = 0;
+            for (int32_t i = 0; i < count; i++) {
+                if (strcmp(b[i].name, "BUF_L17") == 0 || strcmp(b[i].name, "BUF_L20") == 0 ||
+                    strcmp(b[i].name, "BUF_L23") == 0)
+                    live += b[i].last >= (sparse ? 25 : 24);
+            }
+            peak = memory_plan_solve(b, count, &lower);
+            const int sess_ok = live == 3 && peak > 0 && check_plan(b, count, peak, lower);
+            printf("  session %s batch %d: %s\n", sparse ? "sparse" : "dense ", (int)nb,
+                   sess_ok ? "head inputs live through their last read" : "FAIL");
+            ok &= sess_ok;
+        }
+    }
+
+    ok &= memory_plan_solve(chain, 0, NULL) == 0;
+    ok &= memory_plan_solve(chain, MEMORY_PLAN_MAX_BUFS + 1, NULL) == 0;
+
+    printf("\nResult: %s\n", ok ? "OK" : "NG");
+    return ok ? 0 : 1;
+}
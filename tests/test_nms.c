@@ -5,14 +5,75 @@
 
 #include "test_vectors_nms.h"
 #include "../csrc/blocks/nms.h"
+#include "test_util.h"
 
-static float max_abs_diff(const float* a, const float* b, int n) {
-    float m = 0.0f;
-    for (int i = 0; i < n; i++) {
-        float d = fabsf(a[i] - b[i]);
-        if (d > m) m = d;
+/* 후처리 엔진 (nms_sort_by_conf + nms_sorted) == 삽입 정렬(안정) + nms(): 무작위 밀집 장면,
+ * conf 동점, 여러 IoU 임계값(음수 포함)·max 값 */
+static int check_engine(void) {
+    enum { MAXN = 300 };
+    static detection_t in[MAXN], ref_sorted[MAXN], out[MAXN];
+    static unsigned char scratch[64 * MAXN + 1024];
+    static const float ious[] = { 0.45f, 0.0f, 0.7f, -1.0f };
+    int ok = nms_scratch_bytes(MAXN) <= sizeof(scratch);
+    for (int trial = 0; trial < 200 && ok; trial++) {
+        const int32_t n = 1 + (int32_t)(frand01() * (MAXN - 1));
+        const int32_t ncls = 1 + (int32_t)(frand01() * 6);
+        for (int32_t i = 0; i < n; i++) {
+            in[i].x = 0.3f + frand01() * 0.4f;
+            in[i].y = 0.3f + frand01() * 0.4f;
+            in[i].w = frand01() * 0.3f;
+            in[i].h = frand01() * 0.3f;
+            in[i].conf = (float)(int)(frand01() * 20.0f) / 20.0f;   /* 동점 많음 */
+            in[i].cls_id = (int32_t)(frand01() * ncls);
+        }
+        /* 정렬: 안정 삽입 정렬과 같아야 함 */
+        memcpy(ref_sorted, in, (size_t)n * sizeof(detection_t));
+        for (int32_t i = 1; i < n; i++) {
+            detection_t t = ref_sorted[i];
+            int32_t j = i;
+            while (j > 0 && ref_sorted[j - 1].conf < t.conf) { ref_sorted[j] = ref_sorted[j - 1]; j--; }
+            ref_sorted[j] = t;
+        }
+        nms_sort_by_conf(in, n, scratch);
+        ok &= memcmp(in, ref_sorted, (size_t)n * sizeof(detection_t)) == 0;
+
+        const float thr = ious[trial % 4];
+        const int32_t max_out = (trial % 3 == 0) ? 1 + (int32_t)(frand01() * 20) : MAXN;
+        detection_t* ref = NULL;
+        int32_t ref_n = 0;
+        nms(in, n, &ref, &ref_n, thr, max_out);
+        const int32_t got = nms_sorted(in, n, thr, out, max_out, scratch, sizeof(scratch));
+        ok &= got == ref_n && (ref_n == 0 || memcmp(out, ref, (size_t)ref_n * sizeof(detection_t)) == 0);
+        free(ref);
+    }
+    ok &= nms_sorted(in, 10, 0.45f, out, MAXN, scratch, 16) == -1;   /* scratch 부족 */
+    ok &= nms_sorted(in, 0, 0.45f, out, MAXN, NULL, 0) == 0;
+    return ok;
+}
+
+/* conf 동점 순서: 세션의 이전 교환 정렬(i < j 비교 후 swap)은 동점을 섞었고 nms_sort_by_conf는 decode 순서 유지.
+ * [A 0.5, B 0.5, C 0.9] → 교환 정렬 [C, B, A], 엔진 [C, A, B]. 같은 클래스로 겹치면 NMS에서 남는 쪽도 A (의도된 변경) */
+static int check_tie_order(void) {
+    detection_t old_sorted[3] = {
+        { 0.50f, 0.50f, 0.2f, 0.2f, 0.5f, 0 },   /* A */
+        { 0.51f, 0.50f, 0.2f, 0.2f, 0.5f, 0 },   /* B: A와 겹침 */
+        { 0.10f, 0.10f, 0.1f, 0.1f, 0.9f, 1 },   /* C */
+    };
+    detection_t in[3], out[3];
+    static unsigned char scratch[4096];
+    memcpy(in, old_sorted, sizeof(in));
+    for (int i = 0; i < 2; i++) {
+        for (int j = i + 1; j < 3; j++) {
+            if (old_sorted[i].conf < old_sorted[j].conf) {
+                detection_t t = old_sorted[i]; old_sorted[i] = old_sorted[j]; old_sorted[j] = t;
+            }
+        }
     }
-    return m;
+    nms_sort_by_conf(in, 3, scratch);
+    const int32_t n = nms_sorted(in, 3, 0.45f, out, 3, scratch, sizeof(scratch));
+    return old_sorted[1].x == 0.51f && old_sorted[2].x == 0.50f &&     /* 교환 정렬: B가 A 앞 */
+           in[0].conf == 0.9f && in[1].x == 0.50f && in[2].x == 0.51f &&   /* 엔진: decode 순서 */
+           n == 2 && out[1].x == 0.50f;                                  /* NMS는 A를 남김 */
 }
 
 static void sort_detections_by_conf(detection_t* detections, int32_t num) {
@@ -28,6 +89,7 @@ static void sort_detections_by_conf(detection_t* detections, int32_t num) {
 }
 
 int main(void) {
+    test_seed(99u);
     // 테스트: NMS 전 detection 배열 준비
     // 실제로는 decode 블록의 출력을 사용하지만, 여기서는 테스트 벡터 사용
     
@@ -181,6 +243,22 @@ int main(void) {
         printf("⚠ WARNING: IoU seems low for overlapping boxes: %.4f\n", iou);
     }
     
+    // 6. 후처리 엔진 (O(n log n) 정렬 + 클래스 bucket 비트마스크 NMS, scratch 제공)이 nms()와 같은지
+    if (check_engine()) {
+        printf("✓ nms_sort_by_conf + nms_sorted == stable sort + nms() (random crowded scenes)\n");
+    } else {
+        printf("✗ ERROR: nms_sorted output differs from nms()\n");
+        verification_ok = 0;
+    }
+
+    // 7. conf 동점은 decode 순서 (이전 세션 교환 정렬과 다름, 의도된 변경)
+    if (check_tie_order()) {
+        printf("✓ equal-conf detections keep decode order (old exchange sort swapped them)\n");
+    } else {
+        printf("✗ ERROR: equal-conf order differs from decode order\n");
+        verification_ok = 0;
+    }
+
     // 정리
     if (output_detections) {
         free(output_detections);
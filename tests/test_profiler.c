@@ -0,0 +1,140 @@
+/* 계층 프로파일러 테스트: 레이어 → 블록 → 연산 중첩 깊이, self = dur - 자식 합, 레이어 전환 시 열린 스코프 닫힘,
+ * thread_pool 작업 구간(tid), 비활성 시 기록 없음, 용량 초과 dropped, Chrome trace JSON / CSV 파일 생성 확인.
+ * 가중치 파일 불필요. */
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "../csrc/utils/profiler.h"
+#include "../csrc/utils/timing.h"
+#include "../csrc/utils/thread_pool.h"
+
+static volatile float s_sink;
+
+static void spin(int32_t k) {
+    float a = 0.0f;
+    for (int32_t i = 0; i < k * 20000; i++) a += (float)i * 1e-9f;
+    s_sink = a;
+}
+
+static void work(void* ctx, int32_t i0, int32_t i1, int32_t tid) {
+    (void)ctx; (void)tid;
+    for (int32_t i = i0; i < i1; i++) spin(1);
+}
+
+static const prof_event_t* find(const char* name, int32_t depth) {
+    const prof_event_t* e = prof_events();
+    for (int32_t i = 0; i < prof_count(); i++)
+        if (e[i].depth == depth && strcmp(e[i].name, name) == 0) return &e[i];
+    return NULL;
+}
+
+/* 파일 크기 > 0, 괄호 짝, 이벤트 수만큼 "ph":"X" */
+static int check_json(const char* path, int32_t n_events) {
+    FILE* f = fopen(path, "r");
+    if (!f) return 0;
+    int depth = 0, bad = 0, in_str = 0, c, prev = 0;
+    int32_t n_x = 0;
+    char win[9] = { 0 };
+    while ((c = fgetc(f)) != EOF) {
+        if (c == '"' && prev != '\\') in_str = !in_str;
+        if (!in_str) {
+            if (c == '{' || c == '[') depth++;
+            if (c == '}' || c == ']') bad |= --depth < 0;
+        }
+        memmove(win, win + 1, 7);
+        win[7] = (char)c;
+        if (memcmp(win, "\"ph\":\"X\"", 8) == 0) n_x++;
+        prev = c;
+    }
+    fclose(f);
+    return !bad && depth == 0 && n_x == n_events;
+}
+
+int main(void) {
+    printf("=== Profiler Test ===\n\n");
+    int ok = 1;
+
+    /* 비활성: 기록 없음 */
+    prof_enable(0);
+    yolo_timing_reset();
+    yolo_timing_set_layer(0);
+    yolo_timing_begin("conv2d");
+    yolo_timing_end();
+    ok &= prof_count() == 0;
+
+    /* L0 { Conv { conv2d } }, L1 { C3 { cv1+cv2, cv3 } }, L24 { Detect } (마지막 두 스코프는 레이어 전환이 닫음) */
+    prof_enable(1);
+    thread_pool_init(2);
+    yolo_timing_reset();
+    yolo_timing_set_layer(0);
+    prof_begin("Conv");
+    yolo_timing_begin("conv2d");
+    thread_pool_run(8, work, NULL);
+    yolo_timing_end();
+    prof_end();
+    yolo_timing_set_layer(1);
+    prof_begin("C3");
+    yolo_timing_begin("cv1+cv2");
+    spin(2);
+    yolo_timing_end();
+    yolo_timing_begin("cv3");
+    spin(2);
+    yolo_timing_end();
+    prof_end();
+    yolo_timing_set_layer(24);
+    prof_begin("Detect");
+    spin(1);
+    prof_layer(-1);
+
+    const prof_event_t* l0 = find("L0", 0);
+    const prof_event_t* conv = find("Conv", 1);
+    const prof_event_t* op = find("conv2d", 2);
+    const prof_event_t* l1 = find("L1", 0);
+    const prof_event_t* c3 = find("C3", 1);
+    const prof_event_t* a = find("cv1+cv2", 2);
+    const prof_event_t* b = find("cv3", 2);
+    const prof_event_t* det = find("Detect", 1);
+    const int nest = l0 && conv && op && l1 && c3 && a && b && det && find("det", 0);
+    printf("  nesting (layer/block/op): %s\n", nest ? "OK" : "NG");
+    ok &= nest;
+    if (nest) {
+        /* 자식은 부모 구간 안, self = dur - 직속 자식 합 */
+        int in = conv->t0 >= l0->t0 && conv->t0 + conv->dur <= l0->t0 + l0->dur &&
+                 op->t0 >= conv->t0 && op->t0 + op->dur <= conv->t0 + conv->dur &&
+                 a->t0 + a->dur <= b->t0 && b->t0 + b->dur <= c3->t0 + c3->dur;
+        in &= conv->self == conv->dur - op->dur && c3->self == c3->dur - a->dur - b->dur &&
+              op->self == op->dur && l1->self == l1->dur - c3->dur;
+        printf("  containment / self time: %s\n", in ? "OK" : "NG");
+        ok &= in;
+    }
+
+    /* 작업 구간: 실행한 스레드마다 1개, tid < 풀 크기 */
+    int32_t n_task = 0, task_ok = 1;
+    for (int32_t i = 0; i < prof_count(); i++) {
+        const prof_event_t* e = &prof_events()[i];
+        if (e->depth != -1) continue;
+        n_task++;
+        task_ok &= strcmp(e->name, "task") == 0 && e->tid >= 0 && e->tid < thread_pool_size();
+    }
+    task_ok &= n_task >= 1 && n_task <= thread_pool_size();
+    printf("  pool tasks: %d (threads %d) %s\n", (int)n_task, (int)thread_pool_size(), task_ok ? "OK" : "NG");
+    ok &= task_ok;
+
+    /* 파일 출력 */
+    const int32_t n = prof_count();
+    const int files = prof_write_chrome_trace("/tmp/test_profiler.json") == 0 &&
+                      prof_write_csv("/tmp/test_profiler.csv") == 0 &&
+                      check_json("/tmp/test_profiler.json", n);
+    printf("  chrome trace / csv (%d events): %s\n", (int)n, files ? "OK" : "NG");
+    ok &= files;
+
+    /* 용량 초과: 기록은 PROF_MAX_EVENTS에서 멈추고 나머지는 dropped */
+    yolo_timing_reset();
+    for (int32_t i = 0; i < PROF_MAX_EVENTS + 10; i++) prof_task(0, 0, 0);
+    ok &= prof_count() == PROF_MAX_EVENTS && prof_dropped() == 10;
+    thread_pool_shutdown();
+
+    printf("\nResult: %s\n", ok ? "OK" : "NG");
+    return ok ? 0 : 1;
+}
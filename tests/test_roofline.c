@@ -0,0 +1,50 @@
+/* Roofline 계정 테스트: conv MAC·가중치·활성값 바이트 공식, 현재 레이어(yolo_timing_set_layer)로 누적,
+ * reset, 달성 MFLOP/s·MB/s 환산. 가중치 파일 불필요. */
+#include <stdio.h>
+#include <stdint.h>
+
+#include "../csrc/utils/roofline.h"
+#include "../csrc/utils/timing.h"
+
+int main(void) {
+    printf("=== Roofline Accounting Test ===\n\n");
+    int ok = 1;
+
+    roofline_reset();
+    /* L0: 6x6 s2 stem, 3 → 16, 640 → 320, INT8 */
+    yolo_timing_set_layer(0);
+    roofline_conv(1, 3, 640, 640, 16, 6, 6, 320, 320, 1);
+    const roofline_work_t* l0 = roofline_layer(0);
+    const int stem = l0->macs == 16ULL * 320 * 320 * 3 * 6 * 6 &&
+                     l0->weight_bytes == 16ULL * 3 * 6 * 6 + 16 * 4 &&
+                     l0->act_read == 3ULL * 640 * 640 * 4 && l0->act_write == 16ULL * 320 * 320 * 4;
+    printf("  stem conv counts: %s\n", stem ? "OK" : "NG");
+    ok &= stem;
+
+    /* 레이어 전환 후 누적 위치, FP32 가중치 4B, batch 2 */
+    yolo_timing_set_layer(24);
+    roofline_conv(2, 64, 80, 80, 255, 1, 1, 80, 80, 0);
+    roofline_add(10, 20, 30, 40);
+    const roofline_work_t* det = roofline_layer(24);
+    const int attr = det->macs == 2ULL * 255 * 80 * 80 * 64 + 10 &&
+                     det->weight_bytes == 255ULL * 64 * 4 + 255 * 4 + 20 &&
+                     det->act_read == 2ULL * 64 * 80 * 80 * 4 + 30 &&
+                     det->act_write == 2ULL * 255 * 80 * 80 * 4 + 40 &&
+                     roofline_layer(0)->macs == l0->macs && roofline_layer(1)->macs == 0;
+    printf("  per-layer attribution: %s\n", attr ? "OK" : "NG");
+    ok &= attr;
+
+    /* 환산: 호스트 1 tick = 1 µs → 2·MAC / µs = MFLOP/s */
+    const roofline_work_t w = { 500000, 100000, 200000, 100000 };
+    const int rate = roofline_mflops(&w, 1000) == 1000 && roofline_mbps(&w, 1000) == 400 &&
+                     roofline_mflops(&w, 0) == 0 && roofline_mbps(NULL, 1000) == 0;
+    printf("  MFLOP/s, MB/s: %s\n", rate ? "OK" : "NG");
+    ok &= rate;
+
+    ok &= roofline_layer(-1) == NULL && roofline_layer(ROOFLINE_LAYERS) == NULL;
+    roofline_reset();
+    ok &= roofline_layer(0)->macs == 0 && roofline_layer(24)->act_write == 0;
+
+    printf("\nResult: %s\n", ok ? "OK" : "NG");
+    return ok ? 0 : 1;
+}
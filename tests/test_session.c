@@ -0,0 +1,71 @@
+/* 세션 API 테스트: 같은 이미지를 연속 추론해 결과가 같고 피처맵 풀이 새지 않는지,
+ * destroy 후 재생성이 되는지, batch 2 결과가 이미지별 단일 추론과 같은지 확인. 가중치·전처리 이미지 파일 필요 (프로젝트 루트에서 실행). */
+#include <stdio.h>
+#include <string.h>
+
+#include "../csrc/yolo_session.h"
+#include "../csrc/utils/feature_pool.h"
+
+#ifdef USE_WEIGHTS_W8
+#define WEIGHTS_PATH "assets/weights_w8.bin"
+#else
+#define WEIGHTS_PATH "assets/weights.bin"
+#endif
+
+static detection_t dets_a[YOLO_MAX_DETECTIONS];
+static detection_t dets_b[YOLO_MAX_DETECTIONS];
+static detection_t dets_batch[2 * YOLO_MAX_DETECTIONS];
+
+int main(void) {
+    printf("=== Session API Test ===\n\n");
+
+    preprocessed_image_t img;
+    if (image_load_from_bin("data/input/preprocessed_image.bin", &img) != 0) {
+        fprintf(stderr, "Failed to load image\n");
+        return 1;
+    }
+
+    int ok = 1;
+    for (int round = 0; round < 2 && ok; round++) {
+        yolo_session_t* s = yolo_session_create(WEIGHTS_PATH, 0, 2);
+        if (!s) {
+            fprintf(stderr, "yolo_session_create failed (round %d)\n", round);
+            image_free(&img);
+            return 1;
+        }
+        if (yolo_session_create(WEIGHTS_PATH, 0, 1) != NULL) {
+            printf("  second concurrent session must fail\n");
+            ok = 0;
+        }
+
+        const size_t free0 = feature_pool_get_largest_free();
+        const int32_t na = yolo_session_infer(s, &img, dets_a, YOLO_MAX_DETECTIONS);
+        const size_t free1 = feature_pool_get_largest_free();
+        const int32_t nb = yolo_session_infer(s, &img, dets_b, YOLO_MAX_DETECTIONS);
+
+        printf("\n  round %d: detections %d / %d, pool largest_free %u -> %u\n",
+               round, (int)na, (int)nb, (unsigned)free0, (unsigned)free1);
+        ok &= na >= 0 && na == nb;
+        ok &= na <= 0 || memcmp(dets_a, dets_b, (size_t)na * sizeof(detection_t)) == 0;
+        ok &= free0 == free1;
+
+        /* batch 2: 각 이미지 결과가 단일 추론과 같아야 함, max_batch 초과는 실패 */
+        preprocessed_image_t imgs[3] = { img, img, img };
+        int32_t counts[3] = { -1, -1, -1 };
+        ok &= yolo_session_infer_batch(s, imgs, 2, dets_batch, YOLO_MAX_DETECTIONS, counts) == 0;
+        const size_t free2 = feature_pool_get_largest_free();
+        for (int b = 0; b < 2; b++) {
+            ok &= counts[b] == na;
+            ok &= na <= 0 || memcmp(dets_batch + b * YOLO_MAX_DETECTIONS, dets_a, (size_t)na * sizeof(detection_t)) == 0;
+        }
+        ok &= yolo_session_infer_batch(s, imgs, 3, dets_batch, YOLO_MAX_DETECTIONS, counts) == -1;
+        printf("  round %d: batch2 detections %d / %d, pool largest_free %u\n",
+               round, (int)counts[0], (int)counts[1], (unsigned)free2);
+        ok &= free2 == free0;
+        yolo_session_destroy(s);
+    }
+    image_free(&img);
+
+    printf("\nResult: %s\n", ok ? "OK" : "NG");
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,86 @@
+/* SiLU 테스트: FAST 근사의 EXACT 대비 오차 예산, 벡터 span = 스칼라 bit 단위, 비유한 입력 포화,
+ * 모드 전환 시 silu_nchw_f32 경로 확인. 가중치 파일 불필요. */
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <math.h>
+
+#include "../csrc/operations/silu.h"
+
+#define COUNT   (1 << 18)
+#define REL_TOL 4e-7      /* silu.h 주석의 [-20, 20] 상대 오차 예산 */
+
+static float x_buf[COUNT + 7];   /* 벡터 폭의 배수가 아닌 길이로 스칼라 나머지도 통과 */
+static float y_vec[COUNT + 7];
+static float y_ref[COUNT + 7];
+
+int main(void) {
+    printf("=== SiLU Test ===\n\n");
+    const int len = COUNT + 7;
+    int ok = 1;
+
+    /* [-20, 20] 균등 격자 + 0 근처 */
+    for (int i = 0; i < len; i++) x_buf[i] = -20.0f + 40.0f * (float)i / (float)(len - 1);
+    x_buf[len / 2] = 0.0f;
+    x_buf[len / 2 + 1] = -0.0f;
+    x_buf[len / 2 + 2] = 1e-30f;
+
+    double max_rel = 0.0;
+    for (int i = 0; i < len; i++) {
+        const float e = silu_f32(x_buf[i]), f = silu_fast_f32(x_buf[i]);
+        if (e == 0.0f) {
+            ok &= f == 0.0f;
+            continue;
+        }
+        const double rel = fabs((double)f - (double)e) / fabs((double)e);
+        if (rel > max_rel) max_rel = rel;
+    }
+    ok &= max_rel < REL_TOL;
+    printf("  fast vs exact [-20, 20]: max rel %.3g (tol %.1g)\n", max_rel, REL_TOL);
+
+    /* 큰 |x|: 양수는 x 그대로, 음수는 0 근처 */
+    static const float big[] = { 30.0f, 88.0f, 1e4f, -30.0f, -87.0f, -88.0f, -1e3f };
+    for (unsigned i = 0; i < sizeof(big) / sizeof(big[0]); i++) {
+        const float f = silu_fast_f32(big[i]);
+        ok &= big[i] > 0.0f ? f == big[i] : (f <= 0.0f && f > -1e-9f);
+    }
+
+    /* 벡터 span = 스칼라 (bit 단위), 제자리 포함 */
+    silu_fast_span_f32(x_buf, y_vec, len);
+    int same = 1;
+    for (int i = 0; i < len; i++) {
+        const float f = silu_fast_f32(x_buf[i]);
+        same &= memcmp(&f, &y_vec[i], sizeof(f)) == 0;
+    }
+    memcpy(y_ref, x_buf, sizeof(y_ref));
+    silu_fast_span_f32(y_ref, y_ref, len);
+    same &= memcmp(y_ref, y_vec, sizeof(y_ref)) == 0;
+    printf("  vector span vs scalar: %s\n", same ? "bit-identical" : "MISMATCH");
+    ok &= same;
+
+    /* 비유한 입력: 벡터 레인 중간에 섞어도 silu_f32와 같은 포화값 */
+    float nf[9] = { 1.0f, INFINITY, -2.0f, -INFINITY, NAN, 3.0f, -NAN, 0.5f, INFINITY };
+    float nf_y[9];
+    silu_fast_span_f32(nf, nf_y, 9);
+    for (int i = 0; i < 9; i++) {
+        const float e = silu_f32(nf[i]);
+        ok &= isfinite(nf_y[i]) && (isfinite(nf[i]) ? nf_y[i] == silu_fast_f32(nf[i]) : nf_y[i] == e);
+    }
+    printf("  non-finite saturation: %s\n", ok ? "ok" : "FAIL");
+
+    /* 모드 전환: silu_nchw_f32가 선택된 구현과 bit 단위로 같은지 */
+    const silu_mode_t saved = silu_get_mode();
+    silu_set_mode(SILU_FAST);
+    silu_nchw_f32(x_buf, 1, 1, 1, len, y_ref);
+    ok &= silu_get_mode() == SILU_FAST && memcmp(y_ref, y_vec, sizeof(y_ref)) == 0;
+    silu_set_mode(SILU_EXACT);
+    silu_nchw_f32(x_buf, 1, 1, 1, len, y_ref);
+    for (int i = 0; i < len; i++) {
+        const float e = silu_f32(x_buf[i]);
+        ok &= memcmp(&e, &y_ref[i], sizeof(e)) == 0;
+    }
+    silu_set_mode(saved);
+
+    printf("\nResult: %s\n", ok ? "OK" : "NG");
+    return ok ? 0 : 1;
+}
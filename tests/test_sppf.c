@@ -5,6 +5,7 @@
 #include "test_vectors_sppf.h"
 #include "../csrc/utils/weights_loader.h"
 #include "../csrc/blocks/sppf.h"
+#include "../csrc/utils/feature_pool.h"
 
 static float max_abs_diff(const float* a, const float* b, int n) {
     float m = 0.0f;
@@ -49,13 +50,15 @@ int main(void) {
 
     static float y_out[1 * 256 * 20 * 20];
 
-    // SPPF 블록 실행 (Fused)
+    feature_pool_init();
+
+    // SPPF 블록 실행 (Fused). FP32 가중치이므로 scale=0, is_int8=0, scratch NULL → feature_pool
     sppf_nchw_f32(
         tv_sppf_x, n, c_in, h, w,
-        cv1_w, 128, cv1_b,  // cv1: 256->128
-        cv2_w, 256, cv2_b,  // cv2: 512->256
-        5,                   // pool_k=5
-        y_out);
+        cv1_w, 0.f, 0, 128, cv1_b,  // cv1: 256->128
+        cv2_w, 0.f, 0, 256, cv2_b,  // cv2: 512->256
+        5,                          // pool_k=5
+        y_out, NULL);
 
     const int elems = n * c_out * h_out * w_out;
     float diff = max_abs_diff(y_out, tv_sppf_y, elems);
@@ -65,6 +68,7 @@ int main(void) {
     printf("  Output: %d x %d x %d x %d\n", n, c_out, h_out, w_out);
     printf("  Max diff: %g\n\n", diff);
     
+    feature_pool_reset();
     weights_free(&weights);
 
     if (diff < 1e-4f) {
@@ -0,0 +1,57 @@
+/* 테스트 공용: 재현 가능한 난수 (LCG), 오차 측정, 합성 텐서용 로더 구성. 가중치 파일 불필요.
+ * 헤더 전용 (static inline), 테스트 파일에서만 include. 시퀀스는 test_seed()로 파일마다 고정 */
+#ifndef TEST_UTIL_H
+#define TEST_UTIL_H
+
+#include <stdint.h>
+#include <string.h>
+#include <math.h>
+
+#include "../csrc/utils/weights_loader.h"
+
+static uint32_t s_rng = 1u;
+
+static inline void test_seed(uint32_t seed) { s_rng = seed; }
+
+static inline uint32_t test_rng_next(void) {
+    s_rng = s_rng * 1664525u + 1013904223u;
+    return s_rng;
+}
+
+/* [-1, 1) */
+static inline float frand(void) {
+    return (float)((test_rng_next() >> 8) & 0xFFFF) / 32768.0f - 1.0f;
+}
+
+/* [0, 1) */
+static inline float frand01(void) {
+    return (float)((test_rng_next() >> 8) & 0xFFFF) / 65536.0f;
+}
+
+static inline float max_abs_diff(const float* a, const float* b, int n) {
+    float m = 0.0f;
+    for (int i = 0; i < n; i++) {
+        const float d = fabsf(a[i] - b[i]);
+        if (d > m) m = d;
+    }
+    return m;
+}
+
+/* |a - b| / (1 + |a|): a가 reference */
+static inline float max_rel_diff(const float* a, const float* b, int count) {
+    float m = 0.0f;
+    for (int i = 0; i < count; i++) {
+        const float d = fabsf(a[i] - b[i]) / (1.0f + fabsf(a[i]));
+        if (d > m) m = d;
+    }
+    return m;
+}
+
+/* 합성 텐서 배열을 가리키는 로더 (해시 인덱스 없음 → 선형 탐색, 해제 불필요) */
+static inline void test_loader_init(weights_loader_t* loader, tensor_info_t* tensors, int32_t num_tensors) {
+    memset(loader, 0, sizeof(*loader));
+    loader->tensors = tensors;
+    loader->num_tensors = num_tensors;
+}
+
+#endif // TEST_UTIL_H
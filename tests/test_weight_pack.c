@@ -0,0 +1,130 @@
+/* weight_pack 테스트: 로드 시 재배치(패널 / DIRECT 블록 INT8·FP32)로 돌린 conv가
+ * 원본 OIHW reference(direct 커널)와 같은지, 배치가 64B 정렬인지,
+ * C3 cv1/cv2 연결 패널 한 패스가 두 번 따로 돌린 결과와 같은지 확인. 가중치 파일 불필요. */
+#include <string.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <math.h>
+
+#include "../csrc/operations/conv2d.h"
+#include "../csrc/operations/weight_pack.h"
+#include "test_util.h"
+
+#define C_IN  24
+#define C_OUT 40   /* CONV2D_OC_BLOCK(32), MR(4)로 나눠떨어지지 않게 */
+#define H     13
+#define W     11
+
+static float x_buf[C_IN * H * W];
+static int8_t w3_buf[C_OUT * C_IN * 9];
+static int8_t w1_buf[C_OUT * C_IN];
+static float bias_buf[C_OUT];
+static float y_ref[C_OUT * H * W];
+static float y_out[C_OUT * H * W];
+static int8_t cv2_buf[C_OUT * C_IN];
+static float bias2_buf[C_OUT];
+static float y_pair[2 * C_OUT * H * W];
+
+static int is_aligned(const void* p) {
+    return p == NULL || ((uintptr_t)p & 63u) == 0;
+}
+
+int main(void) {
+    test_seed(777u);
+    printf("=== Weight Pack Test ===\n\n");
+
+    const float scale = 0.0087f;
+    for (int i = 0; i < C_IN * H * W; i++) x_buf[i] = frand() * 3.0f;
+    for (int i = 0; i < C_OUT * C_IN * 9; i++) w3_buf[i] = (int8_t)(frand() * 127.0f);
+    for (int i = 0; i < C_OUT * C_IN; i++) w1_buf[i] = (int8_t)(frand() * 127.0f);
+    for (int i = 0; i < C_OUT; i++) bias_buf[i] = frand();
+
+    /* 로더 흉내: 3x3 / 1x1 INT8 conv 가중치 2개 */
+    tensor_info_t t[2] = {
+        { "model.0.conv.weight", NULL, w3_buf, scale, WEIGHTS_DTYPE_INT8, 4, { C_OUT, C_IN, 3, 3 }, 0, 0 },
+        { "model.1.conv.weight", NULL, w1_buf, scale, WEIGHTS_DTYPE_INT8, 4, { C_OUT, C_IN, 1, 1 }, 0, 0 },
+    };
+    weights_loader_t loader;
+    test_loader_init(&loader, t, 2);
+
+    static const struct { const char* name; unsigned flags; conv2d_algo_t algo; } cases[] = {
+        { "DIRECT (INT8 blocked)", WEIGHT_PACK_DIRECT,                       CONV2D_ALGO_DIRECT },
+        { "DIRECT (FP32 blocked)", WEIGHT_PACK_DIRECT | WEIGHT_PACK_DEQUANT, CONV2D_ALGO_DIRECT },
+        { "PANEL  (GEMM / 1x1)",   WEIGHT_PACK_PANEL,                        CONV2D_ALGO_GEMM },
+    };
+
+    float worst = 0.0f;
+    int aligned = 1;
+    for (unsigned c = 0; c < sizeof(cases) / sizeof(cases[0]); c++) {
+        for (int k = 0; k < 2; k++) {
+            const int32_t ks = k == 0 ? 3 : 1, pad = k == 0 ? 1 : 0;
+            const int8_t* w = k == 0 ? w3_buf : w1_buf;
+
+            weight_pack_release();
+            conv2d_set_algo(CONV2D_ALGO_DIRECT);
+            conv2d_direct_nchw_f32_w8(x_buf, 1, C_IN, H, W, w, scale, C_OUT, ks, ks, bias_buf,
+                                      1, 1, pad, pad, 1, y_ref, H, W);
+
+            if (weight_pack_prepare(&loader, cases[c].flags) != 0) {
+                printf("  %s: weight_pack_prepare failed\n", cases[c].name);
+                return 1;
+            }
+            const weight_pack_t* pk = weight_pack_find(w);
+            if (!pk) {
+                printf("  %s: pack not found\n", cases[c].name);
+                return 1;
+            }
+            aligned &= is_aligned(pk->panel) && is_aligned(pk->direct_f32) && is_aligned(pk->direct_i8);
+
+            conv2d_set_algo(cases[c].algo);
+            conv2d_nchw_f32_w8(x_buf, 1, C_IN, H, W, w, scale, C_OUT, ks, ks, bias_buf,
+                               1, 1, pad, pad, 1, y_out, H, W);
+            float diff = max_abs_diff(y_out, y_ref, C_OUT * H * W);
+            printf("  %-22s %dx%d  Max diff: %g\n", cases[c].name, ks, ks, diff);
+            if (diff > worst) worst = diff;
+        }
+    }
+    weight_pack_release();
+    printf("  64B aligned: %s\n", aligned ? "yes" : "no");
+
+    /* C3 cv1/cv2 (같은 입력 1x1): [cv1 | cv2] 연결 패널 → 한 패스 = 따로 두 번 (bit 단위) */
+    int pair_ok = 1;
+    for (int i = 0; i < C_OUT * C_IN; i++) cv2_buf[i] = (int8_t)(frand() * 127.0f);
+    for (int i = 0; i < C_OUT; i++) bias2_buf[i] = frand();
+    tensor_info_t c3[2] = {
+        { "model.2.cv1.conv.weight", NULL, w1_buf, scale, WEIGHTS_DTYPE_INT8, 4, { C_OUT, C_IN, 1, 1 }, 0, 0 },
+        { "model.2.cv2.conv.weight", NULL, cv2_buf, scale * 1.5f, WEIGHTS_DTYPE_INT8, 4, { C_OUT, C_IN, 1, 1 }, 0, 0 },
+    };
+    weights_loader_t c3_loader;
+    test_loader_init(&c3_loader, c3, 2);
+    conv2d_set_algo(CONV2D_ALGO_GEMM);
+    if (weight_pack_prepare(&c3_loader, conv2d_weight_pack_flags()) != 0) {
+        printf("  C3 pair: weight_pack_prepare failed\n");
+        return 1;
+    }
+    const weight_pack_t* p1 = weight_pack_find(w1_buf);
+    const weight_pack_t* p2 = weight_pack_find(cv2_buf);
+    pair_ok &= p1 && p2 && p1->pair_src == cv2_buf && p1->pair_c_out == C_OUT &&
+               p2->panel == p1->panel + C_OUT * C_IN;
+    const conv2d_epilogue_t ep = { 1, NULL, 0 };
+    pair_ok &= conv2d_pair_1x1_nchw_f32(x_buf, 1, C_IN, H, W, w1_buf, C_OUT, bias_buf,
+                                        cv2_buf, C_OUT, bias2_buf, &ep, y_pair) == 1;
+    conv2d_fused_nchw_f32(x_buf, 1, C_IN, H, W, w1_buf, scale, 1, C_OUT, 1, 1, bias_buf,
+                          1, 1, 0, 0, &ep, y_out, H, W);
+    pair_ok &= memcmp(y_pair, y_out, sizeof(y_out)) == 0;
+    conv2d_fused_nchw_f32(x_buf, 1, C_IN, H, W, cv2_buf, scale * 1.5f, 1, C_OUT, 1, 1, bias2_buf,
+                          1, 1, 0, 0, &ep, y_out, H, W);
+    pair_ok &= memcmp(y_pair + C_OUT * H * W, y_out, sizeof(y_out)) == 0;
+    /* 짝이 아닌 가중치 조합은 0 (호출 측 fallback) */
+    pair_ok &= conv2d_pair_1x1_nchw_f32(x_buf, 1, C_IN, H, W, cv2_buf, C_OUT, NULL,
+                                        w1_buf, C_OUT, NULL, &ep, y_pair) == 0;
+    weight_pack_release();
+    printf("  C3 cv1|cv2 pair panel: %s\n\n", pair_ok ? "same as two passes" : "MISMATCH");
+
+    if (worst < 1e-4f && aligned && pair_ok) {
+        printf("Result: OK\n");
+        return 0;
+    }
+    printf("Result: NG\n");
+    return 1;
+}
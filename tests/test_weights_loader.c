@@ -0,0 +1,104 @@
+/* weights_loader 테스트: 메모리에 만든 weights.bin 형식 버퍼로
+ * 해시 조회가 선형 탐색과 같은 텐서를 돌려주는지, 같은 버퍼를 임시 파일로 써서
+ * 파일 로드(POSIX mmap 제로카피)가 메모리 로드와 같은 내용인지 확인. */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+#include "../csrc/utils/weights_loader.h"
+
+#define NUM_NAMED 200
+
+static uint8_t buf[256 * 1024] __attribute__((aligned(4)));
+
+static uint8_t* put_u32(uint8_t* p, uint32_t v) {
+    memcpy(p, &v, 4);
+    return p + 4;
+}
+
+/* 텐서 1개: key_len, key, ndim, dims, 4B 정렬, float 데이터 */
+static uint8_t* put_tensor(uint8_t* p, const char* name, float value) {
+    const uint32_t len = (uint32_t)strlen(name);
+    p = put_u32(p, len);
+    memcpy(p, name, len);
+    p += len;
+    p = put_u32(p, 1);
+    p = put_u32(p, 2);
+    while ((uintptr_t)p & 3u) *p++ = 0;
+    memcpy(p, &value, 4);
+    memcpy(p + 4, &value, 4);
+    return p + 8;
+}
+
+static const tensor_info_t* find_linear(const weights_loader_t* wl, const char* name) {
+    for (int i = 0; i < wl->num_tensors; i++)
+        if (strcmp(wl->tensors[i].name, name) == 0) return &wl->tensors[i];
+    return NULL;
+}
+
+int main(void) {
+    printf("=== Weights Loader Test ===\n\n");
+
+    char name[64];
+    uint8_t* p = put_u32(buf, NUM_NAMED + 2);
+    for (int i = 0; i < NUM_NAMED; i++) {
+        /* 실제 가중치처럼 "model.model." 접두 + 비슷한 이름 다수 */
+        snprintf(name, sizeof(name), "model.model.%d.cv%d.conv.%s", i / 4, i % 2 + 1, (i & 2) ? "bias" : "weight");
+        p = put_tensor(p, name, (float)i);
+    }
+    p = put_tensor(p, "model.model.0.cv1.conv.weight", -1.0f);  /* 중복: 먼저 나온 것이 반환돼야 함 */
+    p = put_tensor(p, "model.model.model.24.m.0.weight", 7.0f);  /* "model." 접두 재시도 대상 */
+
+    weights_loader_t wl;
+    if (weights_init_from_memory((uintptr_t)buf, (size_t)(p - buf), &wl) != 0) {
+        printf("weights_init_from_memory failed\n");
+        return 1;
+    }
+
+    int ok = wl.hash_slots != NULL;
+    for (int i = 0; i < wl.num_tensors; i++) {
+        const tensor_info_t* t = weights_find_tensor(&wl, wl.tensors[i].name);
+        ok &= t == find_linear(&wl, wl.tensors[i].name);
+    }
+    ok &= weights_find_tensor(&wl, "model.model.0.cv1.conv.weight")->data[0] == 0.0f;
+    ok &= weights_find_tensor(&wl, "model.24.m.0.weight") == &wl.tensors[NUM_NAMED + 1];
+    ok &= weights_find_tensor(&wl, "model.999.cv1.conv.weight") == NULL;
+    ok &= weights_find_tensor(&wl, "") == NULL;
+    ok &= weights_find_tensor(&wl, "model.model.0.cv1.conv") == NULL;
+
+    printf("  tensors %d, slots %u\n", (int)wl.num_tensors, (unsigned)(wl.hash_mask + 1u));
+
+    /* 파일 로드: 이름·shape·데이터가 메모리 로드와 동일 */
+    const char* tmp_path = "test_weights_loader.tmp";
+    FILE* f = fopen(tmp_path, "wb");
+    if (!f || fwrite(buf, 1, (size_t)(p - buf), f) != (size_t)(p - buf)) {
+        printf("cannot write %s\n", tmp_path);
+        return 1;
+    }
+    fclose(f);
+    weights_loader_t wf;
+    ok &= weights_load_from_file(tmp_path, &wf) == 0;
+    remove(tmp_path);  /* 매핑은 unlink 후에도 유효 */
+    if (ok) {
+        ok &= wf.num_tensors == wl.num_tensors;
+        for (int i = 0; i < wf.num_tensors && ok; i++) {
+            const tensor_info_t* t = weights_find_tensor(&wf, wl.tensors[i].name);
+            ok &= t == &wf.tensors[i] || strcmp(t->name, wl.tensors[i].name) == 0;
+            ok &= t->num_elements == 2 && memcmp(t->data, weights_find_tensor(&wl, t->name)->data, 8) == 0;
+        }
+#if !defined(_WIN32) && (defined(__unix__) || defined(__APPLE__))
+        /* mmap 경로: 텐서가 매핑 안을 직접 가리킴 (복사본 없음) */
+        ok &= wf.map_base != NULL && wf.tensors[0].data_owned == 0 &&
+              (const uint8_t*)wf.tensors[0].data >= (const uint8_t*)wf.map_base &&
+              (const uint8_t*)wf.tensors[0].data < (const uint8_t*)wf.map_base + wf.map_size;
+#endif
+        printf("  file load: %s\n", wf.map_base ? "mmap (zero-copy)" : "fread + copy");
+        weights_free(&wf);
+    }
+    weights_free(&wl);
+    ok &= wl.hash_slots == NULL && wl.tensors == NULL;
+
+    printf("\nResult: %s\n", ok ? "OK" : "NG");
+    return ok ? 0 : 1;
+}
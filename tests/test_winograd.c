@@ -0,0 +1,120 @@
+/* Winograd F(2x2,3x3) 테스트: C3 bottleneck cv2 실제 채널 수(16/32/64/128), 홀수 H/W(마지막 2x2 타일 절반),
+ * batch 2에서 weight_pack(WINOGRAD) 경유 dispatch가 INT8 direct reference와 오차 한계 안인지.
+ * fused epilogue(SiLU + residual)도 같은 한계. C3처럼 concat 채널 구간 (2배 채널 텐서의 앞 절반) batch 한 번
+ * 호출이 밀집 호출과 bit 단위로 같은지, 이름이 bottleneck cv2가 아니면 U를 만들지 않는지도 확인. 가중치 파일 불필요. */
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <math.h>
+
+#include "../csrc/operations/conv2d.h"
+#include "../csrc/operations/conv2d_winograd.h"
+#include "../csrc/operations/weight_pack.h"
+#include "test_util.h"
+
+/* 상대 오차 |wino - direct| / (1 + |direct|) 한계 (FP32 변환 반올림, K = 9 * c_in 누적 순서 차이).
+ * 측정 최대 ~2.6e-5 (c=128), test_c3의 WINOGRAD_TOL과 같은 1e-4 */
+#define WINOGRAD_REL_TOL 1e-4f
+
+#define N      2
+#define C_MAX  128
+#define HW_MAX (23 * 21)
+
+static float x_buf[N * C_MAX * HW_MAX];
+static float res_buf[N * C_MAX * HW_MAX];
+static int8_t w_buf[C_MAX * C_MAX * 9];
+static float bias_buf[C_MAX];
+static float y_ref[N * C_MAX * HW_MAX];
+static float y_out[N * C_MAX * HW_MAX];
+static float x_cat[N * 2 * C_MAX * HW_MAX];   /* [x | 채움] 이미지마다 2 * ch 채널 */
+static float y_cat[N * 2 * C_MAX * HW_MAX];
+
+int main(void) {
+    test_seed(3131u);
+    printf("=== Winograd F(2x2,3x3) Test ===\n\n");
+    int ok = 1;
+
+    /* model.2/4/6/8 bottleneck cv2: c_in = c_out, 공간은 줄이되 홀수 유지 */
+    static const struct { const char* name; int32_t c, h, w; float scale; } cases[] = {
+        { "model.2.m.0.cv2.conv.weight",  16, 23, 21, 0.0210f },
+        { "model.4.m.1.cv2.conv.weight",  32, 17, 15, 0.0093f },
+        { "model.6.m.2.cv2.conv.weight",  64, 13, 11, 0.0061f },
+        { "model.8.m.0.cv2.conv.weight", 128,  9,  7, 0.0038f },
+    };
+    for (unsigned c = 0; c < sizeof(cases) / sizeof(cases[0]); c++) {
+        const int32_t ch = cases[c].c, h = cases[c].h, w = cases[c].w;
+        const float scale = cases[c].scale;
+        const int count = N * ch * h * w;
+        for (int i = 0; i < count; i++) x_buf[i] = frand() * 4.0f;
+        for (int i = 0; i < count; i++) res_buf[i] = frand() * 2.0f;
+        for (int i = 0; i < ch * ch * 9; i++) w_buf[i] = (int8_t)(frand() * 127.0f);
+        for (int i = 0; i < ch; i++) bias_buf[i] = frand();
+
+        tensor_info_t t[1] = {
+            { (char*)cases[c].name, NULL, w_buf, scale, WEIGHTS_DTYPE_INT8, 4, { ch, ch, 3, 3 }, 0, 0 },
+        };
+        weights_loader_t loader;
+        test_loader_init(&loader, t, 1);
+
+        weight_pack_release();
+        conv2d_set_algo(CONV2D_ALGO_WINOGRAD);
+        if (weight_pack_prepare(&loader, conv2d_weight_pack_flags()) != 0) {
+            printf("  %s: weight_pack_prepare failed\n", cases[c].name);
+            return 1;
+        }
+        const weight_pack_t* pk = weight_pack_find(w_buf);
+        const int has_u = pk && pk->wino;
+
+        /* conv만 */
+        conv2d_direct_nchw_f32_w8(x_buf, N, ch, h, w, w_buf, scale, ch, 3, 3, bias_buf,
+                                  1, 1, 1, 1, 1, y_ref, h, w);
+        conv2d_nchw_f32_w8(x_buf, N, ch, h, w, w_buf, scale, ch, 3, 3, bias_buf,
+                           1, 1, 1, 1, 1, y_out, h, w);
+        const float d_conv = max_rel_diff(y_ref, y_out, count);
+
+        /* bottleneck 그대로: SiLU + shortcut. reference는 같은 pack에서 DIRECT (U 무시, OIHW direct) */
+        const conv2d_epilogue_t ep = { 1, res_buf, 0 };
+        conv2d_set_algo(CONV2D_ALGO_DIRECT);
+        conv2d_fused_nchw_f32(x_buf, N, ch, h, w, w_buf, scale, 1, ch, 3, 3, bias_buf,
+                              1, 1, 1, 1, &ep, y_ref, h, w);
+        conv2d_set_algo(CONV2D_ALGO_WINOGRAD);
+        conv2d_fused_nchw_f32(x_buf, N, ch, h, w, w_buf, scale, 1, ch, 3, 3, bias_buf,
+                              1, 1, 1, 1, &ep, y_out, h, w);
+        const float d_fused = max_rel_diff(y_ref, y_out, count);
+
+        /* 채널 구간 batch: x / residual / y 모두 2 * ch 채널 텐서의 앞 ch 채널 */
+        const size_t img = (size_t)ch * h * w;
+        for (int b = 0; b < N; b++) {
+            memcpy(x_cat + 2 * b * img, x_buf + b * img, img * sizeof(float));
+            memcpy(y_cat + 2 * b * img, res_buf + b * img, img * sizeof(float));
+        }
+        const conv2d_epilogue_t ep_cat = { 1, y_cat, 0 };
+        conv2d_fused_slice_nchw_f32(x_cat, 2 * ch, N, ch, h, w, w_buf, scale, 1, ch, 3, 3, bias_buf,
+                                    1, 1, 1, 1, &ep_cat, y_cat, 2 * ch, h, w);
+        int slice_same = 1;
+        for (int b = 0; b < N; b++)
+            slice_same &= memcmp(y_cat + 2 * b * img, y_out + b * img, img * sizeof(float)) == 0;
+
+        const int pass = has_u && d_conv < WINOGRAD_REL_TOL && d_fused < WINOGRAD_REL_TOL && slice_same;
+        printf("  c=%3d %2dx%-2d U:%s  rel diff conv %g, SiLU+residual %g, slice %s  %s\n", (int)ch, (int)h, (int)w,
+               has_u ? "yes" : "no ", d_conv, d_fused, slice_same ? "same" : "differs", pass ? "OK" : "NG");
+        ok &= pass;
+    }
+
+    /* 이름이 bottleneck cv2가 아닌 3x3 (C3 밖 conv): U 없음 → 1x1/GEMM/direct 경로 */
+    tensor_info_t other[1] = {
+        { "model.1.conv.weight", NULL, w_buf, 0.01f, WEIGHTS_DTYPE_INT8, 4, { 16, 16, 3, 3 }, 0, 0 },
+    };
+    weights_loader_t other_loader;
+    test_loader_init(&other_loader, other, 1);
+    weight_pack_release();
+    const int other_ok = weight_pack_prepare(&other_loader, conv2d_weight_pack_flags()) == 0 &&
+                         weight_pack_find(w_buf) && weight_pack_find(w_buf)->wino == NULL;
+    printf("  non-bottleneck 3x3: %s\n", other_ok ? "no U (OK)" : "NG");
+    ok &= other_ok;
+    weight_pack_release();
+    conv2d_set_algo(CONV2D_ALGO_DEFAULT);
+
+    printf("\nResult: %s (tol %g)\n", ok ? "OK" : "NG", WINOGRAD_REL_TOL);
+    return ok ? 0 : 1;
+}
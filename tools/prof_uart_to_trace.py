@@ -0,0 +1,78 @@
+#!/usr/bin/env python3
+"""프로파일 텍스트 덤프(UART 로그 / 호스트 stdout) → Chrome trace JSON + CSV 요약.
+
+prof_dump_text() 형식:
+    PROF <mhz> <count> <dropped>      (mhz: tick → µs 환산, 호스트는 1)
+    P <tid> <depth> <name> <t0> <dur> <self>
+    PROF END
+"""
+from __future__ import annotations
+
+import argparse
+import csv
+import json
+import sys
+from pathlib import Path
+
+
+def parse(lines):
+    mhz, dropped, events, inside = 1.0, 0, [], False
+    for line in lines:
+        tok = line.strip().split()
+        if len(tok) == 4 and tok[0] == "PROF":
+            mhz, dropped, inside, events = float(tok[1]) or 1.0, int(tok[3]), True, []
+        elif tok[:2] == ["PROF", "END"]:
+            inside = False
+        elif inside and len(tok) == 7 and tok[0] == "P":
+            tid, depth, name = int(tok[1]), int(tok[2]), tok[3]
+            t0, dur, self_ = (int(v) / mhz for v in tok[4:7])
+            events.append((tid, depth, name, t0, dur, self_))
+    return events, dropped
+
+
+def write_trace(path: Path, events, dropped: int) -> None:
+    trace = [{"name": "process_name", "ph": "M", "pid": 1, "tid": 0, "args": {"name": "yolov5n"}}]
+    for tid, depth, name, t0, dur, self_ in events:
+        cat = "task" if depth < 0 else "layer" if depth == 0 else "scope"
+        trace.append({"name": name, "cat": cat, "ph": "X", "pid": 1, "tid": tid, "ts": t0, "dur": dur,
+                      "args": {"depth": depth, "self": self_}})
+    doc = {"displayTimeUnit": "ms", "otherData": {"clock": "us", "events": len(events), "dropped": dropped},
+           "traceEvents": trace}
+    path.write_text(json.dumps(doc), encoding="utf-8")
+
+
+def write_csv(path: Path, events) -> None:
+    rows = {}
+    for tid, depth, name, _t0, dur, self_ in events:
+        key = (depth, name, tid if depth < 0 else 0)
+        r = rows.setdefault(key, [0, 0.0, 0.0, 0.0])
+        r[0] += 1
+        r[1] += dur
+        r[2] += self_
+        r[3] = max(r[3], dur)
+    with path.open("w", newline="", encoding="utf-8") as f:
+        w = csv.writer(f)
+        w.writerow(["depth", "name", "tid", "count", "total_us", "self_us", "mean_us", "max_us"])
+        for (depth, name, tid), (n, tot, self_, mx) in rows.items():
+            w.writerow([depth, name, tid, n, f"{tot:.0f}", f"{self_:.0f}", f"{tot / n:.1f}", f"{mx:.0f}"])
+
+
+def main() -> int:
+    ap = argparse.ArgumentParser(description="Convert a PROF text dump (UART log) to Chrome trace JSON + CSV")
+    ap.add_argument("log", type=Path, help="UART log containing PROF ... PROF END")
+    ap.add_argument("--out", type=Path, default=Path("data/output/profile"), help="Output prefix (.json / .csv)")
+    args = ap.parse_args()
+
+    events, dropped = parse(args.log.read_text(encoding="utf-8", errors="replace").splitlines())
+    if not events:
+        print("No PROF block found", file=sys.stderr)
+        return 1
+    args.out.parent.mkdir(parents=True, exist_ok=True)
+    write_trace(args.out.with_suffix(".json"), events, dropped)
+    write_csv(args.out.with_suffix(".csv"), events)
+    print(f"{len(events)} events ({dropped} dropped) -> {args.out}.json / {args.out}.csv")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())